@@ -0,0 +1,114 @@
+#pragma once
+
+#include <qschematic/scene.hpp>
+#include <qschematic/items/node.hpp>
+#include <qschematic/items/wire.hpp>
+
+#include <QApplication>
+#include <QEvent>
+#include <QObject>
+#include <QPaintEvent>
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace Benchmark
+{
+
+    constexpr int NODE_PITCH = 160;
+
+    /**
+     * Run on the offscreen platform unless a platform was explicitly requested.
+     *
+     * @note This must be called before the QApplication is constructed.
+     */
+    inline
+    void
+    useOffscreenPlatform()
+    {
+        if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+            qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    /**
+     * Event filter accumulating the area of all paint events of a widget.
+     */
+    class PaintProbe :
+        public QObject
+    {
+    public:
+        qint64 area = 0;
+        int count = 0;
+
+        void
+        reset()
+        {
+            area = 0;
+            count = 0;
+        }
+
+    protected:
+        bool
+        eventFilter(QObject* watched, QEvent* event) override
+        {
+            if (event->type() == QEvent::Paint) {
+                for (const QRect& rect : static_cast<QPaintEvent*>(event)->region())
+                    area += static_cast<qint64>(rect.width()) * rect.height();
+                count++;
+            }
+
+            return QObject::eventFilter(watched, event);
+        }
+    };
+
+    /**
+     * A synthetic scene.
+     */
+    struct SyntheticScene
+    {
+        std::vector<std::shared_ptr<QSchematic::Items::Node>> nodes;
+        std::vector<std::shared_ptr<QSchematic::Items::Wire>> wires;
+    };
+
+    /**
+     * Populate a scene with a square grid of nodes. Each node is connected to its left neighbor by a wire.
+     *
+     * @param scene The scene.
+     * @param nodeCount The (minimum) number of nodes.
+     * @return The items.
+     */
+    inline
+    SyntheticScene
+    populate(QSchematic::Scene& scene, int nodeCount)
+    {
+        SyntheticScene ret;
+
+        const int columns = std::max(1, static_cast<int>(std::ceil(std::sqrt(nodeCount))));
+        const int rows = (nodeCount + columns - 1) / columns;
+        for (int row = 0; row < rows; row++) {
+            for (int col = 0; col < columns; col++) {
+                auto node = std::make_shared<QSchematic::Items::Node>();
+                node->setSize(80, 60);
+                node->setPos(col * NODE_PITCH, row * NODE_PITCH);
+                scene.addItem(node);
+                ret.nodes.push_back(node);
+
+                if (col == 0)
+                    continue;
+
+                // Connect to the previous node in this row
+                const qreal y = row * NODE_PITCH + 40;
+                auto wire = std::make_shared<QSchematic::Items::Wire>();
+                wire->append_point(QPointF((col - 1) * NODE_PITCH + 80, y));
+                wire->append_point(QPointF(col * NODE_PITCH - 40, y));
+                wire->append_point(QPointF(col * NODE_PITCH, y));
+                scene.addWire(wire);
+                ret.wires.push_back(wire);
+            }
+        }
+
+        return ret;
+    }
+
+}
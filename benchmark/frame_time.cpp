@@ -0,0 +1,250 @@
+/**
+ * Measures the frame times of a View displaying a synthetic scene.
+ *
+ * Usage: qschematic-benchmark-frame-time [--nodes N] [--frames N] [--output FILE] [--viewport-update MODE] [--batched-wires]
+ *
+ * The following scenarios are measured:
+ *   - Full repaints at several zoom levels
+ *   - Panning
+ *   - Hovering over items (highlighting)
+ *   - Dragging a selected item
+ *
+ * The results are written as JSON (to stdout unless an output file is specified). The benchmark runs on the offscreen
+ * platform unless QT_QPA_PLATFORM is set.
+ */
+
+#include "common.hpp"
+
+#include <qschematic/scene.hpp>
+#include <qschematic/settings.hpp>
+#include <qschematic/view.hpp>
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMouseEvent>
+
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+using namespace QSchematic;
+
+static
+QJsonObject
+statistics(const QString& name, std::vector<double> frameTimes)
+{
+    QJsonObject object;
+    object.insert(QStringLiteral("name"), name);
+    object.insert(QStringLiteral("frames"), static_cast<qint64>(frameTimes.size()));
+    if (frameTimes.empty())
+        return object;
+
+    std::ranges::sort(frameTimes);
+    const auto percentile = [&frameTimes](double p) {
+        const auto index = static_cast<std::size_t>(p * (frameTimes.size() - 1));
+        return frameTimes[index];
+    };
+
+    object.insert(QStringLiteral("mean_us"), std::accumulate(frameTimes.cbegin(), frameTimes.cend(), 0.0) / frameTimes.size());
+    object.insert(QStringLiteral("median_us"), percentile(0.5));
+    object.insert(QStringLiteral("p95_us"), percentile(0.95));
+    object.insert(QStringLiteral("min_us"), frameTimes.front());
+    object.insert(QStringLiteral("max_us"), frameTimes.back());
+
+    return object;
+}
+
+/**
+ * Measure the time it takes to apply an action and process all resulting events (including painting).
+ */
+static
+std::vector<double>
+measure(int frames, const std::function<void(int)>& action)
+{
+    QApplication::processEvents();
+
+    std::vector<double> ret;
+    ret.reserve(frames);
+
+    QElapsedTimer timer;
+    for (int i = 0; i < frames; i++) {
+        timer.start();
+        action(i);
+        QApplication::processEvents();
+        ret.push_back(timer.nsecsElapsed() / 1000.0);
+    }
+
+    return ret;
+}
+
+static
+void
+sendMouseEvent(View& view, QEvent::Type type, const QPoint& pos, Qt::MouseButton button, Qt::MouseButtons buttons)
+{
+    QWidget* viewport = view.viewport();
+    QMouseEvent event(type, pos, viewport->mapToGlobal(pos), button, buttons, Qt::NoModifier);
+    QApplication::sendEvent(viewport, &event);
+}
+
+static
+bool
+parseViewportUpdate(const QString& string, Settings::ViewportUpdate& mode)
+{
+    if (string == QStringLiteral("full"))
+        mode = Settings::ViewportUpdate::Full;
+    else if (string == QStringLiteral("minimal"))
+        mode = Settings::ViewportUpdate::Minimal;
+    else if (string == QStringLiteral("smart"))
+        mode = Settings::ViewportUpdate::Smart;
+    else if (string == QStringLiteral("bounding-rect"))
+        mode = Settings::ViewportUpdate::BoundingRect;
+    else
+        return false;
+
+    return true;
+}
+
+int
+main(int argc, char* argv[])
+{
+    Benchmark::useOffscreenPlatform();
+
+    QApplication app(argc, argv);
+
+    // Command line
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    const QCommandLineOption nodesOption(QStringLiteral("nodes"), QStringLiteral("Number of nodes."), QStringLiteral("N"), QStringLiteral("1000"));
+    const QCommandLineOption framesOption(QStringLiteral("frames"), QStringLiteral("Number of frames per scenario."), QStringLiteral("N"), QStringLiteral("100"));
+    const QCommandLineOption outputOption(QStringLiteral("output"), QStringLiteral("JSON output file."), QStringLiteral("FILE"));
+    const QCommandLineOption viewportUpdateOption(QStringLiteral("viewport-update"), QStringLiteral("full, minimal, smart or bounding-rect."), QStringLiteral("MODE"), QStringLiteral("full"));
+    const QCommandLineOption batchedWiresOption(QStringLiteral("batched-wires"), QStringLiteral("Enable batched wire rendering."));
+    parser.addOptions({ nodesOption, framesOption, outputOption, viewportUpdateOption, batchedWiresOption });
+    parser.process(app);
+
+    const int nodeCount = std::max(1, parser.value(nodesOption).toInt());
+    const int frames = std::max(1, parser.value(framesOption).toInt());
+
+    // Settings
+    Settings settings;
+    settings.batchedWireRendering = parser.isSet(batchedWiresOption);
+    if (!parseViewportUpdate(parser.value(viewportUpdateOption), settings.viewportUpdate)) {
+        std::fprintf(stderr, "invalid viewport update mode\n");
+        return 1;
+    }
+
+    // Scene
+    Scene scene;
+    scene.setSettings(settings);
+    const auto [nodes, wires] = Benchmark::populate(scene, nodeCount);
+
+    // View
+    View view;
+    view.setSettings(settings);
+    view.setScene(&scene);
+    view.resize(1280, 800);
+    view.show();
+
+    const auto& centerNode = nodes[nodes.size() / 2];
+    const auto recenter = [&] {
+        view.setZoomValue(1.0);
+        view.centerOn(centerNode.get());
+        QApplication::processEvents();
+    };
+
+    QJsonArray scenarios;
+
+    // Full repaints at several zoom levels
+    for (const qreal zoom : { 0.25, 0.5, 1.0, 2.0, 4.0 }) {
+        recenter();
+        view.setZoomValue(zoom);
+        view.centerOn(centerNode.get());
+
+        const auto frameTimes = measure(frames, [&](int) {
+            view.viewport()->update();
+        });
+        scenarios.append(statistics(QStringLiteral("zoom-%1").arg(zoom), frameTimes));
+    }
+
+    // Pan (middle mouse button)
+    {
+        recenter();
+        const QPoint start = view.viewport()->rect().center();
+        sendMouseEvent(view, QEvent::MouseButtonPress, start, Qt::MiddleButton, Qt::MiddleButton);
+        const auto frameTimes = measure(frames, [&](int i) {
+            // Move back and forth to stay within the scene
+            const int step = ((i / 20) % 2) ? -8 : 8;
+            const QPoint pos = start + QPoint(step * (i % 20), step * (i % 20) / 2);
+            sendMouseEvent(view, QEvent::MouseMove, pos, Qt::NoButton, Qt::MiddleButton);
+        });
+        sendMouseEvent(view, QEvent::MouseButtonRelease, start, Qt::MiddleButton, Qt::NoButton);
+        scenarios.append(statistics(QStringLiteral("pan"), frameTimes));
+    }
+
+    // Hover highlighting
+    {
+        recenter();
+
+        // Alternate between the nodes around the center and empty space
+        std::vector<QPoint> positions;
+        const std::size_t first = nodes.size() / 2;
+        for (std::size_t i = first; i < std::min(first + 5, nodes.size()); i++) {
+            const QRectF rect = nodes[i]->sceneBoundingRect();
+            positions.push_back(view.mapFromScene(rect.center()));
+            positions.push_back(view.mapFromScene(rect.bottomRight() + QPointF(20, 20)));
+        }
+
+        const auto frameTimes = measure(frames, [&](int i) {
+            sendMouseEvent(view, QEvent::MouseMove, positions[i % positions.size()], Qt::NoButton, Qt::NoButton);
+        });
+        scenarios.append(statistics(QStringLiteral("hover"), frameTimes));
+    }
+
+    // Selection drag
+    {
+        recenter();
+        const QPoint start = view.mapFromScene(centerNode->sceneBoundingRect().center());
+        sendMouseEvent(view, QEvent::MouseButtonPress, start, Qt::LeftButton, Qt::LeftButton);
+        const auto frameTimes = measure(frames, [&](int i) {
+            const int offset = (i % 40 < 20) ? (i % 20) * 4 : (20 - i % 20) * 4;
+            sendMouseEvent(view, QEvent::MouseMove, start + QPoint(offset, offset), Qt::NoButton, Qt::LeftButton);
+        });
+        sendMouseEvent(view, QEvent::MouseButtonRelease, start, Qt::LeftButton, Qt::NoButton);
+        scenarios.append(statistics(QStringLiteral("selection-drag"), frameTimes));
+    }
+
+    // Assemble the report
+    QJsonObject report;
+    report.insert(QStringLiteral("qt_version"), QString::fromLatin1(qVersion()));
+    report.insert(QStringLiteral("platform"), QGuiApplication::platformName());
+    report.insert(QStringLiteral("nodes"), static_cast<qint64>(nodes.size()));
+    report.insert(QStringLiteral("wires"), static_cast<qint64>(wires.size()));
+    report.insert(QStringLiteral("viewport_width"), view.viewport()->width());
+    report.insert(QStringLiteral("viewport_height"), view.viewport()->height());
+    report.insert(QStringLiteral("viewport_update"), parser.value(viewportUpdateOption));
+    report.insert(QStringLiteral("batched_wires"), settings.batchedWireRendering);
+    report.insert(QStringLiteral("scenarios"), scenarios);
+
+    const QByteArray json = QJsonDocument(report).toJson(QJsonDocument::Indented);
+
+    // Write
+    if (parser.isSet(outputOption)) {
+        QFile file(parser.value(outputOption));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            std::fprintf(stderr, "could not open output file\n");
+            return 1;
+        }
+        file.write(json);
+    }
+    else
+        std::fwrite(json.constData(), 1, json.size(), stdout);
+
+    return 0;
+}
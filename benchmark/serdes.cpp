@@ -0,0 +1,283 @@
+/**
+ * Measures the file size and load time of the serdes format versions.
+ *
+ * Usage: qschematic-benchmark-serdes [--input FILE] [--scale N] [--iterations N] [--output FILE] [--converted FILE]
+ *
+ * The input file (serdes version 2, demo_01.xml by default) is scaled up by repeating its content. The scaled
+ * document is then converted to the current version. For both versions, the following is measured:
+ *   - The XML size
+ *   - Parsing the XML into a container tree
+ *   - Loading the container tree into a scene
+ *   - Loading the XML into a scene with the streaming loader
+ *
+ * The custom item types of the demo are loaded as their QSchematic base types (see Unwrapped).
+ *
+ * The results are written as JSON (to stdout unless an output file is specified). The benchmark runs on the offscreen
+ * platform unless QT_QPA_PLATFORM is set.
+ */
+
+#include "common.hpp"
+
+#include <qschematic/scene.hpp>
+#include <qschematic/serdes.hpp>
+#include <qschematic/items/connector.hpp>
+#include <qschematic/items/itemfactory.hpp>
+#include <qschematic/items/node.hpp>
+#include <qschematic/items/wire.hpp>
+#include <qschematic/xml_loader.hpp>
+
+#include <gpds/archiver_xml.hpp>
+#include <gpds/container.hpp>
+
+#include <QApplication>
+#include <QBuffer>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <utility>
+
+using namespace QSchematic;
+
+/**
+ * Stand-in for a custom item type of the demo.
+ *
+ * @details The demo item types store the container of their QSchematic base type under a single key. This loads that
+ *          container so that the demo files can be loaded without the demo item types.
+ */
+template<typename TBase>
+class Unwrapped :
+    public TBase
+{
+public:
+    explicit
+    Unwrapped(std::string key) :
+        m_key(std::move(key))
+    {
+    }
+
+    void
+    from_container(const gpds::container& container) override
+    {
+        if (const gpds::container* inner = container.get_value<gpds::container*>(m_key).value_or(nullptr))
+            TBase::from_container(*inner);
+    }
+
+private:
+    std::string m_key;
+};
+
+static
+std::shared_ptr<Items::Item>
+demoItemFactory(const gpds::container& container)
+{
+    if (container.get_value<gpds::container*>("wire"))
+        return std::make_shared<Unwrapped<Items::Wire>>("wire");
+    if (container.get_value<gpds::container*>("node"))
+        return std::make_shared<Unwrapped<Items::Node>>("node");
+    if (container.get_value<gpds::container*>("connector"))
+        return std::make_shared<Unwrapped<Items::Connector>>("connector");
+
+    return { };
+}
+
+/**
+ * Scale up a document by repeating the content of its root element.
+ */
+static
+QByteArray
+scale(const QByteArray& document, int factor)
+{
+    const qsizetype rootEnd = document.indexOf('>', document.indexOf("<" + QByteArray(Scene::gpds_name))) + 1;
+    const qsizetype closing = document.lastIndexOf("</" + QByteArray(Scene::gpds_name));
+    if (rootEnd <= 0 || closing < rootEnd)
+        return { };
+
+    const QByteArray content = document.mid(rootEnd, closing - rootEnd);
+
+    QByteArray ret = document.left(rootEnd);
+    ret.reserve(document.size() * factor);
+    for (int i = 0; i < factor; i++)
+        ret.append(content);
+    ret.append(document.mid(closing));
+
+    return ret;
+}
+
+template<typename Func>
+static
+double
+measure(int iterations, const Func& func)
+{
+    // Take the best run to reduce noise
+    qint64 best = std::numeric_limits<qint64>::max();
+    for (int i = 0; i < iterations; i++) {
+        QElapsedTimer timer;
+        timer.start();
+        func();
+        best = std::min(best, timer.nsecsElapsed());
+    }
+
+    return best / 1'000'000.0;
+}
+
+static
+QJsonObject
+run(const QString& name, const QByteArray& xml, int iterations)
+{
+    // Parse
+    const std::string data = xml.toStdString();
+    const double parseTime = measure(iterations, [&data] {
+        std::istringstream stream(data);
+        gpds::container container;
+        (void)gpds::archiver_xml().load(stream, container, Scene::gpds_name);
+    });
+
+    // Load from the container tree
+    gpds::container container;
+    {
+        std::istringstream stream(data);
+        (void)gpds::archiver_xml().load(stream, container, Scene::gpds_name);
+    }
+    Scene scene;
+    std::size_t itemCount = 0;
+    const double loadTime = measure(iterations, [&] {
+        scene.clear();
+        scene.from_container(container);
+        itemCount = scene.items().size();
+    });
+
+    // Streaming loader
+    const double streamTime = measure(iterations, [&] {
+        scene.clear();
+        QBuffer buffer;
+        buffer.setData(xml);
+        buffer.open(QIODevice::ReadOnly);
+        (void)XmlLoader::load(scene, buffer);
+    });
+
+    // Save to a container tree (single threaded & using all cores)
+    Settings settings;
+    settings.serializationThreads = 1;
+    scene.setSettings(settings);
+    const double saveTime = measure(iterations, [&scene] {
+        (void)scene.to_container();
+    });
+    settings.serializationThreads = 0;
+    scene.setSettings(settings);
+    const double parallelSaveTime = measure(iterations, [&scene] {
+        (void)scene.to_container();
+    });
+
+    QJsonObject ret;
+    ret.insert(QStringLiteral("version"), name);
+    ret.insert(QStringLiteral("bytes"), xml.size());
+    ret.insert(QStringLiteral("items"), static_cast<qint64>(itemCount));
+    ret.insert(QStringLiteral("parse_ms"), parseTime);
+    ret.insert(QStringLiteral("from_container_ms"), loadTime);
+    ret.insert(QStringLiteral("streaming_ms"), streamTime);
+    ret.insert(QStringLiteral("to_container_ms"), saveTime);
+    ret.insert(QStringLiteral("to_container_parallel_ms"), parallelSaveTime);
+
+    return ret;
+}
+
+int
+main(int argc, char* argv[])
+{
+    Benchmark::useOffscreenPlatform();
+
+    QApplication app(argc, argv);
+
+    // Command line
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    const QCommandLineOption inputOption(QStringLiteral("input"), QStringLiteral("Input file (serdes version 2)."), QStringLiteral("FILE"), QStringLiteral(QSCHEMATIC_BENCHMARK_DEMO_FILE));
+    const QCommandLineOption scaleOption(QStringLiteral("scale"), QStringLiteral("Number of times the input content is repeated."), QStringLiteral("N"), QStringLiteral("100"));
+    const QCommandLineOption iterationsOption(QStringLiteral("iterations"), QStringLiteral("Number of iterations per measurement."), QStringLiteral("N"), QStringLiteral("5"));
+    const QCommandLineOption outputOption(QStringLiteral("output"), QStringLiteral("JSON output file."), QStringLiteral("FILE"));
+    const QCommandLineOption convertedOption(QStringLiteral("converted"), QStringLiteral("Write the converted (scaled) document to this file."), QStringLiteral("FILE"));
+    parser.addOptions({ inputOption, scaleOption, iterationsOption, outputOption, convertedOption });
+    parser.process(app);
+
+    Items::Factory::instance().setCustomItemsFactory(demoItemFactory);
+
+    const int factor = std::max(1, parser.value(scaleOption).toInt());
+    const int iterations = std::max(1, parser.value(iterationsOption).toInt());
+
+    // Read & scale the input
+    QFile input(parser.value(inputOption));
+    if (!input.open(QIODevice::ReadOnly)) {
+        std::fprintf(stderr, "could not open input file\n");
+        return 1;
+    }
+    const QByteArray v2 = scale(input.readAll(), factor);
+    if (v2.isEmpty()) {
+        std::fprintf(stderr, "could not scale input file\n");
+        return 1;
+    }
+
+    // Convert
+    QByteArray v3;
+    {
+        gpds::container container;
+        std::istringstream in(v2.toStdString());
+        if (!gpds::archiver_xml().load(in, container, Scene::gpds_name).first || !Serdes::upgrade(container)) {
+            std::fprintf(stderr, "could not convert input file\n");
+            return 1;
+        }
+
+        std::ostringstream out;
+        if (!gpds::archiver_xml().save(out, container, Scene::gpds_name).first) {
+            std::fprintf(stderr, "could not write converted document\n");
+            return 1;
+        }
+        v3 = QByteArray::fromStdString(out.str());
+    }
+
+    if (parser.isSet(convertedOption)) {
+        QFile file(parser.value(convertedOption));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            std::fprintf(stderr, "could not open converted file\n");
+            return 1;
+        }
+        file.write(v3);
+    }
+
+    // Measure
+    QJsonArray versions;
+    versions.append(run(QStringLiteral("2"), v2, iterations));
+    versions.append(run(QString::number(Scene::serdes_version), v3, iterations));
+
+    // Assemble the report
+    QJsonObject report;
+    report.insert(QStringLiteral("qt_version"), QString::fromLatin1(qVersion()));
+    report.insert(QStringLiteral("input"), parser.value(inputOption));
+    report.insert(QStringLiteral("scale"), factor);
+    report.insert(QStringLiteral("iterations"), iterations);
+    report.insert(QStringLiteral("versions"), versions);
+
+    const QByteArray json = QJsonDocument(report).toJson(QJsonDocument::Indented);
+
+    // Write
+    if (parser.isSet(outputOption)) {
+        QFile file(parser.value(outputOption));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            std::fprintf(stderr, "could not open output file\n");
+            return 1;
+        }
+        file.write(json);
+    }
+    else
+        std::fwrite(json.constData(), 1, json.size(), stdout);
+
+    return 0;
+}
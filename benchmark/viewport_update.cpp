@@ -0,0 +1,125 @@
+/**
+ * Measures the repainted viewport area and the time spent per edit for each viewport update mode.
+ *
+ * Usage: qschematic-benchmark-viewport-update [edits]
+ *
+ * The benchmark runs on the offscreen platform unless QT_QPA_PLATFORM is set.
+ */
+
+#include "common.hpp"
+
+#include <qschematic/scene.hpp>
+#include <qschematic/settings.hpp>
+#include <qschematic/view.hpp>
+
+#include <QApplication>
+#include <QElapsedTimer>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <utility>
+
+using namespace QSchematic;
+using Benchmark::PaintProbe;
+
+constexpr int NODE_COUNT = 900;
+
+struct Result
+{
+    double microsecondsPerEdit = 0;
+    double pixelsPerEdit = 0;
+    double viewportFraction = 0;
+};
+
+template<typename Edit>
+static
+Result
+measure(View& view, PaintProbe& probe, int edits, const Edit& edit)
+{
+    QApplication::processEvents();
+    probe.reset();
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < edits; i++) {
+        edit(i);
+        QApplication::processEvents();
+    }
+    const qint64 elapsed = timer.nsecsElapsed();
+
+    const qint64 viewportArea = static_cast<qint64>(view.viewport()->width()) * view.viewport()->height();
+
+    Result result;
+    result.microsecondsPerEdit = elapsed / 1000.0 / edits;
+    result.pixelsPerEdit = static_cast<double>(probe.area) / edits;
+    result.viewportFraction = viewportArea > 0 ? result.pixelsPerEdit / viewportArea : 0;
+
+    return result;
+}
+
+static
+void
+print(const char* mode, const char* edit, const Result& result)
+{
+    std::printf("%-14s %-14s %12.1f %14.0f %9.1f%%\n", mode, edit, result.microsecondsPerEdit, result.pixelsPerEdit, result.viewportFraction * 100);
+}
+
+int
+main(int argc, char* argv[])
+{
+    Benchmark::useOffscreenPlatform();
+
+    QApplication app(argc, argv);
+
+    const int edits = argc > 1 ? std::max(1, std::atoi(argv[1])) : 200;
+
+    const std::pair<const char*, Settings::ViewportUpdate> modes[] = {
+        { "full",          Settings::ViewportUpdate::Full },
+        { "minimal",       Settings::ViewportUpdate::Minimal },
+        { "smart",         Settings::ViewportUpdate::Smart },
+        { "bounding-rect", Settings::ViewportUpdate::BoundingRect },
+    };
+
+    std::printf("%-14s %-14s %12s %14s %10s\n", "mode", "edit", "us/edit", "px/edit", "viewport");
+    for (const auto& [name, mode] : modes) {
+        Settings settings;
+        settings.viewportUpdate = mode;
+
+        Scene scene;
+        scene.setSettings(settings);
+
+        const auto [nodes, wires] = Benchmark::populate(scene, NODE_COUNT);
+
+        View view;
+        view.setSettings(settings);
+        view.setScene(&scene);
+        view.resize(1280, 800);
+        view.show();
+        view.centerOn(nodes[nodes.size() / 2].get());
+
+        PaintProbe probe;
+        view.viewport()->installEventFilter(&probe);
+
+        // Pick the items closest to the center so that the edits are visible
+        const std::size_t wireIndex = wires.size() / 2;
+        const std::size_t nodeIndex = nodes.size() / 2;
+
+        // Move a wire point back and forth
+        const QPointF origin = wires[wireIndex]->pointsAbsolute().at(1);
+        const auto movePoint = [&](int i) {
+            const QPointF offset(0, (i % 2) ? settings.gridSize : 0);
+            wires[wireIndex]->move_point_to(1, origin + offset);
+        };
+        print(name, "wire-point", measure(view, probe, edits, movePoint));
+
+        // Toggle the highlight of a node
+        const auto toggleHighlight = [&](int i) {
+            nodes[nodeIndex]->setHighlighted(i % 2 == 0);
+            nodes[nodeIndex]->update();
+        };
+        print(name, "highlight", measure(view, probe, edits, toggleHighlight));
+    }
+
+    return 0;
+}
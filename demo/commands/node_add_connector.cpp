@@ -52,3 +52,12 @@ NodeAddConnector::redo()
     _node->addConnector(_connector);
     _connector->setVisible(true);
 }
+
+std::optional<QVector<std::shared_ptr<QSchematic::Items::Item>>>
+NodeAddConnector::affectedItems() const
+{
+    if (!_node)
+        return QVector<std::shared_ptr<QSchematic::Items::Item>>{ };
+
+    return { _node->sharedPtr() };
+}
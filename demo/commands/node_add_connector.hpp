@@ -28,6 +28,7 @@ namespace Commands
         bool mergeWith(const QUndoCommand* command) override;
         void undo() override;
         void redo() override;
+        std::optional<QVector<std::shared_ptr<QSchematic::Items::Item>>> affectedItems() const override;
 
     private:
         QPointer<QSchematic::Items::Node> _node;
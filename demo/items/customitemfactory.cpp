@@ -11,36 +11,16 @@
 
 #include <qschematic/items/itemfactory.hpp>
 
-std::shared_ptr<QSchematic::Items::Item> CustomItemFactory::from_container(const gpds::container& container)
+void CustomItemFactory::registerTypes()
 {
-    // Extract the type
-    QSchematic::Items::Item::ItemType type = QSchematic::Items::Factory::extractType(container);
-
-    switch (static_cast<ItemType>(type)) {
-    case ItemType::OperationType:
-        return std::make_shared<Operation>();
-
-    case ItemType::OperationConnectorType:
-        return std::make_shared<OperationConnector>();
-
-    case ItemType::OperationDemo1Type:
-        return std::make_shared<OperationDemo1>();
-
-    case ItemType::FancyWireType:
-        return std::make_shared<FancyWire>();
-
-    case ItemType::FlowStartType:
-        return std::make_shared<FlowStart>();
-
-    case ItemType::FlowEndType:
-        return std::make_shared<FlowEnd>();
-
-    case ItemType::WidgetDial:
-        return std::make_shared<Items::Widgets::Dial>();
-
-    case ItemType::WidgetTextedit:
-        return std::make_shared<Items::Widgets::Textedit>();
-    }
-
-    return {};
+    auto& factory = QSchematic::Items::Factory::instance();
+
+    factory.registerType<Operation>(ItemType::OperationType);
+    factory.registerType<OperationConnector>(ItemType::OperationConnectorType);
+    factory.registerType<OperationDemo1>(ItemType::OperationDemo1Type);
+    factory.registerType<FancyWire>(ItemType::FancyWireType);
+    factory.registerType<FlowStart>(ItemType::FlowStartType);
+    factory.registerType<FlowEnd>(ItemType::FlowEndType);
+    factory.registerType<Items::Widgets::Dial>(ItemType::WidgetDial);
+    factory.registerType<Items::Widgets::Textedit>(ItemType::WidgetTextedit);
 }
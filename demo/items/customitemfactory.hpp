@@ -20,7 +20,7 @@ namespace gpds
 class CustomItemFactory
 {
 public:
-    static std::shared_ptr<QSchematic::Items::Item> from_container(const gpds::container& container);
+    static void registerTypes();
 
 private:
     CustomItemFactory() = default;
@@ -8,8 +8,10 @@
 #include "netlist/widget.hpp"
 
 #include <gpds/archiver_xml.hpp>
+#include <qschematic/archiver_binary.hpp>
 #include <qschematic/scene.hpp>
 #include <qschematic/view.hpp>
+#include <qschematic/xml_loader.hpp>
 #include <qschematic/commands/item_add.hpp>
 #include <qschematic/items/node.hpp>
 #include <qschematic/items/itemfactory.hpp>
@@ -39,14 +41,13 @@
 #include <memory>
 #include <sstream>
 
-const QString FILE_FILTERS = "XML (*.xml)";
+const QString FILE_FILTERS = "XML (*.xml);;Binary (*.qsb)";
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
 {
-    // Setup the custom item factory
-    auto func = std::bind(&CustomItemFactory::from_container, std::placeholders::_1);
-    QSchematic::Items::Factory::instance().setCustomItemsFactory(func);
+    // Register the custom item types
+    CustomItemFactory::registerTypes();
 
     // Settings
     _settings.debug = false;
@@ -170,7 +171,9 @@ bool MainWindow::save()
         return false;
 
     // Serialize with GPDS
-    const auto& [success, message] = gpds::to_file<gpds::archiver_xml>(path, *_scene);
+    const auto& [success, message] = path.extension() == ".qsb" ?
+                                     gpds::to_file<QSchematic::ArchiverBinary>(path, *_scene) :
+                                     gpds::to_file<gpds::archiver_xml>(path, *_scene);
     if (!success) {
         qWarning() << "could not save to file: " << QString::fromStdString(message);
         return false;
@@ -202,11 +205,17 @@ bool MainWindow::load(const QString& filepath)
     file.open(QFile::ReadOnly);
     if (!file.isOpen())
         return false;
-    std::stringstream stream;
-    stream << file.readAll().data();
 
     // Archiver
-    const auto& [success, message] = gpds::from_stream<gpds::archiver_xml>(stream, *_scene, QSchematic::Scene::gpds_name);
+    // Note: XML files are streamed to avoid building the container tree of the entire document.
+    std::pair<bool, std::string> result;
+    if (filepath.endsWith(".qsb")) {
+        std::stringstream stream(file.readAll().toStdString());
+        result = gpds::from_stream<QSchematic::ArchiverBinary>(stream, *_scene, QSchematic::Scene::gpds_name);
+    }
+    else
+        result = QSchematic::XmlLoader::load(*_scene, file);
+    const auto& [success, message] = result;
     if (!success) {
         qDebug() << "MainWindow::load(): Could not load scene: " << QString::fromStdString(message);
         return false;
@@ -0,0 +1,565 @@
+#include "archiver_binary.hpp"
+#include "serdes.hpp"
+
+#include <gpds/container.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+using namespace QSchematic;
+
+namespace
+{
+
+    constexpr char MAGIC[4] = { 'Q', 'S', 'B', 'A' };
+    constexpr std::size_t MAX_DEPTH = 512;
+
+    // Value type tags
+    enum Tag : std::uint8_t
+    {
+        TagBool      = 0,
+        TagInt       = 1,
+        TagDouble    = 2,
+        TagString    = 3,
+        TagContainer = 4,
+        TagPoints    = 5,
+    };
+
+    // Coordinate types of point arrays
+    enum PointShape : std::uint8_t
+    {
+        PointsI32 = 0,
+        PointsF64 = 1,
+    };
+
+    constexpr std::string_view POINTS_KEY = "points";
+
+    [[nodiscard]]
+    bool
+    isI32(double v)
+    {
+        // Note: Negative zero is not preserved by int32
+        return v >= std::numeric_limits<std::int32_t>::min() && v <= std::numeric_limits<std::int32_t>::max() &&
+               std::trunc(v) == v && !(v == 0 && std::signbit(v));
+    }
+
+    /**
+     * Serialization.
+     */
+    class Writer
+    {
+    public:
+        std::string body;
+
+        void
+        writeU8(std::uint8_t v)
+        {
+            body.push_back(static_cast<char>(v));
+        }
+
+        void
+        writeVarint(std::uint64_t v, std::string& out)
+        {
+            while (v >= 0x80) {
+                out.push_back(static_cast<char>((v & 0x7f) | 0x80));
+                v >>= 7;
+            }
+            out.push_back(static_cast<char>(v));
+        }
+
+        void
+        writeVarint(std::uint64_t v)
+        {
+            writeVarint(v, body);
+        }
+
+        void
+        writeI32(std::int32_t v)
+        {
+            const auto u = static_cast<std::uint32_t>(v);
+            for (int i = 0; i < 4; i++)
+                body.push_back(static_cast<char>((u >> (8 * i)) & 0xff));
+        }
+
+        void
+        writeF64(double v)
+        {
+            const auto u = std::bit_cast<std::uint64_t>(v);
+            for (int i = 0; i < 8; i++)
+                body.push_back(static_cast<char>((u >> (8 * i)) & 0xff));
+        }
+
+        void
+        writeString(const std::string& string)
+        {
+            writeVarint(intern(string));
+        }
+
+        template<typename TAttributes>
+        void
+        writeAttributes(const TAttributes& attributes)
+        {
+            writeVarint(std::size(attributes.map));
+            for (const auto& [key, value] : attributes.map) {
+                writeString(key);
+                writeString(value);
+            }
+        }
+
+        void
+        writeContainer(const gpds::container& container)
+        {
+            writeAttributes(container.attributes);
+
+            writeVarint(std::size(container.values));
+            for (const auto& [key, value] : container.values)
+                writeValue(key, value);
+        }
+
+        [[nodiscard]]
+        std::string
+        stringTable()
+        {
+            std::string out;
+            writeVarint(m_strings.size(), out);
+            for (const std::string* string : m_strings) {
+                writeVarint(string->size(), out);
+                out.append(*string);
+            }
+
+            return out;
+        }
+
+    private:
+        std::unordered_map<std::string, std::uint32_t> m_ids;
+        std::vector<const std::string*> m_strings;
+
+        std::uint32_t
+        intern(const std::string& string)
+        {
+            const auto [it, inserted] = m_ids.try_emplace(string, static_cast<std::uint32_t>(m_strings.size()));
+            if (inserted)
+                m_strings.push_back(&it->first);
+
+            return it->second;
+        }
+
+        void
+        writeValue(const std::string& key, const gpds::value& value)
+        {
+            if (value.is_type<bool>()) {
+                writeU8(TagBool);
+                writeString(key);
+                writeAttributes(value.attributes);
+                writeU8(value.get<bool>().value_or(false) ? 1 : 0);
+            }
+            else if (value.is_type<int>()) {
+                writeU8(TagInt);
+                writeString(key);
+                writeAttributes(value.attributes);
+                writeI32(value.get<int>().value_or(0));
+            }
+            else if (value.is_type<double>()) {
+                writeU8(TagDouble);
+                writeString(key);
+                writeAttributes(value.attributes);
+                writeF64(value.get<double>().value_or(0));
+            }
+            else if (value.is_type<gpds::container*>()) {
+                writeU8(TagContainer);
+                writeString(key);
+                writeAttributes(value.attributes);
+                const gpds::container* container = value.get<gpds::container*>().value_or(nullptr);
+                writeContainer(container ? *container : gpds::container{ });
+            }
+            else {
+                const std::string string = value.get<std::string>().value_or(std::string{ });
+                if (key == POINTS_KEY && writePoints(key, value.attributes, string))
+                    return;
+
+                writeU8(TagString);
+                writeString(key);
+                writeAttributes(value.attributes);
+                writeString(string);
+            }
+        }
+
+        /**
+         * Write packed points as an array of coordinates.
+         *
+         * @return Whether the string was written. Strings which do not hold packed points (or which would not be
+         *         restored exactly) are not written.
+         */
+        bool
+        writePoints(const std::string& key, const gpds::attributes& attributes, const std::string& string)
+        {
+            const auto points = Serdes::unpackPoints(string);
+            if (!points || points->isEmpty() || Serdes::packPoints(*points) != string)
+                return false;
+
+            const bool integral = std::ranges::all_of(*points, [](const QPointF& point) {
+                return isI32(point.x()) && isI32(point.y());
+            });
+
+            writeU8(TagPoints);
+            writeString(key);
+            writeAttributes(attributes);
+            writeVarint(points->size());
+            writeU8(integral ? PointsI32 : PointsF64);
+            for (const QPointF& point : *points) {
+                if (integral) {
+                    writeI32(static_cast<std::int32_t>(point.x()));
+                    writeI32(static_cast<std::int32_t>(point.y()));
+                }
+                else {
+                    writeF64(point.x());
+                    writeF64(point.y());
+                }
+            }
+
+            return true;
+        }
+    };
+
+    /**
+     * Deserialization.
+     */
+    class Reader
+    {
+    public:
+        explicit
+        Reader(std::string_view data) :
+            m_data(data)
+        {
+        }
+
+        [[nodiscard]]
+        bool
+        atEnd() const
+        {
+            return m_pos >= m_data.size();
+        }
+
+        bool
+        readBytes(char* out, std::size_t count)
+        {
+            if (m_data.size() - m_pos < count)
+                return false;
+            std::copy_n(m_data.data() + m_pos, count, out);
+            m_pos += count;
+            return true;
+        }
+
+        bool
+        readU8(std::uint8_t& v)
+        {
+            char c;
+            if (!readBytes(&c, 1))
+                return false;
+            v = static_cast<std::uint8_t>(c);
+            return true;
+        }
+
+        bool
+        readVarint(std::uint64_t& v)
+        {
+            v = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                std::uint8_t byte;
+                if (!readU8(byte))
+                    return false;
+                v |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+                if (!(byte & 0x80))
+                    return true;
+            }
+            return false;
+        }
+
+        bool
+        readI32(std::int32_t& v)
+        {
+            char bytes[4];
+            if (!readBytes(bytes, 4))
+                return false;
+            std::uint32_t u = 0;
+            for (int i = 0; i < 4; i++)
+                u |= static_cast<std::uint32_t>(static_cast<std::uint8_t>(bytes[i])) << (8 * i);
+            v = static_cast<std::int32_t>(u);
+            return true;
+        }
+
+        bool
+        readF64(double& v)
+        {
+            char bytes[8];
+            if (!readBytes(bytes, 8))
+                return false;
+            std::uint64_t u = 0;
+            for (int i = 0; i < 8; i++)
+                u |= static_cast<std::uint64_t>(static_cast<std::uint8_t>(bytes[i])) << (8 * i);
+            v = std::bit_cast<double>(u);
+            return true;
+        }
+
+        bool
+        readStringTable()
+        {
+            std::uint64_t count;
+            if (!readVarint(count) || count > m_data.size())
+                return false;
+
+            m_strings.reserve(count);
+            for (std::uint64_t i = 0; i < count; i++) {
+                std::uint64_t size;
+                if (!readVarint(size) || size > m_data.size() - m_pos)
+                    return false;
+                m_strings.emplace_back(m_data.data() + m_pos, size);
+                m_pos += size;
+            }
+
+            return true;
+        }
+
+        bool
+        readString(std::string& string)
+        {
+            std::uint64_t id;
+            if (!readVarint(id) || id >= m_strings.size())
+                return false;
+            string = m_strings[id];
+            return true;
+        }
+
+        template<typename TAttributes>
+        bool
+        readAttributes(TAttributes& attributes)
+        {
+            std::uint64_t count;
+            if (!readVarint(count))
+                return false;
+
+            for (std::uint64_t i = 0; i < count; i++) {
+                std::string key;
+                std::string value;
+                if (!readString(key) || !readString(value))
+                    return false;
+                attributes.map.insert_or_assign(std::move(key), std::move(value));
+            }
+
+            return true;
+        }
+
+        bool
+        readContainer(gpds::container& container, std::size_t depth = 0)
+        {
+            if (depth > MAX_DEPTH)
+                return false;
+
+            if (!readAttributes(container.attributes))
+                return false;
+
+            std::uint64_t count;
+            if (!readVarint(count))
+                return false;
+
+            for (std::uint64_t i = 0; i < count; i++) {
+                std::uint8_t tag;
+                std::string key;
+                if (!readU8(tag) || !readString(key))
+                    return false;
+
+                gpds::attributes attributes;
+                if (!readAttributes(attributes))
+                    return false;
+
+                gpds::value* added = nullptr;
+                switch (tag) {
+                    case TagBool: {
+                        std::uint8_t v;
+                        if (!readU8(v))
+                            return false;
+                        added = &container.add_value(key, v != 0);
+                        break;
+                    }
+
+                    case TagInt: {
+                        std::int32_t v;
+                        if (!readI32(v))
+                            return false;
+                        added = &container.add_value(key, static_cast<int>(v));
+                        break;
+                    }
+
+                    case TagDouble: {
+                        double v;
+                        if (!readF64(v))
+                            return false;
+                        added = &container.add_value(key, v);
+                        break;
+                    }
+
+                    case TagString: {
+                        std::string v;
+                        if (!readString(v))
+                            return false;
+                        added = &container.add_value(key, v);
+                        break;
+                    }
+
+                    case TagPoints: {
+                        std::string v;
+                        if (!readPoints(v))
+                            return false;
+                        added = &container.add_value(key, v);
+                        break;
+                    }
+
+                    case TagContainer: {
+                        gpds::container child;
+                        if (!readContainer(child, depth + 1))
+                            return false;
+                        added = &container.add_value(key, child);
+                        break;
+                    }
+
+                    default:
+                        return false;
+                }
+
+                // Attach the attributes to the value we just added
+                if (!std::empty(attributes.map))
+                    added->attributes = std::move(attributes);
+            }
+
+            return true;
+        }
+
+    private:
+        std::string_view m_data;
+        std::size_t m_pos = 0;
+
+        bool
+        readPoints(std::string& string)
+        {
+            std::uint64_t count;
+            std::uint8_t shape;
+            if (!readVarint(count) || !readU8(shape))
+                return false;
+
+            const std::size_t pointSize = shape == PointsI32 ? 8 : 16;
+            if ((shape != PointsI32 && shape != PointsF64) || count > (m_data.size() - m_pos) / pointSize)
+                return false;
+
+            QVector<QPointF> points;
+            points.reserve(static_cast<qsizetype>(count));
+            for (std::uint64_t i = 0; i < count; i++) {
+                if (shape == PointsI32) {
+                    std::int32_t x;
+                    std::int32_t y;
+                    if (!readI32(x) || !readI32(y))
+                        return false;
+                    points.append(QPointF(x, y));
+                }
+                else {
+                    double x;
+                    double y;
+                    if (!readF64(x) || !readF64(y))
+                        return false;
+                    points.append(QPointF(x, y));
+                }
+            }
+
+            string = Serdes::packPoints(points);
+
+            return true;
+        }
+        std::vector<std::string> m_strings;
+    };
+
+}
+
+std::pair<bool, std::string>
+ArchiverBinary::save(std::ostream& stream, const gpds::container& container, std::string_view root_name) const
+{
+    // Serialize the tree
+    Writer writer;
+    const std::string rootName(root_name);
+    writer.writeString(rootName);
+    writer.writeContainer(container);
+
+    // Header
+    stream.write(MAGIC, sizeof(MAGIC));
+    const char version[2] = { static_cast<char>(format_version & 0xff), static_cast<char>(format_version >> 8) };
+    stream.write(version, sizeof(version));
+
+    // String table & tree
+    const std::string table = writer.stringTable();
+    stream.write(table.data(), static_cast<std::streamsize>(table.size()));
+    stream.write(writer.body.data(), static_cast<std::streamsize>(writer.body.size()));
+
+    if (!stream.good())
+        return { false, "could not write to stream" };
+
+    return { true, "" };
+}
+
+std::pair<bool, std::string>
+ArchiverBinary::load(std::istream& stream, gpds::container& container, std::string_view root_name)
+{
+    // Read everything
+    const std::string data{ std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>() };
+
+    return loadFromMemory(data, container, root_name);
+}
+
+std::pair<bool, std::string>
+ArchiverBinary::loadFromMemory(std::string_view data, gpds::container& container, std::string_view root_name) const
+{
+    Reader reader(data);
+
+    // Header
+    char magic[sizeof(MAGIC)];
+    if (!reader.readBytes(magic, sizeof(magic)) || !std::equal(std::cbegin(magic), std::cend(magic), std::cbegin(MAGIC)))
+        return { false, "not a binary archive" };
+
+    char versionBytes[2];
+    if (!reader.readBytes(versionBytes, sizeof(versionBytes)))
+        return { false, "truncated header" };
+    const std::uint16_t version = static_cast<std::uint8_t>(versionBytes[0]) | (static_cast<std::uint8_t>(versionBytes[1]) << 8);
+    if (version != format_version)
+        return { false, "unsupported binary archive version " + std::to_string(version) };
+
+    // String table
+    if (!reader.readStringTable())
+        return { false, "corrupt string table" };
+
+    // Root
+    std::string rootName;
+    if (!reader.readString(rootName))
+        return { false, "corrupt root name" };
+    if (!root_name.empty() && rootName != root_name)
+        return { false, "unexpected root name \"" + rootName + "\"" };
+
+    if (!reader.readContainer(container) || !reader.atEnd())
+        return { false, "corrupt archive" };
+
+    return { true, "" };
+}
+
+std::pair<bool, std::string>
+ArchiverBinary::convert(std::istream& in, gpds::archiver& from, std::ostream& out, const gpds::archiver& to, std::string_view root_name)
+{
+    gpds::container container;
+    if (const auto& [success, message] = from.load(in, container, root_name); !success)
+        return { false, "could not read input: " + message };
+
+    if (const auto& [success, message] = to.save(out, container, root_name); !success)
+        return { false, "could not write output: " + message };
+
+    return { true, "" };
+}
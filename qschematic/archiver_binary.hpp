@@ -0,0 +1,75 @@
+#pragma once
+
+#include <gpds/archiver.hpp>
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace QSchematic
+{
+
+    /**
+     * A compact binary GPDS archiver.
+     *
+     * @details Layout (all numbers little endian):
+     *            - Magic (4 bytes) & format version (uint16)
+     *            - String table: Every key, attribute and string value is stored once and referenced by its index
+     *            - The root name (string table index)
+     *            - The container tree
+     *          Integers and doubles are stored as fixed width fields (int32 and float64). Lengths, counts and string
+     *          table indices are stored as variable length (LEB128) integers.
+     *          String values named `points` which hold points packed by Serdes::packPoints() (ie. the points of wires)
+     *          are stored as arrays of coordinates instead: int32 pairs if all coordinates are integral, float64 pairs
+     *          otherwise. They are packed into a string again on load. This applies to containers loaded from XML as
+     *          well.
+     *
+     * @note The archiver operates on the generic container tree. Therefore, anything that can be stored as XML can
+     *       be stored as binary and vice versa (see convert()).
+     */
+    class ArchiverBinary :
+        public gpds::archiver
+    {
+    public:
+        static constexpr std::uint16_t format_version = 2;
+
+        ArchiverBinary() = default;
+        ~ArchiverBinary() override = default;
+
+        [[nodiscard]]
+        std::pair<bool, std::string>
+        save(std::ostream& stream, const gpds::container& container, std::string_view root_name) const override;
+
+        [[nodiscard]]
+        std::pair<bool, std::string>
+        load(std::istream& stream, gpds::container& container, std::string_view root_name) override;
+
+        /**
+         * Load from a memory buffer.
+         *
+         * @note Unlike load(), this does not copy the data. This is useful for memory mapped files.
+         */
+        [[nodiscard]]
+        std::pair<bool, std::string>
+        loadFromMemory(std::string_view data, gpds::container& container, std::string_view root_name) const;
+
+        /**
+         * Convert between two archive formats (eg. XML to binary).
+         *
+         * @param in The input stream.
+         * @param from The archiver used to read the input stream.
+         * @param out The output stream.
+         * @param to The archiver used to write the output stream.
+         * @param root_name The name of the root container.
+         * @return Success indicator & message.
+         */
+        [[nodiscard]]
+        static
+        std::pair<bool, std::string>
+        convert(std::istream& in, gpds::archiver& from, std::ostream& out, const gpds::archiver& to, std::string_view root_name);
+    };
+
+}
@@ -0,0 +1,321 @@
+#include "auto_save.hpp"
+#include "archiver_binary.hpp"
+#include "scene.hpp"
+#include "items/wire.hpp"
+#include "items/wirenet.hpp"
+#include "wire_system/manager.hpp"
+
+#include <gpds/container.hpp>
+
+#include <QFile>
+#include <QSaveFile>
+#include <QTimer>
+
+#include <algorithm>
+#include <cstring>
+#include <ranges>
+#include <sstream>
+
+using namespace QSchematic;
+
+namespace
+{
+
+    constexpr char MAGIC[4] = { 'Q', 'S', 'A', 'S' };
+
+}
+
+/**
+ * Immutable snapshot of the scene.
+ *
+ * @note The containers are shared with the records of the AutoSave. They are never modified once created.
+ */
+struct AutoSave::Snapshot
+{
+    gpds::container scene;
+    std::vector<std::shared_ptr<const gpds::container>> items;
+    std::vector<std::shared_ptr<const gpds::container>> nets;
+};
+
+AutoSave::AutoSave(Scene* scene, QObject* parent) :
+    QObject(parent),
+    m_scene(scene),
+    m_changes(scene)
+{
+    m_timer = new QTimer(this);
+    m_timer->setInterval(default_interval);
+    connect(m_timer, &QTimer::timeout, this, [this] {
+        save();
+    });
+}
+
+AutoSave::~AutoSave()
+{
+    // The worker must not outlive us
+    if (m_future.valid())
+        m_future.wait();
+}
+
+void
+AutoSave::setFilePath(const QString& filePath)
+{
+    m_filePath = filePath;
+    m_upToDate = false;
+}
+
+QString
+AutoSave::filePath() const
+{
+    return m_filePath;
+}
+
+void
+AutoSave::setInterval(std::chrono::milliseconds interval)
+{
+    m_timer->setInterval(interval);
+}
+
+std::chrono::milliseconds
+AutoSave::interval() const
+{
+    return m_timer->intervalAsDuration();
+}
+
+void
+AutoSave::setCompressionLevel(int level)
+{
+    m_compressionLevel = std::clamp(level, -1, 9);
+}
+
+int
+AutoSave::compressionLevel() const
+{
+    return m_compressionLevel;
+}
+
+void
+AutoSave::start()
+{
+    m_timer->start();
+}
+
+void
+AutoSave::stop()
+{
+    m_timer->stop();
+}
+
+bool
+AutoSave::isActive() const
+{
+    return m_timer->isActive();
+}
+
+bool
+AutoSave::save()
+{
+    // Sanity check
+    if (!m_scene || m_filePath.isEmpty())
+        return false;
+
+    // Only one save at a time
+    if (m_saving) {
+        m_pending = true;
+        return true;
+    }
+
+    // Nothing changed since the last save
+    if (m_upToDate && m_changes.isEmpty())
+        return false;
+
+    const auto start = std::chrono::steady_clock::now();
+    auto snapshot = capture();
+    m_captureTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    // Encode, compress & write on a worker thread
+    m_saving = true;
+    m_future = std::async(std::launch::async, [this, snapshot = std::move(snapshot), filePath = m_filePath, level = m_compressionLevel] {
+        const auto result = write(*snapshot, filePath, level);
+
+        QMetaObject::invokeMethod(this, [this, result] {
+            finished(result.first, QString::fromStdString(result.second));
+        }, Qt::QueuedConnection);
+    });
+
+    return true;
+}
+
+bool
+AutoSave::isSaving() const
+{
+    return m_saving;
+}
+
+std::chrono::microseconds
+AutoSave::lastCaptureTime() const
+{
+    return m_captureTime;
+}
+
+std::pair<bool, std::string>
+AutoSave::load(Scene& scene, const QString& filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly))
+        return { false, "could not open file: " + file.errorString().toStdString() };
+
+    const QByteArray data = file.readAll();
+    if (data.size() < qsizetype(sizeof(MAGIC)) || std::memcmp(data.constData(), MAGIC, sizeof(MAGIC)) != 0)
+        return { false, "invalid magic" };
+
+    const QByteArray uncompressed = qUncompress(reinterpret_cast<const uchar*>(data.constData()) + sizeof(MAGIC), data.size() - qsizetype(sizeof(MAGIC)));
+    if (uncompressed.isEmpty())
+        return { false, "could not decompress data" };
+
+    gpds::container root;
+    const std::string_view view(uncompressed.constData(), static_cast<std::size_t>(uncompressed.size()));
+    if (const auto [success, message] = ArchiverBinary().loadFromMemory(view, root, Scene::gpds_name); !success)
+        return { false, "could not decode data: " + message };
+
+    scene.from_container(root);
+
+    return { true, "" };
+}
+
+std::shared_ptr<const AutoSave::Snapshot>
+AutoSave::capture()
+{
+    auto snapshot = std::make_shared<Snapshot>();
+    snapshot->scene = m_scene->saveSceneProperties();
+
+    // Rebuild all records
+    if (m_changes.takeReset() || !m_recordsValid) {
+        m_changes.clear();
+        m_itemRecords.clear();
+        m_netRecords.clear();
+        m_items.clear();
+        m_nets.clear();
+
+        for (const auto& item : m_scene->items()) {
+            if (item)
+                updateItem(item.get(), item);
+        }
+        for (const auto& net : m_scene->wire_manager()->nets()) {
+            if (net)
+                updateNet(net.get(), net);
+        }
+
+        m_recordsValid = true;
+    }
+
+    // Update the records of everything that changed
+    else {
+        const auto changedItems = m_changes.takeItems();
+        for (auto it = changedItems.cbegin(); it != changedItems.cend(); ++it)
+            updateItem(it.key(), it.value().lock());
+
+        const auto changedNets = m_changes.takeNets();
+        for (auto it = changedNets.cbegin(); it != changedNets.cend(); ++it)
+            updateNet(it.key(), it.value().lock());
+    }
+
+    snapshot->items.reserve(m_items.size());
+    for (const auto& container : m_items | std::views::values)
+        snapshot->items.push_back(container);
+
+    snapshot->nets.reserve(m_nets.size());
+    for (const auto& container : m_nets | std::views::values)
+        snapshot->nets.push_back(container);
+
+    return snapshot;
+}
+
+void
+AutoSave::updateItem(const Items::Item* key, const std::shared_ptr<Items::Item>& item)
+{
+    // Wire items are stored as part of their net
+    const bool inScene = item && item->scene() == m_scene && !item->parentItem() && !std::dynamic_pointer_cast<Items::Wire>(item);
+
+    // Forget the previous item if it is gone (or if another item took over its address)
+    auto record = m_itemRecords.find(key);
+    if (record != m_itemRecords.end() && (!inScene || record->item.lock() != item)) {
+        m_items.erase(record->order);
+        m_itemRecords.erase(record);
+        record = m_itemRecords.end();
+    }
+    if (!inScene)
+        return;
+
+    if (record == m_itemRecords.end())
+        record = m_itemRecords.insert(key, { item, m_nextOrder++ });
+
+    m_items.insert_or_assign(record->order, std::make_shared<const gpds::container>(item->to_container()));
+}
+
+void
+AutoSave::updateNet(const wire_system::net* key, const std::shared_ptr<wire_system::net>& net)
+{
+    auto wireNet = std::dynamic_pointer_cast<Items::WireNet>(net);
+    const bool inScene = wireNet && m_scene->wire_manager()->has_net(wireNet.get());
+
+    // Forget the previous net if it is gone (or if another net took over its address)
+    auto record = m_netRecords.find(key);
+    if (record != m_netRecords.end() && (!inScene || record->net.lock() != wireNet)) {
+        m_nets.erase(record->order);
+        m_netRecords.erase(record);
+        record = m_netRecords.end();
+    }
+    if (!inScene)
+        return;
+
+    if (record == m_netRecords.end())
+        record = m_netRecords.insert(key, { wireNet, m_nextOrder++ });
+
+    m_nets.insert_or_assign(record->order, std::make_shared<const gpds::container>(wireNet->to_container()));
+}
+
+void
+AutoSave::finished(bool success, const QString& message)
+{
+    m_saving = false;
+    m_upToDate = success;
+
+    Q_EMIT saved(success, message);
+
+    // Changes were made while saving
+    if (std::exchange(m_pending, false))
+        save();
+}
+
+std::pair<bool, std::string>
+AutoSave::write(const Snapshot& snapshot, const QString& filePath, int compressionLevel)
+{
+    // Same layout as Scene::to_container() (minus the connectivity)
+    gpds::container root;
+    root.add_attribute("version", Scene::serdes_version);
+    root.add_value("scene", snapshot.scene);
+    for (const auto& item : snapshot.items)
+        root.add_value("item", *item);
+    for (const auto& net : snapshot.nets)
+        root.add_value("net", *net);
+
+    // Encode
+    std::ostringstream stream;
+    if (const auto [success, message] = ArchiverBinary().save(stream, root, Scene::gpds_name); !success)
+        return { false, "could not encode data: " + message };
+    const std::string data = stream.str();
+
+    // Compress
+    const QByteArray compressed = qCompress(reinterpret_cast<const uchar*>(data.data()), static_cast<qsizetype>(data.size()), compressionLevel);
+
+    // Write
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly))
+        return { false, "could not open file: " + file.errorString().toStdString() };
+    if (file.write(MAGIC, sizeof(MAGIC)) != qint64(sizeof(MAGIC)) || file.write(compressed) != compressed.size())
+        return { false, "could not write file: " + file.errorString().toStdString() };
+    if (!file.commit())
+        return { false, "could not commit file: " + file.errorString().toStdString() };
+
+    return { true, "" };
+}
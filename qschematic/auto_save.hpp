@@ -0,0 +1,220 @@
+#pragma once
+
+#include "change_tracker.hpp"
+
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+class QTimer;
+
+namespace gpds
+{
+    class container;
+}
+
+namespace wire_system
+{
+    class net;
+}
+
+namespace QSchematic::Items
+{
+    class Item;
+    class WireNet;
+}
+
+namespace QSchematic
+{
+
+    class Scene;
+
+    /**
+     * Periodically saves a scene in the background.
+     *
+     * @details Saving happens in two steps:
+     *            1. On the GUI thread, an immutable snapshot of the scene is captured. The snapshot consists of the
+     *               serialized containers of all top-level items & nets. These containers are cached and shared
+     *               between snapshots. Only the items & nets that were added, removed or changed since the previous
+     *               snapshot are updated (see ChangeTracker). The others are not even visited.
+     *            2. On a worker thread, the snapshot is encoded (see ArchiverBinary), compressed and written
+     *               atomically.
+     *          Therefore, the time spent on the GUI thread is dominated by the number of changes rather than by the
+     *          size of the scene.
+     *
+     * @note The connectivity is not stored. It is reconstructed when loading (see load()).
+     */
+    class AutoSave :
+        public QObject
+    {
+        Q_OBJECT
+        Q_DISABLE_COPY_MOVE(AutoSave)
+
+    public:
+        static constexpr std::chrono::milliseconds default_interval{ 60'000 };
+        static constexpr int default_compression_level = 1;
+
+        /**
+         * Constructor.
+         *
+         * @param scene The scene.
+         * @param parent The parent object.
+         */
+        explicit
+        AutoSave(Scene* scene, QObject* parent = nullptr);
+
+        /**
+         * Destructor.
+         *
+         * @note This waits for a running save to finish.
+         */
+        ~AutoSave() override;
+
+        void
+        setFilePath(const QString& filePath);
+
+        [[nodiscard]]
+        QString
+        filePath() const;
+
+        void
+        setInterval(std::chrono::milliseconds interval);
+
+        [[nodiscard]]
+        std::chrono::milliseconds
+        interval() const;
+
+        /**
+         * Set the zlib compression level (see qCompress()).
+         */
+        void
+        setCompressionLevel(int level);
+
+        [[nodiscard]]
+        int
+        compressionLevel() const;
+
+        /**
+         * Start saving periodically.
+         */
+        void
+        start();
+
+        void
+        stop();
+
+        [[nodiscard]]
+        bool
+        isActive() const;
+
+        /**
+         * Save now.
+         *
+         * @details If a save is already running, another one is started once it finished.
+         *
+         * @note Nothing is saved if the scene did not change since the last save.
+         *
+         * @return Whether a save was started (or scheduled).
+         */
+        bool
+        save();
+
+        [[nodiscard]]
+        bool
+        isSaving() const;
+
+        /**
+         * Get the time the last save spent on the GUI thread capturing the snapshot.
+         */
+        [[nodiscard]]
+        std::chrono::microseconds
+        lastCaptureTime() const;
+
+        /**
+         * Load a scene saved by an AutoSave.
+         *
+         * @note Just like Scene::from_container(), this does not clear the scene first.
+         *
+         * @param scene The scene.
+         * @param filePath The file path.
+         * @return Success indicator & message.
+         */
+        [[nodiscard]]
+        static
+        std::pair<bool, std::string>
+        load(Scene& scene, const QString& filePath);
+
+    Q_SIGNALS:
+        /**
+         * Signal emitted after a save finished.
+         *
+         * @param success Success indicator.
+         * @param message The error message (if any).
+         */
+        void
+        saved(bool success, const QString& message);
+
+    private:
+        struct Snapshot;
+
+        using Containers = std::map<std::uint64_t, std::shared_ptr<const gpds::container>>;
+
+        struct ItemRecord
+        {
+            std::weak_ptr<Items::Item> item;
+            std::uint64_t order = 0;        // Key in m_items
+        };
+
+        struct NetRecord
+        {
+            std::weak_ptr<Items::WireNet> net;
+            std::uint64_t order = 0;        // Key in m_nets
+        };
+
+        QPointer<Scene> m_scene;
+        QString m_filePath;
+        QTimer* m_timer = nullptr;
+        int m_compressionLevel = default_compression_level;
+        ChangeTracker m_changes;
+        bool m_upToDate = false;
+        bool m_saving = false;
+        bool m_pending = false;
+        std::future<void> m_future;
+        std::chrono::microseconds m_captureTime{ 0 };
+        bool m_recordsValid = false;
+        std::uint64_t m_nextOrder = 0;
+        QHash<const Items::Item*, ItemRecord> m_itemRecords;
+        QHash<const wire_system::net*, NetRecord> m_netRecords;
+        Containers m_items;     // In the order the items were added
+        Containers m_nets;      // In the order the nets were added
+
+        [[nodiscard]]
+        std::shared_ptr<const Snapshot>
+        capture();
+
+        void
+        updateItem(const Items::Item* key, const std::shared_ptr<Items::Item>& item);
+
+        void
+        updateNet(const wire_system::net* key, const std::shared_ptr<wire_system::net>& net);
+
+        void
+        finished(bool success, const QString& message);
+
+        [[nodiscard]]
+        static
+        std::pair<bool, std::string>
+        write(const Snapshot& snapshot, const QString& filePath, int compressionLevel);
+    };
+
+}
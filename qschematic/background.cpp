@@ -1,6 +1,7 @@
 #include "background.hpp"
 
 #include <QPainter>
+#include <QPixmapCache>
 #include <QStyleOptionGraphicsItem>
 
 using namespace QSchematic;
@@ -57,14 +58,22 @@ Background::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWi
 
     // Draw the grid if supposed to
     if (m_settings.showGrid && (m_settings.gridSize > 0)) {
-        const qreal left = int(er.left()) - (int(er.left()) % m_settings.gridSize);
-        const qreal top = int(er.top()) - (int(er.top()) % m_settings.gridSize);
-
-        painter->setPen(m_grid_pen);
-        painter->setBrush(m_grid_brush);
-        for (qreal x = left; x < er.right(); x += m_settings.gridSize) {
-            for (qreal y = top; y < er.bottom(); y += m_settings.gridSize)
-                painter->drawPoint(x, y);
+        const qreal lod = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+        const qreal dpr = painter->device() ? painter->device()->devicePixelRatioF() : 1.0;
+
+        // Paint the pre-rendered grid cell as a brush. The brush transform maps one tile onto exactly one grid cell
+        // and moves the grid point (in the center of the tile) onto the grid.
+        const QPixmap tile = gridTile(lod, dpr);
+        if (!tile.isNull()) {
+            const qreal gridSize = m_settings.gridSize;
+            const qreal scale = gridSize / tile.width();
+
+            QBrush brush(tile);
+            brush.setTransform(QTransform::fromScale(scale, scale) * QTransform::fromTranslate(-gridSize / 2, -gridSize / 2));
+
+            painter->setPen(Qt::NoPen);
+            painter->setBrush(brush);
+            painter->drawRect(er);
         }
     }
 
@@ -77,3 +86,46 @@ Background::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWi
 
     painter->restore();
 }
+
+QPixmap
+Background::gridTile(const qreal lod, const qreal devicePixelRatio) const
+{
+    // Don't bother if the grid cells are too small to show individual points
+    const int tileSize = qRound(m_settings.gridSize * lod * devicePixelRatio);
+    if (tileSize < 3)
+        return { };
+
+    // Check the cache
+    // Note: The tile only depends on its size in device pixels and on the grid point appearance
+    const QString key = QStringLiteral("qschematic_grid_tile_%1_%2_%3_%4_%5_%6")
+        .arg(tileSize)
+        .arg(m_settings.gridSize)
+        .arg(m_settings.gridPointSize)
+        .arg(m_grid_pen.color().rgba())
+        .arg(static_cast<int>(m_grid_pen.capStyle()))
+        .arg(m_settings.antialiasing ? 1 : 0);
+    QPixmap tile;
+    if (QPixmapCache::find(key, &tile))
+        return tile;
+
+    tile = QPixmap(tileSize, tileSize);
+    tile.fill(Qt::transparent);
+
+    // Render the grid point in the center of the tile
+    const qreal logicalSize = tileSize;
+    const qreal scale = logicalSize / m_settings.gridSize;
+
+    QPen pen = m_grid_pen;
+    pen.setWidthF(m_settings.gridPointSize * scale);
+
+    QPainter painter(&tile);
+    painter.setRenderHint(QPainter::Antialiasing, m_settings.antialiasing);
+    painter.setPen(pen);
+    painter.setBrush(m_grid_brush);
+    painter.drawPoint(QPointF(logicalSize / 2, logicalSize / 2));
+    painter.end();
+
+    QPixmapCache::insert(key, tile);
+
+    return tile;
+}
@@ -5,6 +5,7 @@
 
 #include <QBrush>
 #include <QPen>
+#include <QPixmap>
 #include <QGraphicsRectItem>
 
 namespace QSchematic
@@ -68,6 +69,21 @@ namespace QSchematic
             return m_settings;
         }
 
+        /**
+         * Get the tile used to render the grid.
+         *
+         * @details The tile holds a single grid cell with the grid point in its center. It is rendered in device
+         *          pixels for the given level of detail. Tiles are kept in the global QPixmapCache. Therefore, all
+         *          views (and scenes) showing the grid at the same zoom level share the same tile.
+         *
+         * @param lod The level of detail (device pixels per scene unit).
+         * @param devicePixelRatio The device pixel ratio of the paint device.
+         * @return The tile. This is a null pixmap if the grid cells are too small to be rendered.
+         */
+        [[nodiscard]]
+        QPixmap
+        gridTile(qreal lod, qreal devicePixelRatio) const;
+
     private:
         Settings m_settings;
     };
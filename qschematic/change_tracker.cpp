@@ -0,0 +1,186 @@
+#include "change_tracker.hpp"
+#include "scene.hpp"
+#include "commands/base.hpp"
+#include "items/connector.hpp"
+#include "items/node.hpp"
+#include "items/wire.hpp"
+#include "wire_system/manager.hpp"
+#include "wire_system/net.hpp"
+
+#include <QUndoStack>
+
+#include <algorithm>
+#include <utility>
+
+using namespace QSchematic;
+
+ChangeTracker::ChangeTracker(Scene* scene, QObject* parent) :
+    QObject(parent),
+    m_scene(scene)
+{
+    if (!m_scene)
+        return;
+
+    m_undoIndex = m_scene->undoStack()->index();
+    connect(m_scene->undoStack(), &QUndoStack::indexChanged, this, &ChangeTracker::undoIndexChanged);
+
+    // Items added or removed without a command
+    // Note: Wires are left to the net notifications below.
+    const auto itemChanged = [this](const std::shared_ptr<Items::Item>& item) {
+        if (!std::dynamic_pointer_cast<Items::Wire>(item))
+            markDirty(item);
+    };
+    connect(m_scene, &Scene::itemAdded, this, itemChanged);
+    connect(m_scene, &Scene::itemRemoved, this, itemChanged);
+
+    // Nets created, merged, split or removed by the wire system
+    const auto wm = m_scene->wire_manager();
+    const auto netChanged = [this](wire_system::net* net) { markDirty(net); };
+    connect(wm.get(), &wire_system::manager::net_added, this, netChanged);
+    connect(wm.get(), &wire_system::manager::net_removed, this, netChanged);
+    connect(wm.get(), &wire_system::manager::net_wires_changed, this, netChanged);
+}
+
+ChangeTracker::~ChangeTracker() = default;
+
+QHash<const Items::Item*, std::weak_ptr<Items::Item>>
+ChangeTracker::takeItems()
+{
+    return std::exchange(m_items, { });
+}
+
+QHash<const wire_system::net*, std::weak_ptr<wire_system::net>>
+ChangeTracker::takeNets()
+{
+    return std::exchange(m_nets, { });
+}
+
+bool
+ChangeTracker::takeReset()
+{
+    return std::exchange(m_reset, false);
+}
+
+bool
+ChangeTracker::isEmpty() const
+{
+    return !m_reset && m_items.isEmpty() && m_nets.isEmpty();
+}
+
+std::size_t
+ChangeTracker::count() const
+{
+    return m_items.size() + m_nets.size();
+}
+
+void
+ChangeTracker::clear()
+{
+    m_reset = false;
+    m_items.clear();
+    m_nets.clear();
+}
+
+void
+ChangeTracker::undoIndexChanged(int index)
+{
+    const QUndoStack* stack = m_scene->undoStack();
+
+    // The stack got cleared (eg. the scene was cleared or loaded)
+    if (stack->count() == 0) {
+        m_reset = true;
+        m_items.clear();
+        m_nets.clear();
+    }
+
+    // A command got merged into the current one
+    else if (index == m_undoIndex) {
+        if (index > 0)
+            collect(stack->command(index - 1));
+    }
+
+    // Commands got pushed, undone or redone
+    else {
+        for (int i = std::min(index, m_undoIndex); i < std::max(index, m_undoIndex); i++)
+            collect(stack->command(i));
+    }
+
+    m_undoIndex = index;
+}
+
+void
+ChangeTracker::collect(const QUndoCommand* command)
+{
+    // Sanity check
+    if (!command)
+        return;
+
+    if (const auto base = dynamic_cast<const Commands::Base*>(command); base) {
+        const auto items = base->affectedItems();
+
+        // The command doesn't report what it changed
+        if (!items)
+            m_reset = true;
+
+        else {
+            for (const auto& item : *items)
+                markDirty(item);
+        }
+    }
+
+    // Foreign commands (other than plain containers of child commands such as macros) might have changed anything
+    else if (command->childCount() == 0)
+        m_reset = true;
+
+    for (int i = 0; i < command->childCount(); i++)
+        collect(command->child(i));
+}
+
+void
+ChangeTracker::markDirty(const std::shared_ptr<Items::Item>& item)
+{
+    // Sanity check
+    if (!item)
+        return;
+
+    const auto wm = m_scene->wire_manager();
+
+    // Wires are tracked as part of their net
+    if (auto wire = std::dynamic_pointer_cast<Items::Wire>(item); wire) {
+        markDirty(wire->net().get());
+
+        // Moving a wire point might also move the wires connected to it
+        for (const auto& connectedWire : wm->wires_connected_to(wire))
+            markDirty(connectedWire->net().get());
+
+        return;
+    }
+
+    // Child items (eg. labels) are tracked as part of their top-level item
+    QGraphicsItem* topLevel = item.get();
+    while (topLevel->parentItem())
+        topLevel = topLevel->parentItem();
+    if (topLevel != item.get()) {
+        if (auto topLevelItem = dynamic_cast<Items::Item*>(topLevel); topLevelItem)
+            markDirty(topLevelItem->sharedPtr());
+        return;
+    }
+
+    m_items.insert(item.get(), item);
+
+    // Moving a node also moves the wires attached to its connectors
+    if (auto node = std::dynamic_pointer_cast<Items::Node>(item); node) {
+        for (const auto& connector : node->connectors()) {
+            const auto record = wm->attached_wire(connector.get());
+            if (record && record->wire)
+                markDirty(record->wire->net().get());
+        }
+    }
+}
+
+void
+ChangeTracker::markDirty(wire_system::net* net)
+{
+    if (net)
+        m_nets.insert(net, net->weak_from_this());
+}
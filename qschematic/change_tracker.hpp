@@ -0,0 +1,115 @@
+#pragma once
+
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+
+#include <cstddef>
+#include <memory>
+
+class QUndoCommand;
+
+namespace wire_system
+{
+    class net;
+}
+
+namespace QSchematic::Items
+{
+    class Item;
+}
+
+namespace QSchematic
+{
+
+    class Scene;
+
+    /**
+     * Tracks the top-level items & nets of a scene which got changed through its undo stack.
+     *
+     * @details Pushing, undoing, redoing or merging a command marks the items it affects (see
+     *          Commands::Base::affectedItems()) as changed. Child items (eg. labels) are mapped to their top-level
+     *          item and wires are mapped to their net. Changing a node also marks the nets attached to its connectors.
+     *          Commands which don't report their affected items are treated like a reset (see takeReset()).
+     *          Items added to or removed from the scene directly and nets which the wire system adds, removes or
+     *          changes (eg. when merging or splitting nets) are marked as changed too.
+     */
+    class ChangeTracker :
+        public QObject
+    {
+        Q_OBJECT
+        Q_DISABLE_COPY_MOVE(ChangeTracker)
+
+    public:
+        /**
+         * Constructor.
+         *
+         * @param scene The scene.
+         * @param parent The parent object.
+         */
+        explicit
+        ChangeTracker(Scene* scene, QObject* parent = nullptr);
+
+        ~ChangeTracker() override;
+
+        /**
+         * Get & forget the changed top-level items.
+         *
+         * @note The items might have been removed from the scene (or even destroyed) since.
+         */
+        [[nodiscard]]
+        QHash<const Items::Item*, std::weak_ptr<Items::Item>>
+        takeItems();
+
+        /**
+         * Get & forget the changed nets.
+         *
+         * @note The nets might have been removed from the wire manager (or even destroyed) since.
+         */
+        [[nodiscard]]
+        QHash<const wire_system::net*, std::weak_ptr<wire_system::net>>
+        takeNets();
+
+        /**
+         * Get & forget whether the entire scene changed (ie. the undo stack got cleared or a command which doesn't
+         * report its affected items got pushed, undone or redone).
+         */
+        [[nodiscard]]
+        bool
+        takeReset();
+
+        [[nodiscard]]
+        bool
+        isEmpty() const;
+
+        /**
+         * Get the number of changed items & nets.
+         */
+        [[nodiscard]]
+        std::size_t
+        count() const;
+
+        void
+        clear();
+
+    private:
+        QPointer<Scene> m_scene;
+        int m_undoIndex = 0;
+        bool m_reset = false;
+        QHash<const Items::Item*, std::weak_ptr<Items::Item>> m_items;
+        QHash<const wire_system::net*, std::weak_ptr<wire_system::net>> m_nets;
+
+        void
+        undoIndexChanged(int index);
+
+        void
+        collect(const QUndoCommand* command);
+
+        void
+        markDirty(const std::shared_ptr<Items::Item>& item);
+
+        void
+        markDirty(wire_system::net* net);
+    };
+
+}
@@ -8,6 +8,12 @@ Base::Base(QUndoCommand* parent) :
 {
 }
 
+std::optional<QVector<std::shared_ptr<QSchematic::Items::Item>>>
+Base::affectedItems() const
+{
+    return std::nullopt;
+}
+
 void
 Base::connectDependencyDestroySignal(const QObject* dependency)
 {
@@ -1,6 +1,15 @@
 #pragma once
 
 #include <QUndoCommand>
+#include <QVector>
+
+#include <memory>
+#include <optional>
+
+namespace QSchematic::Items
+{
+    class Item;
+}
 
 namespace QSchematic::Commands
 {
@@ -15,6 +24,19 @@ namespace QSchematic::Commands
         virtual
         ~Base() = default;
 
+        /**
+         * Get the items whose state is changed by this command (in either direction).
+         *
+         * @note This does not include child commands.
+         *
+         * @return The items or nothing if unknown. The default implementation returns nothing so that consumers (see
+         *         ChangeTracker) treat commands which don't override this as if they changed the entire scene.
+         */
+        [[nodiscard]]
+        virtual
+        std::optional<QVector<std::shared_ptr<Items::Item>>>
+        affectedItems() const;
+
         /**
          * @brief Pure convenience — reduce boilerplate clutter.
          */
@@ -75,3 +75,9 @@ ItemAdd::redo()
     else
         _scene->addItem(_item);
 }
+
+std::optional<QVector<std::shared_ptr<Items::Item>>>
+ItemAdd::affectedItems() const
+{
+    return { _item };
+}
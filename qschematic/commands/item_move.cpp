@@ -73,3 +73,9 @@ ItemMove::simplifyWires() const
             wire->simplify();
     }
 }
+
+std::optional<QVector<std::shared_ptr<Items::Item>>>
+ItemMove::affectedItems() const
+{
+    return _items;
+}
@@ -31,6 +31,7 @@ namespace QSchematic::Commands
         bool mergeWith(const QUndoCommand* command) override;
         void undo() override;
         void redo() override;
+        std::optional<QVector<std::shared_ptr<Items::Item>>> affectedItems() const override;
 
     private:
         QVector<std::shared_ptr<Items::Item>> _items;
@@ -75,3 +75,9 @@ ItemRemove::redo()
     else
         _scene->removeItem(_item);
 }
+
+std::optional<QVector<std::shared_ptr<Items::Item>>>
+ItemRemove::affectedItems() const
+{
+    return { _item };
+}
@@ -52,3 +52,9 @@ ItemVisibility::redo()
 
     _item->setVisible(_newVisibility);
 }
+
+std::optional<QVector<std::shared_ptr<Items::Item>>>
+ItemVisibility::affectedItems() const
+{
+    return { _item };
+}
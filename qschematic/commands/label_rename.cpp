@@ -55,3 +55,12 @@ LabelRename::redo()
     _label->setText(_newText);
     _label->update();
 }
+
+std::optional<QVector<std::shared_ptr<Items::Item>>>
+LabelRename::affectedItems() const
+{
+    if (!_label)
+        return QVector<std::shared_ptr<Items::Item>>{ };
+
+    return { _label->sharedPtr() };
+}
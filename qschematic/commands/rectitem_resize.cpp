@@ -61,3 +61,12 @@ RectItemResize::redo()
     _item->setSize(_newSize);
     _item->setPos(_newPos);
 }
+
+std::optional<QVector<std::shared_ptr<Items::Item>>>
+RectItemResize::affectedItems() const
+{
+    if (!_item)
+        return QVector<std::shared_ptr<Items::Item>>{ };
+
+    return { _item->sharedPtr() };
+}
@@ -24,6 +24,7 @@ namespace QSchematic::Commands
         bool mergeWith(const QUndoCommand* command) override;
         void undo() override;
         void redo() override;
+        std::optional<QVector<std::shared_ptr<Items::Item>>> affectedItems() const override;
 
     private:
         QPointer<Items::RectItem> _item;
@@ -66,3 +66,12 @@ RectItemRotate::redo()
     if (_item->canSnapToGrid())
         _item->setPos(_item->itemChange(QGraphicsItem::ItemPositionChange, _item->pos()).toPointF());
 }
+
+std::optional<QVector<std::shared_ptr<Items::Item>>>
+RectItemRotate::affectedItems() const
+{
+    if (!_item)
+        return QVector<std::shared_ptr<Items::Item>>{ };
+
+    return { _item->sharedPtr() };
+}
@@ -54,3 +54,18 @@ WirenetRename::redo()
 
     _net->set_name(_newText);
 }
+
+std::optional<QVector<std::shared_ptr<Items::Item>>>
+WirenetRename::affectedItems() const
+{
+    QVector<std::shared_ptr<Items::Item>> ret;
+    if (!_net)
+        return ret;
+
+    for (const auto& wire : _net->wires()) {
+        if (auto item = std::dynamic_pointer_cast<Items::Wire>(wire))
+            ret.append(item);
+    }
+
+    return ret;
+}
@@ -92,3 +92,9 @@ WirepointMove::redo()
     // ToDo: The wire should probably do this internally
     wm->point_moved_by_user(*_wire, _new.pointIndex);
 }
+
+std::optional<QVector<std::shared_ptr<Items::Item>>>
+WirepointMove::affectedItems() const
+{
+    return { _wire };
+}
@@ -0,0 +1,751 @@
+#include "erc.hpp"
+#include "scene.hpp"
+#include "items/connector.hpp"
+#include "items/node.hpp"
+#include "items/wire.hpp"
+#include "wire_system/connectable.hpp"
+#include "wire_system/manager.hpp"
+#include "wire_system/net.hpp"
+#include "wire_system/wire.hpp"
+
+#include <QRectF>
+#include <QTimer>
+
+#include <algorithm>
+#include <functional>
+#include <optional>
+#include <unordered_map>
+
+using namespace QSchematic;
+
+namespace
+{
+    // Distance within which a wire end is considered to touch a wire segment
+    constexpr qreal touch_tolerance = 0.5;
+
+    void
+    hashCombine(std::size_t& seed, std::size_t value)
+    {
+        seed ^= value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+    }
+
+    [[nodiscard]]
+    bool
+    touches(const QPointF& point, const QPointF& a, const QPointF& b)
+    {
+        const QPointF ab = b - a;
+        const qreal lengthSquared = QPointF::dotProduct(ab, ab);
+        qreal t = 0;
+        if (lengthSquared > 0)
+            t = std::clamp(QPointF::dotProduct(point - a, ab) / lengthSquared, 0.0, 1.0);
+
+        const QPointF delta = point - (a + t * ab);
+
+        return QPointF::dotProduct(delta, delta) <= touch_tolerance * touch_tolerance;
+    }
+
+    void
+    unite(QRectF& bounds, bool& hasBounds, const QRectF& rect)
+    {
+        if (!hasBounds) {
+            bounds = rect;
+            hasBounds = true;
+            return;
+        }
+
+        bounds.setLeft(std::min(bounds.left(), rect.left()));
+        bounds.setRight(std::max(bounds.right(), rect.right()));
+        bounds.setTop(std::min(bounds.top(), rect.top()));
+        bounds.setBottom(std::max(bounds.bottom(), rect.bottom()));
+    }
+}
+
+/**
+ * Immutable record of a node.
+ */
+struct Erc::NodeRecord
+{
+    struct ConnectorRecord
+    {
+        std::weak_ptr<Items::Item> item;
+        const wire_system::connectable* connectable = nullptr;      // Only used as a key on the GUI thread
+        QPointF position;
+        const wire_system::wire* wire = nullptr;                    // The attached wire (if any)
+    };
+
+    std::vector<ConnectorRecord> connectors;
+};
+
+/**
+ * Immutable record of a (local) net.
+ */
+struct Erc::NetRecord
+{
+    struct WirePoint
+    {
+        QPointF position;
+        bool isJunction = false;
+        bool isAttached = false;
+    };
+
+    struct WireRecord
+    {
+        std::weak_ptr<Items::Item> item;
+        std::vector<WirePoint> points;
+    };
+
+    struct ConnectorRecord
+    {
+        std::weak_ptr<Items::Item> item;
+        QPointF position;
+    };
+
+    std::vector<WireRecord> wires;
+    std::vector<ConnectorRecord> connectors;
+    QRectF bounds;
+    bool hasBounds = false;
+};
+
+struct Erc::Snapshot
+{
+    /**
+     * A unit of work. This is either a global net or a node.
+     */
+    struct Unit
+    {
+        bool isNet = false;
+        QString name;
+        bool isNamed = false;
+        std::shared_ptr<const NodeRecord> node;
+        std::vector<std::shared_ptr<const NetRecord>> nets;
+        QRectF bounds;
+        bool hasBounds = false;
+    };
+
+    std::vector<Unit> units;
+    unsigned rules = 0;
+};
+
+struct Erc::Cache
+{
+    /**
+     * Everything a result depends on.
+     *
+     * @note Records are immutable and re-captured on change. Holding on to them guarantees that their addresses
+     *       are not re-used. Therefore, comparing the addresses is sufficient.
+     */
+    struct Key
+    {
+        std::size_t hash = 0;
+        std::vector<std::shared_ptr<const void>> records;
+        std::vector<std::pair<QString, bool>> names;
+
+        [[nodiscard]]
+        bool
+        operator==(const Key& rhs) const
+        {
+            return hash == rhs.hash && records == rhs.records && names == rhs.names;
+        }
+    };
+
+    struct KeyHash
+    {
+        [[nodiscard]]
+        std::size_t
+        operator()(const Key& key) const noexcept
+        {
+            return key.hash;
+        }
+    };
+
+    std::unordered_map<Key, std::vector<Violation>, KeyHash> results;
+    unsigned rules = 0;     // The rules the results were checked with
+};
+
+struct Erc::Result
+{
+    Cache cache;
+    std::vector<Violation> violations;
+    std::size_t checkedCount = 0;
+};
+
+Erc::Erc(Scene* scene, QObject* parent) :
+    QObject(parent),
+    m_scene(scene),
+    m_rules(ruleBit(Rule::SinglePinNet) | ruleBit(Rule::ShortedNets) | ruleBit(Rule::DanglingWireEnd)),
+    m_cache(std::make_shared<Cache>()),
+    m_changes(scene)
+{
+    // A single worker. Runs are serialized anyway.
+    m_pool.setMaxThreadCount(1);
+
+    // Coalesce changes
+    m_timer = new QTimer(this);
+    m_timer->setSingleShot(true);
+    m_timer->setInterval(250);
+    connect(m_timer, &QTimer::timeout, this, &Erc::start);
+
+    // Schedule a check whenever the connectivity possibly changed
+    if (m_scene) {
+        connect(m_scene, &Scene::netlistChanged, this, &Erc::schedule);
+        connect(m_scene, &Scene::itemAdded, this, [this](const std::shared_ptr<Items::Item>& item) {
+            markDirty(item);
+            schedule();
+        });
+        connect(m_scene, &Scene::itemRemoved, this, [this](const std::shared_ptr<Items::Item>& item) {
+            markDirty(item);
+            schedule();
+        });
+        connect(m_scene->wire_manager().get(), &wire_system::manager::connector_attachment_changed, this, &Erc::connectorAttachmentChanged);
+        connect(m_scene, &QObject::destroyed, this, [this] {
+            m_scene = nullptr;
+            m_timer->stop();
+        });
+    }
+}
+
+Erc::~Erc()
+{
+    // The worker posts its result to this object
+    m_pool.waitForDone();
+}
+
+void
+Erc::setEnabled(bool enabled)
+{
+    m_enabled = enabled;
+
+    if (m_enabled)
+        schedule();
+    else
+        m_timer->stop();
+}
+
+bool
+Erc::isEnabled() const
+{
+    return m_enabled;
+}
+
+void
+Erc::setRuleEnabled(Rule rule, bool enabled)
+{
+    const unsigned rules = enabled ? (m_rules | ruleBit(rule)) : (m_rules & ~ruleBit(rule));
+    if (rules == m_rules)
+        return;
+
+    // Note: Cached results are only re-used for the same set of rules
+    m_rules = rules;
+    schedule();
+}
+
+bool
+Erc::isRuleEnabled(Rule rule) const
+{
+    return m_rules & ruleBit(rule);
+}
+
+void
+Erc::setDelay(std::chrono::milliseconds delay)
+{
+    m_timer->setInterval(delay);
+}
+
+void
+Erc::run()
+{
+    m_timer->stop();
+    start();
+}
+
+void
+Erc::invalidate()
+{
+    m_invalid = true;
+    schedule();
+}
+
+bool
+Erc::isRunning() const
+{
+    return m_running;
+}
+
+const std::vector<Erc::Violation>&
+Erc::violations() const
+{
+    return m_violations;
+}
+
+void
+Erc::schedule()
+{
+    if (m_enabled && m_scene)
+        m_timer->start();
+}
+
+void
+Erc::start()
+{
+    // Sanity check
+    if (!m_scene)
+        return;
+
+    // Only one run at a time. Remember to re-run once the current one finished.
+    if (m_running) {
+        m_pending = true;
+        return;
+    }
+
+    auto snapshot = this->snapshot();
+    if (!snapshot)
+        return;
+
+    m_running = true;
+    m_pending = false;
+
+    m_pool.start([this, snapshot, cache = m_cache] {
+        auto result = check(*snapshot, *cache);
+
+        QMetaObject::invokeMethod(this, [this, result] {
+            finish(result);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void
+Erc::finish(const std::shared_ptr<Result>& result)
+{
+    m_running = false;
+
+    m_cache = std::make_shared<Cache>(std::move(result->cache));
+    m_violations = std::move(result->violations);
+
+    Q_EMIT finished(m_violations, result->checkedCount);
+
+    if (m_pending)
+        schedule();
+}
+
+void
+Erc::markDirty(const std::shared_ptr<Items::Item>& item)
+{
+    // Sanity check
+    if (!item)
+        return;
+
+    if (auto node = std::dynamic_pointer_cast<Items::Node>(item); node)
+        m_dirtyNodes.insert(node.get(), node);
+
+    else if (auto wire = std::dynamic_pointer_cast<Items::Wire>(item); wire) {
+        if (const auto net = wire->net(); net)
+            m_dirtyNets.insert(net.get());
+    }
+}
+
+void
+Erc::connectorAttachmentChanged(const wire_system::connectable* connectable)
+{
+    const auto connector = dynamic_cast<const Items::Connector*>(connectable);
+    if (!connector)
+        return;
+
+    const auto node = dynamic_cast<const Items::Node*>(connector->parentItem());
+    if (!node)
+        return;
+
+    // Note: The node might be in the process of being destroyed
+    m_dirtyNodes.insert(node, std::dynamic_pointer_cast<Items::Node>(std::const_pointer_cast<Items::Item>(node->weak_from_this().lock())));
+
+    schedule();
+}
+
+void
+Erc::updateNode(const Items::Node* key, const std::weak_ptr<Items::Node>& weakNode)
+{
+    // Forget the previous record
+    if (const auto it = m_nodes.find(key); it != std::end(m_nodes)) {
+        for (const auto& [wire, net] : it->attachments) {
+            if (const auto a = m_attachments.find(wire); a != std::end(m_attachments)) {
+                a->second.remove(key);
+                if (a->second.isEmpty())
+                    m_attachments.erase(a);
+            }
+
+            // The net lost a connector
+            m_dirtyNets.insert(net);
+        }
+
+        m_nodes.erase(it);
+    }
+
+    // Removed from the scene
+    const auto node = weakNode.lock();
+    if (!node || node->scene() != m_scene)
+        return;
+
+    const auto wm = m_scene->wire_manager();
+
+    NodeEntry entry;
+    auto record = std::make_shared<NodeRecord>();
+    for (const auto& connector : node->connectors()) {
+        NodeRecord::ConnectorRecord connectorRecord;
+        connectorRecord.item = connector;
+        connectorRecord.connectable = connector.get();
+        connectorRecord.position = connector->position();
+
+        if (const auto cr = wm->attached_wire(connector.get()); cr && cr->wire) {
+            const auto net = cr->wire->net();
+
+            connectorRecord.wire = cr->wire;
+            entry.attachments.emplace_back(cr->wire, net.get());
+            m_attachments[cr->wire].insert(key);
+
+            // The net gained (or moved) a connector
+            if (net)
+                m_dirtyNets.insert(net.get());
+        }
+
+        record->connectors.push_back(std::move(connectorRecord));
+    }
+    entry.record = std::move(record);
+
+    m_nodes.insert(key, std::move(entry));
+}
+
+std::shared_ptr<const Erc::NetRecord>
+Erc::captureNet(const wire_system::net& net) const
+{
+    const auto wm = m_scene->wire_manager();
+
+    auto record = std::make_shared<NetRecord>();
+    for (const auto& wire : net.wires()) {
+        // Sanity check
+        if (!wire)
+            continue;
+
+        // Connectors attached to this wire
+        std::vector<int> attachedPoints;
+        if (const auto a = m_attachments.find(wire.get()); a != std::cend(m_attachments)) {
+            for (const auto* nodeKey : a->second) {
+                const auto node = m_nodes.constFind(nodeKey);
+                if (node == std::cend(m_nodes))
+                    continue;
+
+                for (const auto& connector : node->record->connectors) {
+                    if (connector.wire != wire.get())
+                        continue;
+
+                    // Point indices shift when points get inserted or removed
+                    const auto cr = wm->attached_wire(connector.connectable);
+                    if (!cr || cr->wire != wire.get())
+                        continue;
+
+                    attachedPoints.push_back(cr->point_index);
+                    record->connectors.push_back({ connector.item, connector.position });
+                }
+            }
+        }
+
+        NetRecord::WireRecord wireRecord;
+        wireRecord.item = std::dynamic_pointer_cast<Items::Item>(wire);
+
+        const auto& points = wire->points();
+        wireRecord.points.reserve(points.size());
+        for (int i = 0; i < points.size(); i++) {
+            NetRecord::WirePoint point;
+            point.position = points[i].toPointF();
+            point.isJunction = points[i].is_junction();
+            point.isAttached = std::ranges::find(attachedPoints, i) != std::cend(attachedPoints);
+
+            unite(record->bounds, record->hasBounds, QRectF(point.position, point.position));
+
+            wireRecord.points.push_back(point);
+        }
+
+        record->wires.push_back(std::move(wireRecord));
+    }
+
+    return record;
+}
+
+std::shared_ptr<Erc::Snapshot>
+Erc::snapshot()
+{
+    auto wm = m_scene->wire_manager();
+    if (!wm)
+        return { };
+
+    // Start over (eg. the scene got cleared or loaded)
+    if (std::exchange(m_invalid, false) || m_changes.takeReset()) {
+        m_changes.clear();
+        m_nodes.clear();
+        m_nets.clear();
+        m_dirtyNodes.clear();
+        m_dirtyNets.clear();
+        m_attachments.clear();
+
+        for (const auto& node : m_scene->nodes()) {
+            if (node)
+                m_dirtyNodes.insert(node.get(), node);
+        }
+    }
+
+    // Changes made through the undo stack
+    const auto changedItems = m_changes.takeItems();
+    for (auto it = changedItems.cbegin(); it != changedItems.cend(); ++it)
+        markDirty(it.value().lock());
+    const auto changedNets = m_changes.takeNets();
+    for (auto it = changedNets.cbegin(); it != changedNets.cend(); ++it)
+        m_dirtyNets.insert(it.key());
+
+    // Nodes
+    // Note: This marks the nets attached to the nodes
+    const auto dirtyNodes = std::exchange(m_dirtyNodes, { });
+    for (auto it = dirtyNodes.cbegin(); it != dirtyNodes.cend(); ++it)
+        updateNode(it.key(), it.value());
+
+    auto s = std::make_shared<Snapshot>();
+    s->rules = m_rules;
+
+    // Nets
+    // Note: Nets are created, merged & split by the wire system rather than by commands. Therefore, nets with a
+    //       different number of wires are captured again too.
+    // Note: Grouping into global nets matches wire_system::manager::global_nets().
+    const auto nets = wm->nets();
+    QHash<const wire_system::net*, NetEntry> netEntries;
+    netEntries.reserve(std::ssize(nets));
+    std::unordered_map<wire_system::name_table::id_t, std::size_t> namedUnits;
+    std::size_t anonymousCounter = 1;
+    for (const auto& net : nets) {
+        // Sanity check
+        if (!net)
+            continue;
+
+        const std::size_t wireCount = std::size(net->wires());
+        NetEntry entry = m_nets.take(net.get());
+        if (!entry.record || entry.wireCount != wireCount || entry.net.lock() != net || m_dirtyNets.contains(net.get()))
+            entry = { net, wireCount, captureNet(*net) };
+
+        // Find or create the global net
+        const auto nameId = net->name_id();
+        std::size_t index = std::size(s->units);
+        if (nameId != wire_system::name_table::empty_id)
+            index = namedUnits.try_emplace(nameId, index).first->second;
+        if (index == std::size(s->units)) {
+            Snapshot::Unit unit;
+            unit.isNet = true;
+            unit.isNamed = nameId != wire_system::name_table::empty_id;
+            unit.name = unit.isNamed ? wm->names().name(nameId) : QString("N%1").arg(anonymousCounter++, 3, 10, QChar('0'));
+            s->units.push_back(std::move(unit));
+        }
+
+        auto& unit = s->units[index];
+        if (entry.record->hasBounds)
+            unite(unit.bounds, unit.hasBounds, entry.record->bounds);
+        unit.nets.push_back(entry.record);
+
+        netEntries.insert(net.get(), std::move(entry));
+    }
+    m_nets = std::move(netEntries);
+    m_dirtyNets.clear();
+
+    // Nodes
+    s->units.reserve(std::size(s->units) + m_nodes.size());
+    for (const auto& entry : std::as_const(m_nodes)) {
+        Snapshot::Unit unit;
+        unit.node = entry.record;
+        s->units.push_back(std::move(unit));
+    }
+
+    return s;
+}
+
+std::shared_ptr<Erc::Result>
+Erc::check(const Snapshot& snapshot, const Cache& cache)
+{
+    auto result = std::make_shared<Result>();
+    result->cache.rules = snapshot.rules;
+    const auto& units = snapshot.units;
+    const auto enabled = [&snapshot](Rule rule) {
+        return (snapshot.rules & ruleBit(rule)) != 0;
+    };
+
+    // Geometric neighbors of the named nets (only those can short). Sort & sweep along the x axis.
+    std::vector<std::vector<std::size_t>> neighbors(std::size(units));
+    {
+        const auto bounds = [&units](std::size_t i) {
+            return units[i].bounds.adjusted(-touch_tolerance, -touch_tolerance, touch_tolerance, touch_tolerance);
+        };
+
+        std::vector<std::size_t> order;
+        for (std::size_t i = 0; i < std::size(units); i++) {
+            if (units[i].isNet && units[i].isNamed && units[i].hasBounds)
+                order.push_back(i);
+        }
+        std::ranges::sort(order, { }, [&units](std::size_t i) { return units[i].bounds.left(); });
+
+        std::vector<std::size_t> active;
+        for (const std::size_t i : order) {
+            const QRectF rect = bounds(i);
+            std::erase_if(active, [&bounds, &rect](std::size_t j) { return bounds(j).right() < rect.left(); });
+
+            for (const std::size_t j : active) {
+                const QRectF other = bounds(j);
+                if (other.top() <= rect.bottom() && rect.top() <= other.bottom()) {
+                    neighbors[i].push_back(j);
+                    neighbors[j].push_back(i);
+                }
+            }
+
+            active.push_back(i);
+        }
+    }
+
+    for (std::size_t i = 0; i < std::size(units); i++) {
+        const auto& unit = units[i];
+
+        // Nodes are only subject to a single rule
+        if (!unit.isNet && !enabled(Rule::UnconnectedConnector))
+            continue;
+
+        // Only named neighbors with a greater name are checked for shorts (see below)
+        std::vector<std::size_t> shortCandidates;
+        if (unit.isNamed && enabled(Rule::ShortedNets)) {
+            for (const std::size_t n : neighbors[i]) {
+                if (units[n].name > unit.name)
+                    shortCandidates.push_back(n);
+            }
+            std::ranges::sort(shortCandidates, { }, [&units](std::size_t n) { return units[n].name; });
+        }
+
+        // Build the key of everything the result depends on
+        Cache::Key key;
+        const auto addToKey = [&key](const Snapshot::Unit& u) {
+            key.names.emplace_back(u.name, u.isNamed);
+            hashCombine(key.hash, qHash(u.name));
+
+            if (u.node) {
+                key.records.push_back(u.node);
+                hashCombine(key.hash, std::hash<const void*>{}(u.node.get()));
+            }
+            for (const auto& net : u.nets) {
+                key.records.push_back(net);
+                hashCombine(key.hash, std::hash<const void*>{}(net.get()));
+            }
+
+            // Separator
+            key.records.push_back(nullptr);
+        };
+        addToKey(unit);
+        for (const std::size_t n : shortCandidates)
+            addToKey(units[n]);
+
+        // Re-use previous result if nothing changed
+        if (const auto it = cache.results.find(key); cache.rules == snapshot.rules && it != std::cend(cache.results)) {
+            result->violations.insert(std::end(result->violations), std::cbegin(it->second), std::cend(it->second));
+            result->cache.results.try_emplace(std::move(key), it->second);
+            continue;
+        }
+
+        std::vector<Violation> violations;
+        result->checkedCount++;
+
+        // Node: Unconnected connectors (the rule is enabled, see above)
+        if (!unit.isNet) {
+            for (const auto& connector : unit.node->connectors) {
+                if (!connector.wire)
+                    violations.push_back({ Rule::UnconnectedConnector, { }, connector.position, { connector.item } });
+            }
+        }
+
+        // Net
+        else {
+            std::vector<const NetRecord::WireRecord*> wires;
+            std::vector<const NetRecord::ConnectorRecord*> connectors;
+            for (const auto& net : unit.nets) {
+                for (const auto& wire : net->wires)
+                    wires.push_back(&wire);
+                for (const auto& connector : net->connectors)
+                    connectors.push_back(&connector);
+            }
+
+            // Single pin nets
+            if (enabled(Rule::SinglePinNet) && std::size(connectors) == 1) {
+                const auto& connector = *connectors.front();
+                violations.push_back({ Rule::SinglePinNet, unit.name, connector.position, { connector.item } });
+            }
+
+            // Dangling wire ends
+            if (enabled(Rule::DanglingWireEnd)) {
+                // Junctions sorted by position. Another wire might end on a wire end.
+                const auto less = [](const QPointF& a, const QPointF& b) {
+                    return a.x() < b.x() || (a.x() == b.x() && a.y() < b.y());
+                };
+                std::vector<std::pair<QPointF, std::size_t>> junctions;
+                for (std::size_t w = 0; w < std::size(wires); w++) {
+                    for (const auto& p : wires[w]->points) {
+                        if (p.isJunction)
+                            junctions.emplace_back(p.position, w);
+                    }
+                }
+                std::ranges::sort(junctions, less, &std::pair<QPointF, std::size_t>::first);
+
+                for (std::size_t w = 0; w < std::size(wires); w++) {
+                    const auto& points = wires[w]->points;
+                    if (std::size(points) < 2)
+                        continue;
+
+                    for (const auto& end : { points.front(), points.back() }) {
+                        if (end.isAttached || end.isJunction)
+                            continue;
+
+                        const auto range = std::ranges::equal_range(junctions, end.position, less, &std::pair<QPointF, std::size_t>::first);
+                        const bool connected = std::ranges::any_of(range, [w](const auto& junction) { return junction.second != w; });
+                        if (!connected)
+                            violations.push_back({ Rule::DanglingWireEnd, unit.name, end.position, { wires[w]->item } });
+                    }
+                }
+            }
+
+            // Shorted named nets. Reported by the net with the lower name only.
+            for (const std::size_t n : shortCandidates) {
+                const auto& other = units[n];
+
+                // Check wire ends of either net against the wire segments of the other net
+                const auto findTouch = [](const Snapshot::Unit& a, const Snapshot::Unit& b) -> std::optional<Violation> {
+                    for (const auto& netA : a.nets) {
+                        for (const auto& wa : netA->wires) {
+                            if (wa.points.empty())
+                                continue;
+
+                            for (const auto& end : { wa.points.front(), wa.points.back() }) {
+                                for (const auto& netB : b.nets) {
+                                    for (const auto& wb : netB->wires) {
+                                        for (std::size_t s = 1; s < std::size(wb.points); s++) {
+                                            if (touches(end.position, wb.points[s-1].position, wb.points[s].position))
+                                                return Violation{ Rule::ShortedNets, a.name + QStringLiteral(", ") + b.name, end.position, { wa.item, wb.item } };
+                                        }
+                                    }
+                                }
+                            }
+                        }
+                    }
+
+                    return std::nullopt;
+                };
+
+                auto violation = findTouch(unit, other);
+                if (!violation)
+                    violation = findTouch(other, unit);
+                if (violation)
+                    violations.push_back(std::move(*violation));
+            }
+        }
+
+        result->violations.insert(std::end(result->violations), std::cbegin(violations), std::cend(violations));
+        result->cache.results.try_emplace(std::move(key), std::move(violations));
+    }
+
+    return result;
+}
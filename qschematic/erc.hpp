@@ -0,0 +1,238 @@
+#pragma once
+
+#include "change_tracker.hpp"
+
+#include <QHash>
+#include <QObject>
+#include <QPointF>
+#include <QSet>
+#include <QString>
+#include <QThreadPool>
+
+#include <chrono>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class QTimer;
+
+namespace wire_system
+{
+    class net;
+    class wire;
+    struct connectable;
+}
+
+namespace QSchematic
+{
+
+    namespace Items
+    {
+        class Item;
+        class Node;
+    }
+
+    class Scene;
+
+    /**
+     * Electrical rule check (ERC) engine.
+     *
+     * @details The connectivity of the scene is captured into a snapshot on the GUI thread. The rules are then checked
+     *          on a worker thread. Violations are reported via the finished() signal.
+     *          The snapshot is maintained incrementally: Each node & net is captured into an immutable record which is
+     *          only re-captured once the node or net changed (see ChangeTracker). Results of a previous run are
+     *          re-used for every global net (and node) whose records (and the records of its geometric neighbors)
+     *          did not change. Therefore, only the nets affected by an edit are re-captured and re-checked.
+     *
+     * @note Runs are scheduled automatically whenever the scene reports a possible netlist change. Subsequent
+     *       changes within the delay are coalesced into a single run.
+     *
+     * @note Nodes are only re-captured when they are changed through the undo stack, added or removed. Call
+     *       invalidate() after modifying nodes by other means.
+     */
+    class Erc :
+        public QObject
+    {
+        Q_OBJECT
+        Q_DISABLE_COPY_MOVE(Erc)
+
+    public:
+        enum class Rule
+        {
+            UnconnectedConnector,   // A connector without a wire. Disabled by default as most pins are optional.
+            SinglePinNet,           // A net connecting a single connector.
+            ShortedNets,            // A wire end of a named net touching a wire of another named net.
+            DanglingWireEnd,        // A wire end which is neither attached nor connected to another wire.
+        };
+        Q_ENUM(Rule)
+
+        struct Violation
+        {
+            Rule rule;
+            QString net;
+            QPointF position;
+            std::vector<std::weak_ptr<Items::Item>> items;
+        };
+
+        /**
+         * Constructor.
+         *
+         * @param scene The scene to check.
+         * @param parent The parent object.
+         */
+        explicit
+        Erc(Scene* scene, QObject* parent = nullptr);
+
+        /**
+         * Destructor.
+         *
+         * @note This waits for a currently running check to finish.
+         */
+        ~Erc() override;
+
+        /**
+         * Enable or disable automatic checks.
+         */
+        void
+        setEnabled(bool enabled);
+
+        [[nodiscard]]
+        bool
+        isEnabled() const;
+
+        /**
+         * Enable or disable a rule.
+         *
+         * @note All rules except Rule::UnconnectedConnector are enabled by default.
+         */
+        void
+        setRuleEnabled(Rule rule, bool enabled);
+
+        [[nodiscard]]
+        bool
+        isRuleEnabled(Rule rule) const;
+
+        /**
+         * Set the delay between a change and the start of the next check.
+         */
+        void
+        setDelay(std::chrono::milliseconds delay);
+
+        /**
+         * Schedule a check right away.
+         */
+        void
+        run();
+
+        /**
+         * Discard all captured records & results and schedule a check.
+         */
+        void
+        invalidate();
+
+        /**
+         * Whether a check is currently running on the worker thread.
+         */
+        [[nodiscard]]
+        bool
+        isRunning() const;
+
+        /**
+         * Get the violations found by the last check.
+         */
+        [[nodiscard]]
+        const std::vector<Violation>&
+        violations() const;
+
+    Q_SIGNALS:
+        /**
+         * Signal emitted after a check completed.
+         *
+         * @param violations The violations.
+         * @param checkedCount The number of nets & nodes that were actually re-checked.
+         */
+        void
+        finished(const std::vector<Violation>& violations, std::size_t checkedCount);
+
+    private:
+        struct Snapshot;
+        struct Cache;
+        struct Result;
+        struct NodeRecord;
+        struct NetRecord;
+
+        struct NodeEntry
+        {
+            std::shared_ptr<const NodeRecord> record;
+            std::vector<std::pair<const wire_system::wire*, const wire_system::net*>> attachments;    // Wires attached to the connectors
+        };
+
+        struct NetEntry
+        {
+            std::weak_ptr<wire_system::net> net;
+            std::size_t wireCount = 0;
+            std::shared_ptr<const NetRecord> record;
+        };
+
+        Scene* m_scene = nullptr;
+        QTimer* m_timer = nullptr;
+        QThreadPool m_pool;
+        bool m_enabled = true;
+        bool m_running = false;
+        bool m_pending = false;
+        unsigned m_rules;
+        std::shared_ptr<Cache> m_cache;
+        std::vector<Violation> m_violations;
+
+        // Incrementally maintained records
+        ChangeTracker m_changes;
+        bool m_invalid = true;
+        QHash<const Items::Node*, NodeEntry> m_nodes;
+        QHash<const wire_system::net*, NetEntry> m_nets;
+        QHash<const Items::Node*, std::weak_ptr<Items::Node>> m_dirtyNodes;
+        QSet<const wire_system::net*> m_dirtyNets;
+        std::unordered_map<const wire_system::wire*, QSet<const Items::Node*>> m_attachments;
+
+        void
+        schedule();
+
+        void
+        start();
+
+        void
+        finish(const std::shared_ptr<Result>& result);
+
+        void
+        markDirty(const std::shared_ptr<Items::Item>& item);
+
+        void
+        connectorAttachmentChanged(const wire_system::connectable* connector);
+
+        void
+        updateNode(const Items::Node* key, const std::weak_ptr<Items::Node>& node);
+
+        [[nodiscard]]
+        std::shared_ptr<const NetRecord>
+        captureNet(const wire_system::net& net) const;
+
+        [[nodiscard]]
+        std::shared_ptr<Snapshot>
+        snapshot();
+
+        [[nodiscard]]
+        static
+        constexpr
+        unsigned
+        ruleBit(Rule rule)
+        {
+            return 1u << static_cast<unsigned>(rule);
+        }
+
+        [[nodiscard]]
+        static
+        std::shared_ptr<Result>
+        check(const Snapshot& snapshot, const Cache& cache);
+    };
+
+}
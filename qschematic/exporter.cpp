@@ -0,0 +1,512 @@
+#include "exporter.hpp"
+#include "scene.hpp"
+
+#include <QDir>
+#include <QPageSize>
+#include <QPainter>
+#include <QPaintEngine>
+#include <QPdfWriter>
+#include <QThreadPool>
+#ifdef QSCHEMATIC_FEATURE_SVG
+    #include <QSvgGenerator>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace QSchematic;
+
+namespace
+{
+
+    /**
+     * Returns a brush which does not reference a QPixmap.
+     */
+    [[nodiscard]]
+    QBrush
+    imageBrush(const QBrush& brush)
+    {
+        if (brush.style() != Qt::TexturePattern)
+            return brush;
+
+        QBrush result(brush.textureImage());
+        result.setTransform(brush.transform());
+
+        return result;
+    }
+
+    [[nodiscard]]
+    QPen
+    imagePen(QPen pen)
+    {
+        if (pen.brush().style() == Qt::TexturePattern)
+            pen.setBrush(imageBrush(pen.brush()));
+
+        return pen;
+    }
+
+    /**
+     * Paint device recording painter commands for playback on another thread.
+     *
+     * @details Unlike QPicture, pixmaps (including the textures of brushes & pens) are converted to images while
+     *          recording. QPixmap must not be used outside the GUI thread.
+     */
+    class Recording :
+        public QPaintDevice
+    {
+    public:
+        using Command = std::function<void(QPainter&)>;
+
+        explicit
+        Recording(const QSize& size) :
+            m_size(size),
+            m_engine(std::make_unique<Engine>(m_commands))
+        {
+        }
+
+        Recording(const Recording&) = delete;
+        Recording(Recording&&) = delete;
+        ~Recording() override = default;
+
+        Recording& operator=(const Recording&) = delete;
+        Recording& operator=(Recording&&) = delete;
+
+        [[nodiscard]]
+        QPaintEngine*
+        paintEngine() const override
+        {
+            return m_engine.get();
+        }
+
+        /**
+         * Replay the recorded commands.
+         *
+         * @note This may be called from any thread.
+         */
+        void
+        play(QPainter& painter) const
+        {
+            for (const Command& command : m_commands)
+                command(painter);
+        }
+
+    protected:
+        [[nodiscard]]
+        int
+        metric(PaintDeviceMetric metric) const override
+        {
+            // Match the resolution of the images the recording gets played back on
+            static const QImage reference(1, 1, QImage::Format_ARGB32_Premultiplied);
+
+            switch (metric) {
+                case PdmWidth:
+                    return m_size.width();
+
+                case PdmHeight:
+                    return m_size.height();
+
+                case PdmWidthMM:
+                    return qRound(m_size.width() * 25.4 / reference.logicalDpiX());
+
+                case PdmHeightMM:
+                    return qRound(m_size.height() * 25.4 / reference.logicalDpiY());
+
+                case PdmNumColors:
+                    return std::numeric_limits<int>::max();
+
+                case PdmDepth:
+                    return 32;
+
+                case PdmDpiX:
+                case PdmPhysicalDpiX:
+                    return reference.logicalDpiX();
+
+                case PdmDpiY:
+                case PdmPhysicalDpiY:
+                    return reference.logicalDpiY();
+
+                case PdmDevicePixelRatio:
+                    return 1;
+
+                case PdmDevicePixelRatioScaled:
+                    return static_cast<int>(devicePixelRatioFScale());
+
+                default:
+                    return QPaintDevice::metric(metric);
+            }
+        }
+
+    private:
+        class Engine :
+            public QPaintEngine
+        {
+        public:
+            explicit
+            Engine(std::vector<Command>& commands) :
+                QPaintEngine(QPaintEngine::AllFeatures),
+                m_commands(commands)
+            {
+            }
+
+            bool
+            begin([[maybe_unused]] QPaintDevice* device) override
+            {
+                return true;
+            }
+
+            bool
+            end() override
+            {
+                return true;
+            }
+
+            [[nodiscard]]
+            Type
+            type() const override
+            {
+                return QPaintEngine::User;
+            }
+
+            // Same order as QPicture
+            void
+            updateState(const QPaintEngineState& state) override
+            {
+                const DirtyFlags flags = state.state();
+
+                if (flags & DirtyPen)
+                    record([pen = imagePen(state.pen())](QPainter& p) { p.setPen(pen); });
+                if (flags & DirtyBrush)
+                    record([brush = imageBrush(state.brush())](QPainter& p) { p.setBrush(brush); });
+                if (flags & DirtyBrushOrigin)
+                    record([origin = state.brushOrigin()](QPainter& p) { p.setBrushOrigin(origin); });
+                if (flags & DirtyFont)
+                    record([font = state.font()](QPainter& p) { p.setFont(font); });
+                if (flags & DirtyBackground)
+                    record([brush = imageBrush(state.backgroundBrush())](QPainter& p) { p.setBackground(brush); });
+                if (flags & DirtyBackgroundMode)
+                    record([mode = state.backgroundMode()](QPainter& p) { p.setBackgroundMode(mode); });
+                if (flags & DirtyTransform)
+                    record([transform = state.transform()](QPainter& p) { p.setTransform(transform); });
+                if (flags & DirtyClipEnabled)
+                    record([enabled = state.isClipEnabled()](QPainter& p) { p.setClipping(enabled); });
+                if (flags & DirtyClipRegion)
+                    record([region = state.clipRegion(), op = state.clipOperation()](QPainter& p) { p.setClipRegion(region, op); });
+                if (flags & DirtyClipPath)
+                    record([path = state.clipPath(), op = state.clipOperation()](QPainter& p) { p.setClipPath(path, op); });
+                if (flags & DirtyHints) {
+                    record([hints = state.renderHints()](QPainter& p) {
+                        p.setRenderHints(p.renderHints(), false);
+                        p.setRenderHints(hints);
+                    });
+                }
+                if (flags & DirtyCompositionMode)
+                    record([mode = state.compositionMode()](QPainter& p) { p.setCompositionMode(mode); });
+                if (flags & DirtyOpacity)
+                    record([opacity = state.opacity()](QPainter& p) { p.setOpacity(opacity); });
+            }
+
+            void
+            drawPath(const QPainterPath& path) override
+            {
+                record([path](QPainter& p) { p.drawPath(path); });
+            }
+
+            void
+            drawPolygon(const QPointF* points, int pointCount, PolygonDrawMode mode) override
+            {
+                record([polygon = QPolygonF(QList<QPointF>(points, points + pointCount)), mode](QPainter& p) {
+                    switch (mode) {
+                        case PolylineMode:
+                            p.drawPolyline(polygon);
+                            break;
+
+                        case OddEvenMode:
+                        case ConvexMode:
+                            p.drawPolygon(polygon, Qt::OddEvenFill);
+                            break;
+
+                        case WindingMode:
+                            p.drawPolygon(polygon, Qt::WindingFill);
+                            break;
+                    }
+                });
+            }
+
+            void
+            drawLines(const QLineF* lines, int lineCount) override
+            {
+                record([lines = QList<QLineF>(lines, lines + lineCount)](QPainter& p) { p.drawLines(lines); });
+            }
+
+            void
+            drawRects(const QRectF* rects, int rectCount) override
+            {
+                record([rects = QList<QRectF>(rects, rects + rectCount)](QPainter& p) { p.drawRects(rects); });
+            }
+
+            void
+            drawPoints(const QPointF* points, int pointCount) override
+            {
+                record([points = QList<QPointF>(points, points + pointCount)](QPainter& p) { p.drawPoints(points.constData(), points.size()); });
+            }
+
+            void
+            drawEllipse(const QRectF& rect) override
+            {
+                record([rect](QPainter& p) { p.drawEllipse(rect); });
+            }
+
+            void
+            drawTextItem(const QPointF& position, const QTextItem& textItem) override
+            {
+                record([position, text = textItem.text(), font = textItem.font()](QPainter& p) {
+                    const QFont previous = p.font();
+                    p.setFont(font);
+                    p.drawText(position, text);
+                    p.setFont(previous);
+                });
+            }
+
+            void
+            drawPixmap(const QRectF& rect, const QPixmap& pixmap, const QRectF& sourceRect) override
+            {
+                record([rect, image = pixmap.toImage(), sourceRect](QPainter& p) { p.drawImage(rect, image, sourceRect); });
+            }
+
+            void
+            drawTiledPixmap(const QRectF& rect, const QPixmap& pixmap, const QPointF& offset) override
+            {
+                record([rect, brush = QBrush(pixmap.toImage()), offset](QPainter& p) {
+                    const QPointF previous = p.brushOrigin();
+                    p.setBrushOrigin(rect.topLeft() - offset);
+                    p.fillRect(rect, brush);
+                    p.setBrushOrigin(previous);
+                });
+            }
+
+            void
+            drawImage(const QRectF& rect, const QImage& image, const QRectF& sourceRect, Qt::ImageConversionFlags flags) override
+            {
+                record([rect, image, sourceRect, flags](QPainter& p) { p.drawImage(rect, image, sourceRect, flags); });
+            }
+
+        private:
+            std::vector<Command>& m_commands;
+
+            void
+            record(Command&& command)
+            {
+                m_commands.push_back(std::move(command));
+            }
+        };
+
+        QSize m_size;
+        std::vector<Command> m_commands;
+        std::unique_ptr<Engine> m_engine;
+    };
+
+}
+
+bool
+Exporter::renderTiles(Scene& scene, const Options& options, const TileSink& sink)
+{
+    // Sanity check
+    if (!sink || options.scale <= 0 || options.tileSize <= 0)
+        return false;
+
+    const QRectF source = sourceRect(scene, options);
+    const QSize size = outputSize(scene, options);
+    if (size.isEmpty())
+        return false;
+
+    const int columns = (size.width() + options.tileSize - 1) / options.tileSize;
+    const int rows = (size.height() + options.tileSize - 1) / options.tileSize;
+
+    // Figure out how many threads we want to use
+    int threadCount = options.maxThreads;
+    if (threadCount <= 0)
+        threadCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    QThreadPool pool;
+    pool.setMaxThreadCount(std::min(threadCount, columns));
+
+    struct Tile
+    {
+        QRect target;
+        std::unique_ptr<Recording> recording;
+        QImage image;
+    };
+    std::vector<Tile> tiles(columns);
+
+    for (int row = 0; row < rows; row++) {
+        const QRect rowTarget = QRect(0, row * options.tileSize, size.width(), options.tileSize).intersected(QRect(QPoint(0, 0), size));
+
+        // Record each tile, in device pixels
+        // Note: The items can only be painted from the thread owning the scene. The recording on the other hand is
+        //       independent of the scene. Recording at the export scale ensures that the items pick their level of
+        //       detail (and the background its grid tile) for the actual output resolution. Limiting each recording
+        //       to the source rect of its tile lets the scene skip all items outside the tile.
+        for (int col = 0; col < columns; col++) {
+            Tile& tile = tiles[col];
+            tile.target = QRect(col * options.tileSize, rowTarget.y(), options.tileSize, rowTarget.height()).intersected(rowTarget);
+            tile.recording = std::make_unique<Recording>(tile.target.size());
+            tile.image = { };
+
+            const QRectF tileSource(
+                source.x() + tile.target.x() / options.scale,
+                source.y() + tile.target.y() / options.scale,
+                tile.target.width() / options.scale,
+                tile.target.height() / options.scale
+            );
+
+            QPainter painter(tile.recording.get());
+            painter.setRenderHint(QPainter::Antialiasing, options.antialiasing);
+            painter.setRenderHint(QPainter::TextAntialiasing, options.antialiasing);
+            scene.render(&painter, QRectF(QPointF(0, 0), tile.target.size()), tileSource, Qt::IgnoreAspectRatio);
+        }
+
+        // Rasterize concurrently
+        for (Tile& tile : tiles) {
+            pool.start([&tile, &options] {
+                tile.image = QImage(tile.target.size(), QImage::Format_ARGB32_Premultiplied);
+                tile.image.fill(options.background);
+
+                QPainter painter(&tile.image);
+                painter.setRenderHint(QPainter::Antialiasing, options.antialiasing);
+                painter.setRenderHint(QPainter::TextAntialiasing, options.antialiasing);
+                tile.recording->play(painter);
+            });
+        }
+        pool.waitForDone();
+
+        // Stream out
+        for (const Tile& tile : tiles)
+            sink(tile.target, tile.image);
+    }
+
+    return true;
+}
+
+bool
+Exporter::toPng(Scene& scene, const QString& filePath, const Options& options)
+{
+    const QSize size = outputSize(scene, options);
+    if (size.isEmpty())
+        return false;
+
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+    if (image.isNull())
+        return false;
+
+    // Assemble
+    const bool success = renderTiles(scene, options, [&image](const QRect& target, const QImage& tile) {
+        QPainter painter(&image);
+        painter.setCompositionMode(QPainter::CompositionMode_Source);
+        painter.drawImage(target.topLeft(), tile);
+    });
+    if (!success)
+        return false;
+
+    return image.save(filePath, "PNG");
+}
+
+bool
+Exporter::toPngTiles(Scene& scene, const QString& directory, const QString& baseName, const Options& options)
+{
+    const QDir dir(directory);
+    if (!dir.exists())
+        return false;
+
+    bool success = true;
+    const bool rendered = renderTiles(scene, options, [&](const QRect& target, const QImage& tile) {
+        const int row = target.y() / options.tileSize;
+        const int col = target.x() / options.tileSize;
+        const QString fileName = QStringLiteral("%1_%2_%3.png").arg(baseName).arg(row).arg(col);
+
+        if (!tile.save(dir.filePath(fileName), "PNG"))
+            success = false;
+    });
+
+    return rendered && success;
+}
+
+bool
+Exporter::toPdf(Scene& scene, const QString& filePath, const Options& options)
+{
+    const QRectF source = sourceRect(scene, options);
+    if (source.isEmpty())
+        return false;
+
+    // One scene unit maps to one point. The resolution follows the scale so that the items pick their level of
+    // detail (and the background its grid tile) for the scale.
+    const int resolution = std::max(72, qRound(72 * options.scale));
+    QPdfWriter writer(filePath);
+    writer.setResolution(resolution);
+    writer.setPageMargins(QMarginsF());
+    writer.setPageSize(QPageSize(source.size(), QPageSize::Point));
+
+    const QRectF target(QPointF(0, 0), source.size() * (resolution / 72.0));
+
+    QPainter painter;
+    if (!painter.begin(&writer))
+        return false;
+    painter.setRenderHint(QPainter::Antialiasing, options.antialiasing);
+    painter.fillRect(target, options.background);
+    scene.render(&painter, target, source, Qt::IgnoreAspectRatio);
+
+    return painter.end();
+}
+
+bool
+Exporter::toSvg(Scene& scene, const QString& filePath, const Options& options)
+{
+#ifdef QSCHEMATIC_FEATURE_SVG
+    const QRectF source = sourceRect(scene, options);
+    if (source.isEmpty())
+        return false;
+
+    QSvgGenerator generator;
+    generator.setFileName(filePath);
+    generator.setSize(source.size().toSize());
+    generator.setViewBox(QRectF(QPointF(0, 0), source.size()));
+
+    QPainter painter;
+    if (!painter.begin(&generator))
+        return false;
+    painter.setRenderHint(QPainter::Antialiasing, options.antialiasing);
+    painter.fillRect(QRectF(QPointF(0, 0), source.size()), options.background);
+    scene.render(&painter, QRectF(QPointF(0, 0), source.size()), source, Qt::IgnoreAspectRatio);
+
+    return painter.end();
+#else
+    Q_UNUSED(scene)
+    Q_UNUSED(filePath)
+    Q_UNUSED(options)
+
+    return false;
+#endif
+}
+
+QSize
+Exporter::outputSize(const Scene& scene, const Options& options)
+{
+    const QRectF source = sourceRect(scene, options);
+
+    return {
+        static_cast<int>(std::ceil(source.width() * options.scale)),
+        static_cast<int>(std::ceil(source.height() * options.scale))
+    };
+}
+
+QRectF
+Exporter::sourceRect(const Scene& scene, const Options& options)
+{
+    if (!options.sourceRect.isEmpty())
+        return options.sourceRect;
+
+    return scene.contentBounds();
+}
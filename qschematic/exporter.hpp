@@ -0,0 +1,123 @@
+#pragma once
+
+#include <QColor>
+#include <QImage>
+#include <QRect>
+#include <QRectF>
+#include <QSize>
+#include <QString>
+
+#include <functional>
+
+namespace QSchematic
+{
+
+    class Scene;
+
+    /**
+     * Options for the Exporter.
+     */
+    struct ExportOptions
+    {
+        QRectF sourceRect;                  // The scene rect to export. Empty to export the content bounds of the scene.
+        qreal scale = 1.0;                  // Raster: Device pixels per scene unit. PDF: Resolution (level of detail) only.
+        int tileSize = 1024;                // Raster only: Size of a tile in device pixels
+        int maxThreads = 0;                 // Raster only: The maximum number of threads. Zero uses the hardware concurrency.
+        QColor background = Qt::white;
+        bool antialiasing = true;
+    };
+
+    /**
+     * Export a scene to raster & vector formats.
+     *
+     * @details Raster exports split the output into tiles. Each tile of a row is recorded at the export scale on the
+     *          thread owning the scene. Pixmaps are converted to images while recording. The tiles of that row are then
+     *          rasterized concurrently onto per-thread QImages. Only one row of tiles is kept in memory at any time.
+     *          This allows exporting large sheets at high resolutions.
+     *          Vector exports render the scene directly. The scene only renders items intersecting the source rect.
+     *
+     * @note Only the rasterization runs concurrently. Recording is serial and each tile's QGraphicsScene::render()
+     *       looks up the items within that tile (a linear scan when the scene has no index). The speedup therefore
+     *       depends on the share of rasterization in the total export time.
+     *
+     * @note All functions must be called from the thread owning the scene.
+     */
+    class Exporter
+    {
+    public:
+        using Options = ExportOptions;
+
+        /**
+         * Callback receiving a rendered tile.
+         *
+         * @param target The tile rect in the output image (in device pixels).
+         * @param tile The tile.
+         */
+        using TileSink = std::function<void(const QRect& target, const QImage& tile)>;
+
+        /**
+         * Render a scene as tiles.
+         *
+         * @details The sink is called on the calling thread, in row-major order.
+         *
+         * @param scene The scene.
+         * @param options The options.
+         * @param sink The sink.
+         * @return Success indicator.
+         */
+        static
+        bool
+        renderTiles(Scene& scene, const Options& options, const TileSink& sink);
+
+        /**
+         * Export to a single PNG image.
+         *
+         * @note This needs to hold the entire image in memory. Use toPngTiles() for very large exports.
+         */
+        static
+        bool
+        toPng(Scene& scene, const QString& filePath, const Options& options = { });
+
+        /**
+         * Export to one PNG image per tile.
+         *
+         * @details The tiles are written as `<baseName>_<row>_<column>.png` into the specified directory.
+         */
+        static
+        bool
+        toPngTiles(Scene& scene, const QString& directory, const QString& baseName, const Options& options = { });
+
+        /**
+         * Export to a single page PDF.
+         */
+        static
+        bool
+        toPdf(Scene& scene, const QString& filePath, const Options& options = { });
+
+        /**
+         * Export to SVG.
+         *
+         * @note This is only available if QSchematic was built with Qt SVG. Returns false otherwise.
+         */
+        static
+        bool
+        toSvg(Scene& scene, const QString& filePath, const Options& options = { });
+
+        /**
+         * Get the size of the output in device pixels.
+         */
+        [[nodiscard]]
+        static
+        QSize
+        outputSize(const Scene& scene, const Options& options);
+
+    private:
+        Exporter() = default;
+
+        [[nodiscard]]
+        static
+        QRectF
+        sourceRect(const Scene& scene, const Options& options);
+    };
+
+}
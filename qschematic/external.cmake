@@ -35,3 +35,16 @@ find_package(
         Gui
         Widgets
 )
+
+# Qt SVG is optional (used for SVG export)
+find_package(
+    Qt6
+    QUIET
+    COMPONENTS
+        Svg
+)
+if (TARGET Qt::Svg)
+    set(QSCHEMATIC_FEATURE_SVG ON)
+else()
+    set(QSCHEMATIC_FEATURE_SVG OFF)
+endif()
@@ -35,7 +35,8 @@ void BezierWire::paint(QPainter* painter, const QStyleOptionGraphicsItem* option
     } else {
         penColor = COLOR;
     }
-    penLine.setWidth(LINE_WIDTH);
+    const bool hairline = renderAsHairline(*painter);
+    penLine.setWidth(hairline ? 0 : LINE_WIDTH);
     penLine.setColor(penColor);
 
     // Brush
@@ -48,6 +49,10 @@ void BezierWire::paint(QPainter* painter, const QStyleOptionGraphicsItem* option
 
     painter->drawPath(path());
 
+    // Junctions & handles are not rendered at low level of detail
+    if (hairline)
+        return;
+
     // Draw the junction poins
     QPen penJunction;
     penJunction.setStyle(Qt::NoPen);
@@ -57,12 +62,10 @@ void BezierWire::paint(QPainter* painter, const QStyleOptionGraphicsItem* option
     brushJunction.setColor(isHighlighted() ? COLOR_HIGHLIGHTED : COLOR);
 
     int junctionRadius = 4;
-    for (const point& wirePoint : wirePointsRelative()) {
-        if (wirePoint.is_junction()) {
-            painter->setPen(penJunction);
-            painter->setBrush(brushJunction);
-            painter->drawEllipse(wirePoint.toPoint(), junctionRadius, junctionRadius);
-        }
+    painter->setPen(penJunction);
+    painter->setBrush(brushJunction);
+    for (const QPointF& junction : cachedJunctions()) {
+        painter->drawEllipse(junction.toPoint(), junctionRadius, junctionRadius);
     }
 
     // Draw the handles (if selected)
@@ -80,7 +83,7 @@ void BezierWire::paint(QPainter* painter, const QStyleOptionGraphicsItem* option
         // Render
         painter->setPen(penHandle);
         painter->setBrush(brushHandle);
-        for (const point& point : wirePointsRelative()) {
+        for (const QPointF& point : cachedPolyline()) {
             QRectF handleRect(point.x() - HANDLE_SIZE, point.toPoint().y() - HANDLE_SIZE, 2*HANDLE_SIZE, 2*HANDLE_SIZE);
             painter->drawRect(handleRect);
         }
@@ -100,46 +103,58 @@ void BezierWire::paint(QPainter* painter, const QStyleOptionGraphicsItem* option
 
 QPainterPath BezierWire::path() const
 {
-    // Retrieve the scene points as we'll need them a lot
-    auto sceneWirePoints(wirePointsRelative());
-    QVector<point> scenePoints;
-    for (const auto& wirePoint : sceneWirePoints) {
-        scenePoints << wirePoint;
-    }
+    if (_pathCache)
+        return *_pathCache;
 
     // Nothing to do if there are no points
+    const auto& scenePoints = cachedPolyline();
     if (scenePoints.count() < 2) {
-        return { };
+        _pathCache = QPainterPath();
+        return *_pathCache;
     }
 
     QPainterPath path;
-    path.moveTo(scenePoints.at(0).toPointF());
+    path.moveTo(scenePoints.at(0));
 
     for (int i = 0; i < scenePoints.count()-1; i++) {
         // Retrieve points
-        const point p1 = scenePoints.at(i);
-        const point p2 = scenePoints.at(i+1);
+        const QPointF& p1 = scenePoints.at(i);
+        const QPointF& p2 = scenePoints.at(i+1);
 
         // Calculate control points
         qreal dx = (p2.x() - p1.x()) * CTRL_POINT_RATIO;
         QPointF control1(p1.x() + dx, p1.y());
         QPointF control2(p2.x() - dx, p2.y());
 
-        path.cubicTo(control1, control2, p2.toPointF());
+        path.cubicTo(control1, control2, p2);
     }
 
-    return path;
+    _pathCache = std::move(path);
+
+    return *_pathCache;
 }
 
 QPainterPath BezierWire::shape() const
 {
-    QPainterPathStroker stroker;
-    stroker.setWidth(10);
-    stroker.setCapStyle(Qt::RoundCap);
-    return stroker.createStroke(path());
+    if (!_shapeCache) {
+        QPainterPathStroker stroker;
+        stroker.setWidth(10);
+        stroker.setCapStyle(Qt::RoundCap);
+        _shapeCache = stroker.createStroke(path());
+    }
+
+    return *_shapeCache;
 }
 
 QRectF BezierWire::boundingRect() const
 {
     return shape().boundingRect();
 }
+
+void BezierWire::invalidateGeometryCache()
+{
+    Wire::invalidateGeometryCache();
+
+    _pathCache.reset();
+    _shapeCache.reset();
+}
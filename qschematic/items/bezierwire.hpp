@@ -21,6 +21,13 @@ namespace QSchematic::Items
         QPainterPath path() const;
         QPainterPath shape() const override;
         QRectF boundingRect() const override;
+
+    protected:
+        void invalidateGeometryCache() override;
+
+    private:
+        mutable std::optional<QPainterPath> _pathCache;
+        mutable std::optional<QPainterPath> _shapeCache;
     };
 
 }
@@ -7,6 +7,7 @@
 
 #include <QtMath>
 #include <QPainter>
+#include <QStyleOptionGraphicsItem>
 #include <QTransform>
 #include <QVector2D>
 #include <QGraphicsSceneHoverEvent>
@@ -32,6 +33,7 @@ Connector::Connector(int type, const QPoint& gridPoint, const QString& text, QGr
 
     // Flags
     setFlag(QGraphicsItem::ItemSendsGeometryChanges, true);
+    setCacheable(true);
 
     // Make sure that we are above the parent
     if (parentItem()) {
@@ -106,6 +108,12 @@ void Connector::copyAttributes(Connector& dest) const
     dest._textDirection = _textDirection;
 }
 
+void Connector::highlightAboutToChange([[maybe_unused]] bool highlighted)
+{
+    // The bounding rect includes the highlight padding while highlighted
+    prepareGeometryChange();
+}
+
 void Connector::setSnapPolicy(Connector::SnapPolicy policy)
 {
     _snapPolicy = policy;
@@ -270,6 +278,10 @@ void Connector::paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
         painter->drawRect(boundingRect());
     }
 
+    // Don't render the symbol at low level of detail
+    if (QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform()) < _settings.lodConnectorHidden)
+        return;
+
     // Body pen
     QPen bodyPen;
     bodyPen.setWidthF(PEN_WIDTH);
@@ -330,6 +342,7 @@ void Connector::alignLabel()
 
 void Connector::calculateSymbolRect()
 {
+    prepareGeometryChange();
     _symbolRect = QRectF(-SIZE*_settings.gridSize/2.0, -SIZE*_settings.gridSize/2.0, SIZE*_settings.gridSize, SIZE*_settings.gridSize);
 }
 
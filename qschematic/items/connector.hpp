@@ -60,6 +60,7 @@ namespace QSchematic::Items
 
     protected:
         void copyAttributes(Connector& dest) const;
+        void highlightAboutToChange(bool highlighted) override;
         QVariant itemChange(QGraphicsItem::GraphicsItemChange change, const QVariant& value) override;
 
     private:
@@ -224,6 +224,10 @@ void Item::setSettings(const Settings& settings)
     // Store the new settings
     _settings = settings;
 
+    // Re-apply the cache policy
+    if (_cacheable)
+        setCacheable(true);
+
     // Let everyone know
     Q_EMIT settingsChanged();
 
@@ -261,9 +265,37 @@ bool Item::isHighlighted() const
     return ( ( _highlighted || isSelected() ) && _highlightEnabled );
 }
 
+void Item::setCacheable(bool enabled)
+{
+    _cacheable = enabled;
+
+    if (!_cacheable) {
+        setCacheMode(QGraphicsItem::NoCache);
+        return;
+    }
+
+    switch (_settings.itemCache) {
+    case Settings::ItemCache::None:
+        setCacheMode(QGraphicsItem::NoCache);
+        break;
+
+    case Settings::ItemCache::ItemCoordinate:
+        setCacheMode(QGraphicsItem::ItemCoordinateCache);
+        break;
+
+    case Settings::ItemCache::DeviceCoordinate:
+        setCacheMode(QGraphicsItem::DeviceCoordinateCache);
+        break;
+    }
+}
+
 void Item::setHighlighted(bool highlighted)
 {
-    _highlighted = highlighted;
+    if (_highlighted != highlighted) {
+        highlightAboutToChange(highlighted);
+        _highlighted = highlighted;
+        highlightRepaint();
+    }
 
     // Ripple through children
     for (QGraphicsItem* child : childItems()) {
@@ -274,6 +306,29 @@ void Item::setHighlighted(bool highlighted)
     }
 }
 
+void Item::setHighlightedDeferred(bool highlighted)
+{
+    if (_highlighted != highlighted) {
+        highlightAboutToChange(highlighted);
+        _highlighted = highlighted;
+    }
+
+    // Ripple through children
+    for (QGraphicsItem* child : childItems()) {
+        if (Item* childItem = dynamic_cast<Item*>(child); childItem)
+            childItem->setHighlightedDeferred(highlighted);
+    }
+}
+
+void Item::highlightAboutToChange([[maybe_unused]] bool highlighted)
+{
+}
+
+void Item::highlightRepaint()
+{
+    QGraphicsItem::update();
+}
+
 void Item::setHighlightEnabled(bool enabled)
 {
     _highlightEnabled = enabled;
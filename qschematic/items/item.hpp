@@ -36,6 +36,7 @@ namespace QSchematic::Items
             LabelType,
             BezierWireType,
             BackgroundType,
+            WireLayerType,
 
             QSchematicItemUserType = QGraphicsItem::UserType + 100
         };
@@ -207,6 +208,15 @@ namespace QSchematic::Items
         void
         setHighlighted(bool isHighlighted);
 
+        /**
+         * Sets the highlight state of this item & its children without scheduling a repaint.
+         *
+         * @details Used to (un)highlight many items at once. The caller is responsible for repainting the affected
+         *          scene region (and for invalidating the wire layer, see WireLayer::invalidate()).
+         */
+        void
+        setHighlightedDeferred(bool isHighlighted);
+
         void
         setHighlightEnabled(bool enabled);
 
@@ -254,6 +264,30 @@ namespace QSchematic::Items
         bool
         isHighlighted() const;
 
+        /**
+         * Called right before the highlight state changes.
+         *
+         * @details Items whose bounding rect depends on the highlight state must prepare a geometry change here.
+         */
+        virtual
+        void
+        highlightAboutToChange(bool highlighted);
+
+        /**
+         * Called right after the highlight state changed to schedule a repaint.
+         *
+         * @note This is not called for deferred changes (see setHighlightedDeferred()).
+         */
+        virtual
+        void
+        highlightRepaint();
+
+        /**
+         * Whether the item uses the cache policy specified by Settings::itemCache.
+         */
+        void
+        setCacheable(bool enabled);
+
         QVariant
         itemChange(QGraphicsItem::GraphicsItemChange change, const QVariant& value) override;
 
@@ -267,6 +301,7 @@ namespace QSchematic::Items
         bool _snapToGrid;
         bool _highlightEnabled;
         bool _highlighted;
+        bool _cacheable = false;
         QPointF _oldPos;
         qreal _oldRot;
     };
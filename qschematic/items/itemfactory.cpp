@@ -8,6 +8,36 @@
 
 using namespace QSchematic::Items;
 
+Factory::PooledConstruction::PooledConstruction()
+{
+    Factory& factory = Factory::instance();
+    const std::scoped_lock lock(factory._poolMutex);
+    factory._poolUsers++;
+}
+
+Factory::PooledConstruction::~PooledConstruction()
+{
+    // Items allocated from the pool keep it alive
+    Factory& factory = Factory::instance();
+    const std::scoped_lock lock(factory._poolMutex);
+    if (--factory._poolUsers == 0) {
+        factory._pool.reset();
+        factory._poolSize = 0;
+    }
+}
+
+Factory::Factory()
+{
+    // Built-in types
+    // Note: Background & wire layer items are never serialized.
+    registerBuiltInType<Node>(Item::NodeType);
+    registerBuiltInType<Wire>(Item::WireType);
+    registerBuiltInType<WireRoundedCorners>(Item::WireRoundedCornersType);
+    registerBuiltInType<BezierWire>(Item::BezierWireType);
+    registerBuiltInType<Connector>(Item::ConnectorType);
+    registerBuiltInType<Label>(Item::LabelType);
+}
+
 Factory&
 Factory::instance()
 {
@@ -22,46 +52,69 @@ Factory::setCustomItemsFactory(const std::function<std::shared_ptr<Item>(const g
     _customItemFactory = factory;
 }
 
-std::shared_ptr<Item>
-Factory::from_container(const gpds::container& container) const
+void
+Factory::registerType(int typeId, Constructor constructor)
 {
-    // First, try custom types
-    if (_customItemFactory) {
-        if (auto item = _customItemFactory(container); item)
-            return item;
+    if (!constructor) {
+        unregisterType(typeId);
+        return;
     }
 
+    _registry[typeId] = std::move(constructor);
+}
+
+void
+Factory::unregisterType(int typeId)
+{
+    _registry.erase(typeId);
+}
+
+bool
+Factory::isRegistered(int typeId) const
+{
+    return _registry.contains(typeId) || _builtInTypes.contains(typeId);
+}
+
+std::shared_ptr<Item>
+Factory::from_container(const gpds::container& container) const
+{
     // Extract the type
     const auto type = Factory::extractType(container);
 
-    // Fall back to internal types
-    switch (type) {
-    case Item::NodeType:
-        return std::make_shared<Node>();
+    // Registered types
+    if (const auto it = _registry.find(type); it != std::cend(_registry))
+        return it->second();
 
-    case Item::WireType:
-        return std::make_shared<Wire>();
-
-    case Item::WireRoundedCornersType:
-        return std::make_shared<WireRoundedCorners>();
+    // Custom types
+    if (_customItemFactory) {
+        if (auto item = _customItemFactory(container); item)
+            return item;
+    }
 
-    case Item::BezierWireType:
-        return std::make_shared<BezierWire>();
+    // Built-in types
+    if (const auto it = _builtInTypes.find(type); it != std::cend(_builtInTypes))
+        return it->second();
 
-    case Item::ConnectorType:
-        return std::make_shared<Connector>();
+    return { };
+}
 
-    case Item::LabelType:
-        return std::make_shared<Label>();
+std::shared_ptr<std::pmr::memory_resource>
+Factory::pool(std::size_t size)
+{
+    const std::scoped_lock lock(_poolMutex);
 
-    case Item::BackgroundType:
+    // Pooled construction is not active
+    if (_poolUsers == 0)
         return { };
 
-    case Item::QSchematicItemUserType:
-        break;
+    // Start a new pool once the current one is full
+    if (!_pool || _poolSize + size > pool_capacity) {
+        _pool = std::make_shared<std::pmr::synchronized_pool_resource>();
+        _poolSize = 0;
     }
+    _poolSize += size;
 
-    return { };
+    return _pool;
 }
 
 Item::ItemType
@@ -2,8 +2,13 @@
 
 #include "item.hpp"
 
+#include <cstddef>
 #include <functional>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
 
 class QString;
 
@@ -15,14 +20,87 @@ namespace QSchematic::Items
     class Factory
     {
     public:
+        using Constructor = std::function<std::shared_ptr<Item>()>;
+
+        /**
+         * The number of bytes allocated from a pool before a new one is started.
+         */
+        static constexpr std::size_t pool_capacity = 256 * 1024;
+
+        /**
+         * Scope guard to construct the items from memory pools.
+         *
+         * @details While at least one guard is alive, the items constructed via registered types are allocated
+         *          from pools shared by all items constructed during that time. This is intended for bulk
+         *          construction (eg. while loading a scene). Guards may be used from multiple threads.
+         *
+         * @note A pool is only released once the last item allocated from it got destroyed. Each pool is limited to
+         *       pool_capacity bytes so that an item outliving the others retains at most that much memory.
+         */
+        class PooledConstruction
+        {
+        public:
+            PooledConstruction();
+            PooledConstruction(const PooledConstruction& other) = delete;
+            PooledConstruction(PooledConstruction&& other) = delete;
+            ~PooledConstruction();
+
+            PooledConstruction& operator=(const PooledConstruction& rhs) = delete;
+            PooledConstruction& operator=(PooledConstruction&& rhs) = delete;
+        };
+
         [[nodiscard]]
         static
         Factory&
         instance();
 
+        /**
+         * Set the custom factory.
+         *
+         * @note The custom factory is consulted after the registered types but before the built-in types.
+         */
         void
         setCustomItemsFactory(const std::function<std::shared_ptr<Item>(const gpds::container&)>& factory);
 
+        /**
+         * Register a constructor for a type ID.
+         *
+         * @note This replaces any previous registration of the same type ID and takes precedence over the built-in
+         *       types.
+         *
+         * @param typeId The type ID (see Item::type()).
+         * @param constructor The constructor.
+         */
+        void
+        registerType(int typeId, Constructor constructor);
+
+        /**
+         * Register a default constructible item type.
+         *
+         * @details Items of this type are constructed from the pool while pooled construction is active (see
+         *          PooledConstruction).
+         *
+         * @param typeId The type ID (see Item::type()).
+         */
+        template<typename T>
+        void
+        registerType(int typeId)
+        {
+            registerType(typeId, [this] { return make<T>(); });
+        }
+
+        /**
+         * Unregister a type ID.
+         *
+         * @note A built-in type replaced by the registration is used again.
+         */
+        void
+        unregisterType(int typeId);
+
+        [[nodiscard]]
+        bool
+        isRegistered(int typeId) const;
+
         [[nodiscard]]
         std::shared_ptr<Item>
         from_container(const gpds::container& container) const;
@@ -33,11 +111,90 @@ namespace QSchematic::Items
         extractType(const gpds::container& container);
 
     private:
-        Factory() = default;
-        Factory(const Factory& other) = default;
-        Factory(Factory&& other) = default;
+        /**
+         * Allocator which keeps the memory resource alive for as long as any allocation made through it.
+         */
+        template<typename T>
+        struct PoolAllocator
+        {
+            using value_type = T;
+
+            std::shared_ptr<std::pmr::memory_resource> resource;
+
+            explicit
+            PoolAllocator(std::shared_ptr<std::pmr::memory_resource> resource) :
+                resource(std::move(resource))
+            {
+            }
+
+            template<typename U>
+            PoolAllocator(const PoolAllocator<U>& other) :
+                resource(other.resource)
+            {
+            }
+
+            [[nodiscard]]
+            T*
+            allocate(std::size_t n)
+            {
+                return static_cast<T*>(resource->allocate(n * sizeof(T), alignof(T)));
+            }
+
+            void
+            deallocate(T* p, std::size_t n)
+            {
+                resource->deallocate(p, n * sizeof(T), alignof(T));
+            }
+
+            template<typename U>
+            bool
+            operator==(const PoolAllocator<U>& rhs) const
+            {
+                return resource == rhs.resource;
+            }
+        };
+
+        Factory();
+        Factory(const Factory& other) = delete;
+        Factory(Factory&& other) = delete;
 
         std::function<std::shared_ptr<Item>(const gpds::container&)> _customItemFactory;
+        std::unordered_map<int, Constructor> _registry;
+        std::unordered_map<int, Constructor> _builtInTypes;
+
+        // Pooled construction (guarded by _poolMutex)
+        std::mutex _poolMutex;
+        std::shared_ptr<std::pmr::memory_resource> _pool;
+        std::size_t _poolSize = 0;      // Bytes allocated from _pool
+        std::size_t _poolUsers = 0;
+
+        /**
+         * Get the pool to allocate an item from.
+         *
+         * @param size The size of the item.
+         * @return The pool or nullptr if pooled construction is not active.
+         */
+        [[nodiscard]]
+        std::shared_ptr<std::pmr::memory_resource>
+        pool(std::size_t size);
+
+        template<typename T>
+        [[nodiscard]]
+        std::shared_ptr<T>
+        make()
+        {
+            if (auto resource = pool(sizeof(T)); resource)
+                return std::allocate_shared<T>(PoolAllocator<T>(std::move(resource)));
+
+            return std::make_shared<T>();
+        }
+
+        template<typename T>
+        void
+        registerBuiltInType(int typeId)
+        {
+            _builtInTypes[typeId] = [this] { return make<T>(); };
+        }
     };
 
 }
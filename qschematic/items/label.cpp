@@ -3,6 +3,7 @@
 
 #include <QFontMetricsF>
 #include <QPainter>
+#include <QStyleOptionGraphicsItem>
 #include <QPen>
 #include <QBrush>
 
@@ -17,6 +18,7 @@ Label::Label(int type, QGraphicsItem* parent) :
     _hasConnectionPoint(true)
 {
     setSnapToGrid(false);
+    setCacheable(true);
 }
 
 gpds::container Label::to_container() const
@@ -75,6 +77,12 @@ void Label::copyAttributes(Label& dest) const
     dest._connectionPoint = _connectionPoint;
 }
 
+void Label::highlightAboutToChange([[maybe_unused]] bool highlighted)
+{
+    // The bounding rect includes the connection point while highlighted
+    prepareGeometryChange();
+}
+
 QRectF Label::boundingRect() const
 {
     QRectF rect = _textRect;
@@ -94,6 +102,7 @@ QPainterPath Label::shape() const
 void Label::setText(const QString& text)
 {
     _text = text;
+    internText();
     calculateTextRect();
     Q_EMIT textChanged(_text);
 }
@@ -117,6 +126,10 @@ bool Label::hasConnectionPoint() const
 
 void Label::setConnectionPoint(const QPointF& connectionPoint)
 {
+    // The bounding rect includes the connection point while highlighted
+    if (isHighlighted())
+        prepareGeometryChange();
+
     _connectionPoint = connectionPoint;
 
     Item::update();
@@ -124,11 +137,36 @@ void Label::setConnectionPoint(const QPointF& connectionPoint)
 
 void Label::calculateTextRect()
 {
+    prepareGeometryChange();
+
     QFontMetricsF fontMetrics(_font);
     _textRect = fontMetrics.boundingRect(_text);
     _textRect.adjust(-LABEL_TEXT_PADDING, -LABEL_TEXT_PADDING, LABEL_TEXT_PADDING, LABEL_TEXT_PADDING);
 }
 
+void Label::internText()
+{
+    // Labels in a scene share their text storage through the scene's name table
+    const auto s = scene();
+    if (!s)
+        return;
+
+    const auto wm = s->wire_manager();
+    if (!wm)
+        return;
+
+    auto& names = wm->names();
+    _text = names.name(names.intern(_text));
+}
+
+QVariant Label::itemChange(QGraphicsItem::GraphicsItemChange change, const QVariant& value)
+{
+    if (change == QGraphicsItem::ItemSceneHasChanged)
+        internText();
+
+    return Item::itemChange(change, value);
+}
+
 QString Label::text() const
 {
     return _text;
@@ -188,11 +226,14 @@ void Label::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWi
     textOption.setWrapMode(QTextOption::NoWrap);
     textOption.setAlignment(Qt::AlignHCenter | Qt::AlignVCenter);
 
-    // Draw the text
-    painter->setPen(COLOR_LABEL);
-    painter->setBrush(Qt::NoBrush);
-    painter->setFont(_font);
-    painter->drawText(_textRect, _text, textOption);
+    // Draw the text (unless it would be too small to be legible)
+    const qreal lod = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+    if ((_textRect.height() - 2*LABEL_TEXT_PADDING) * lod >= _settings.lodTextMinPixelSize) {
+        painter->setPen(COLOR_LABEL);
+        painter->setBrush(Qt::NoBrush);
+        painter->setFont(_font);
+        painter->drawText(_textRect, _text, textOption);
+    }
 
     // Draw the bounding rect if debug mode is enabled
     if (_settings.debug) {
@@ -41,11 +41,14 @@ namespace QSchematic::Items
 
     protected:
         void copyAttributes(Label& dest) const;
+        void highlightAboutToChange(bool highlighted) override;
         void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) override;
         void mouseDoubleClickEvent(QGraphicsSceneMouseEvent* event) override;
+        QVariant itemChange(QGraphicsItem::GraphicsItemChange change, const QVariant& value) override;
 
     private:
         void calculateTextRect();
+        void internText();
 
         QString _text;
         QFont _font;
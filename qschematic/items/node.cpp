@@ -6,6 +6,7 @@
 #include <QApplication>
 #include <QGraphicsSceneMouseEvent>
 #include <QPainter>
+#include <QStyleOptionGraphicsItem>
 #include <QtMath>
 
 const QColor COLOR_HIGHLIGHTED = QColor(Qt::blue);
@@ -24,6 +25,8 @@ Node::Node(int type, QGraphicsItem* parent) :
     _connectorsSnapPolicy(Connector::NodeSizerectOutline),
     _connectorsSnapToGrid(true)
 {
+    setCacheable(true);
+
     connect(this, &Node::settingsChanged, this, &Node::propagateSettings);
 }
 
@@ -295,6 +298,16 @@ void Node::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWid
         painter->drawRect(boundingRect());
     }
 
+    // Low level of detail: Plain rectangle
+    const qreal lod = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+    if (lod < _settings.lodNodeSimplified) {
+        QPen pen(COLOR_BODY_BORDER, 0);     // Cosmetic
+        painter->setPen(pen);
+        painter->setBrush(isHighlighted() ? COLOR_HIGHLIGHTED : COLOR_BODY_FILL);
+        painter->drawRect(sizeRect());
+        return;
+    }
+
     // Highlight rectangle
     if (isHighlighted()) {
         // Highlight pen
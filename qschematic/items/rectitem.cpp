@@ -80,6 +80,12 @@ void RectItem::copyAttributes(RectItem& dest) const
     dest._allowMouseRotate = _allowMouseRotate;
 }
 
+void RectItem::highlightAboutToChange([[maybe_unused]] bool highlighted)
+{
+    // The bounding rect includes the highlight padding while highlighted
+    prepareGeometryChange();
+}
+
 RectItem::Mode RectItem::mode() const
 {
     return _mode;
@@ -603,6 +609,11 @@ QVariant RectItem::itemChange(QGraphicsItem::GraphicsItemChange change, const QV
         return newPos;
     }
 
+    // The bounding rect includes the handles while selected
+    case QGraphicsItem::ItemSelectedChange:
+        prepareGeometryChange();
+        return Item::itemChange(change, value);
+
     default:
         return Item::itemChange(change, value);
     }
@@ -74,6 +74,7 @@ namespace QSchematic::Items
 
     protected:
         void copyAttributes(RectItem& dest) const;
+        void highlightAboutToChange(bool highlighted) override;
         QMap<RectanglePoint, QRectF> resizeHandles() const;
         QRectF rotationHandle() const;
         virtual void paintResizeHandles(QPainter& painter);
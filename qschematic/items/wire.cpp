@@ -3,12 +3,15 @@
 #include "label.hpp"
 #include "node.hpp"
 #include "../scene.hpp"
+#include "../serdes.hpp"
 #include "../utils.hpp"
+#include "../wire_layer.hpp"
 #include "../commands/wirepoint_move.hpp"
 
 #include <QPen>
 #include <QBrush>
 #include <QPainter>
+#include <QStyleOptionGraphicsItem>
 #include <QMap>
 #include <QGraphicsSceneHoverEvent>
 #include <QApplication>
@@ -42,6 +45,9 @@ Wire::Wire(int type, QGraphicsItem* parent) :
 
 Wire::~Wire()
 {
+    if (auto s = scene(); s && s->wireLayer())
+        s->wireLayer()->remove(*this);
+
     if (auto wire_net = std::dynamic_pointer_cast<WireNet>(net())) {
         // Make sure that we don't delete the net's label
         if (childItems().contains(wire_net->label().get())) {
@@ -57,13 +63,11 @@ gpds::container Wire::to_container() const
     rootContainer.add_value("item", Item::to_container());
 
     // Points
-    for (int i = 0; i < points_count(); i++) {
-        gpds::container pointContainer;
-        pointContainer.add_attribute("index", i);
-        pointContainer.add_value("x", m_points.at(i).x());
-        pointContainer.add_value("y", m_points.at(i).y());
-        rootContainer.add_value("point", pointContainer);
-    }
+    QVector<QPointF> points;
+    points.reserve(m_points.size());
+    for (const auto& point : m_points)
+        points.append(point.toPointF());
+    rootContainer.add_value("points", Serdes::packPoints(points));
 
     return rootContainer;
 }
@@ -74,6 +78,18 @@ void Wire::from_container(const gpds::container& container)
     Item::from_container(*container.get_value<gpds::container*>("item").value());
 
     // Points
+    if (const auto packed = container.get_value<std::string>("points"); packed) {
+        const auto points = Serdes::unpackPoints(*packed);
+        if (!points)
+            qCritical("Wire::from_container(): Malformed points.");
+        for (const QPointF& p : points.value_or(QVector<QPointF>{ }))
+            m_points.append(point(p));
+
+        update();
+        return;
+    }
+
+    // Points (serdes version 2)
     auto points = container.get_values<gpds::container*>("point");
     // Sort points by index
     std::sort(points.begin(), points.end(), [](gpds::container* a, gpds::container* b) {
@@ -112,6 +128,14 @@ void Wire::copyAttributes(Wire& dest) const
     dest._prevMousePos = _prevMousePos;
 }
 
+void Wire::highlightRepaint()
+{
+    // Highlighted wires are not painted by the wire layer
+    updateWireLayer();
+
+    Item::highlightRepaint();
+}
+
 void Wire::update()
 {
     calculateBoundingRect();
@@ -126,17 +150,66 @@ QRectF Wire::boundingRect() const
 
 QPainterPath Wire::shape() const
 {
-    QPainterPath basePath;
-    basePath.addPolygon(QPolygonF(pointsRelative()));
+    const auto& cache = geometryCache();
+    if (!cache.shape) {
+        QPainterPath basePath;
+        basePath.addPolygon(QPolygonF(cache.polyline));
 
-    QPainterPathStroker str;
-    str.setCapStyle(Qt::FlatCap);
-    str.setJoinStyle(Qt::MiterJoin);
-    str.setWidth(WIRE_SHAPE_PADDING);
+        QPainterPathStroker str;
+        str.setCapStyle(Qt::FlatCap);
+        str.setJoinStyle(Qt::MiterJoin);
+        str.setWidth(WIRE_SHAPE_PADDING);
 
-    QPainterPath resultPath = str.createStroke(basePath).simplified();
+        _geometryCache.shape = str.createStroke(basePath).simplified();
+    }
 
-    return resultPath;
+    return *_geometryCache.shape;
+}
+
+void Wire::invalidateGeometryCache()
+{
+    _geometryCache.valid = false;
+    _geometryCache.shape.reset();
+
+    updateWireLayer();
+}
+
+void Wire::updateWireLayer()
+{
+    if (auto s = scene(); s && s->wireLayer())
+        s->wireLayer()->invalidate(*this);
+}
+
+const Wire::GeometryCache& Wire::geometryCache() const
+{
+    if (_geometryCache.valid)
+        return _geometryCache;
+
+    const QPointF origin = pos();
+
+    _geometryCache.polyline.clear();
+    _geometryCache.polyline.reserve(m_points.count());
+    _geometryCache.junctions.clear();
+    for (const point& point : m_points) {
+        const QPointF relative = point.toPointF() - origin;
+        _geometryCache.polyline << relative;
+        if (point.is_junction())
+            _geometryCache.junctions << relative;
+    }
+    _geometryCache.shape.reset();
+    _geometryCache.valid = true;
+
+    return _geometryCache;
+}
+
+const QVector<QPointF>& Wire::cachedPolyline() const
+{
+    return geometryCache().polyline;
+}
+
+const QVector<QPointF>& Wire::cachedJunctions() const
+{
+    return geometryCache().junctions;
 }
 
 QVector<point> Wire::wirePointsRelative() const
@@ -176,28 +249,28 @@ QVector<QPointF> Wire::pointsAbsolute() const
 
 void Wire::calculateBoundingRect()
 {
-    // Find top-left most point
-    const int& intMaxValue = std::numeric_limits<int>::max();
-    QPointF topLeft(intMaxValue, intMaxValue);
-    for (auto& point : wirePointsRelative()) {
-        if (point.x() < topLeft.x())
-            topLeft.setX(point.x());
-        if (point.y() < topLeft.y())
-            topLeft.setY(point.y());
-    }
+    invalidateGeometryCache();
 
-    // Find bottom-right most point
-    const int& intMinValue = std::numeric_limits<int>::min();
-    QPointF bottomRight(intMinValue, intMinValue);
-    for (auto& point : wirePointsRelative()) {
-        if (point.x() > bottomRight.x())
-            bottomRight.setX(point.x());
-        if (point.y() > bottomRight.y())
-            bottomRight.setY(point.y());
+    // Find the top-left most and bottom-right most points
+    const QPointF origin = pos();
+    QPointF topLeft(std::numeric_limits<int>::max(), std::numeric_limits<int>::max());
+    QPointF bottomRight(std::numeric_limits<int>::min(), std::numeric_limits<int>::min());
+    for (const point& point : m_points) {
+        const QPointF relative = point.toPointF() - origin;
+        topLeft.setX(std::min(topLeft.x(), relative.x()));
+        topLeft.setY(std::min(topLeft.y(), relative.y()));
+        bottomRight.setX(std::max(bottomRight.x(), relative.x()));
+        bottomRight.setY(std::max(bottomRight.y(), relative.y()));
     }
 
     // Create the rectangle
-    _rect = QRectF(topLeft, bottomRight);
+    const QRectF rect(topLeft, bottomRight);
+    if (rect != _rect) {
+        prepareGeometryChange();
+        _rect = rect;
+
+        Q_EMIT boundingRectChanged(*this);
+    }
 }
 
 void Wire::setRenameAction(QAction* action)
@@ -248,9 +321,9 @@ void Wire::move_point_to(int index, const QPointF& moveTo)
 {
     prepareGeometryChange();
     wire_system::wire::move_point_to(index, moveTo);
+    calculateBoundingRect();
 
     Q_EMIT pointMoved(*this, wirePointsRelative()[index]);
-    calculateBoundingRect();
     update();
 }
 
@@ -452,59 +525,42 @@ void Wire::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWid
     Q_UNUSED(option);
     Q_UNUSED(widget);
 
+    // The wire layer takes care of this
+    if (isPaintedByWireLayer())
+        return;
+
     QPen penLine;
     penLine.setStyle(Qt::SolidLine);
     penLine.setCapStyle(Qt::RoundCap);
-    QColor penColor;
-    if (isSelected()) {
-        penColor = COLOR_SELECTED;
-    } else if (isHighlighted()) {
-        penColor = COLOR_HIGHLIGHTED;
-    } else {
-        penColor = COLOR;
-    }
-    penLine.setWidth(1);
-    penLine.setColor(penColor);
-
-    QBrush brushLine;
-    brushLine.setStyle(Qt::NoBrush);
-
-    QPen penJunction;
-    penJunction.setStyle(Qt::NoPen);
-
-    QBrush brushJunction;
-    brushJunction.setStyle(Qt::SolidPattern);
-    brushJunction.setColor(isHighlighted() ? COLOR_HIGHLIGHTED : COLOR);
-
-    QPen penHandle;
-    penHandle.setColor(Qt::black);
-    penHandle.setStyle(Qt::SolidLine);
-
-    QBrush brushHandle;
-    brushHandle.setColor(Qt::black);
-    brushHandle.setStyle(Qt::SolidPattern);
+    const bool hairline = renderAsHairline(*painter);
+    penLine.setWidth(hairline ? 0 : 1);
+    penLine.setColor(penColor());
 
     // Draw the actual line
     painter->setPen(penLine);
-    painter->setBrush(brushLine);
-    const auto& points = pointsRelative();
+    painter->setBrush(Qt::NoBrush);
+    const auto& points = cachedPolyline();
     painter->drawPolyline(points.constData(), points.count());
 
+    // Junctions & handles are not rendered at low level of detail
+    if (hairline)
+        return;
+
     // Draw the junction poins
-    int junctionRadius = 4;
-    for (const point& wirePoint : wirePointsRelative()) {
-        if (wirePoint.is_junction()) {
-            painter->setPen(penJunction);
-            painter->setBrush(brushJunction);
-            painter->drawEllipse(wirePoint.toPointF(), junctionRadius, junctionRadius);
-        }
+    const auto& junctions = cachedJunctions();
+    if (!junctions.isEmpty()) {
+        int junctionRadius = 4;
+        painter->setPen(Qt::NoPen);
+        painter->setBrush(isHighlighted() ? COLOR_HIGHLIGHTED : COLOR);
+        for (const QPointF& junction : junctions)
+            painter->drawEllipse(junction, junctionRadius, junctionRadius);
     }
 
     // Draw the handles (if selected)
     if (isSelected()) {
         painter->setOpacity(0.5);
-        painter->setPen(penHandle);
-        painter->setBrush(brushHandle);
+        painter->setPen(Qt::black);
+        painter->setBrush(Qt::black);
         for (const QPointF& point : points) {
             QRectF handleRect(point.x() - HANDLE_SIZE, point.y() - HANDLE_SIZE, 2*HANDLE_SIZE, 2*HANDLE_SIZE);
             painter->drawRect(handleRect);
@@ -523,6 +579,26 @@ void Wire::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWid
     }
 }
 
+bool Wire::isPaintedByWireLayer() const
+{
+    return _settings.batchedWireRendering && type() == Item::WireType && !isSelected() && !isHighlighted();
+}
+
+QColor Wire::penColor() const
+{
+    if (isSelected())
+        return COLOR_SELECTED;
+    if (isHighlighted())
+        return COLOR_HIGHLIGHTED;
+
+    return COLOR;
+}
+
+bool Wire::renderAsHairline(const QPainter& painter) const
+{
+    return QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter.worldTransform()) < _settings.lodWireHairline;
+}
+
 QVariant Wire::itemChange(QGraphicsItem::GraphicsItemChange change, const QVariant& value)
 {
     switch (change) {
@@ -538,6 +614,9 @@ QVariant Wire::itemChange(QGraphicsItem::GraphicsItemChange change, const QVaria
 
         case ItemPositionHasChanged:
         {
+            // The cached geometry is relative to the position
+            invalidateGeometryCache();
+
             // Sanity check
             if (!scene())
                 break;
@@ -582,9 +661,24 @@ QVariant Wire::itemChange(QGraphicsItem::GraphicsItemChange change, const QVaria
             else
                 setZValue(zValue() - 1);
 
+            updateWireLayer();
+            break;
+        }
+
+        case ItemSceneChange:
+        {
+            // Leaving the current scene
+            if (auto s = scene(); s && s->wireLayer())
+                s->wireLayer()->remove(*this);
+
             break;
         }
 
+        case ItemSceneHasChanged:
+        case ItemVisibleHasChanged:
+            updateWireLayer();
+            break;
+
         default:
             return Item::itemChange(change, value);
     }
@@ -707,6 +801,7 @@ bool Wire::movingWirePoint() const
 void Wire::about_to_change()
 {
     prepareGeometryChange();
+    invalidateGeometryCache();
 }
 
 void Wire::has_changed()
@@ -6,9 +6,18 @@
 #include "../wire_system/wire.hpp"
 
 #include <QAction>
+#include <QColor>
+#include <QPainterPath>
+
+#include <optional>
 
 class QVector2D;
 
+namespace QSchematic
+{
+    class WireLayer;
+}
+
 namespace QSchematic::Items
 {
 
@@ -21,6 +30,7 @@ namespace QSchematic::Items
         public wire_system::wire
     {
         Q_OBJECT
+        friend class QSchematic::WireLayer;
 
     public:
         Wire(int type = Item::WireType, QGraphicsItem* parent = nullptr);
@@ -44,15 +54,29 @@ namespace QSchematic::Items
         void move_point_to(int index, const QPointF& moveTo) override;
         bool movingWirePoint() const;
         void rename_net();
+        bool isPaintedByWireLayer() const;      // See Settings::batchedWireRendering
 
     Q_SIGNALS:
         void pointMoved(Wire& wire, point& point);
+        void boundingRectChanged(Wire& wire);       // Emitted by calculateBoundingRect() for any change of the points
         void toggleLabelRequested();
 
     protected:
         void copyAttributes(Wire& dest) const;
+        void highlightRepaint() override;
         void calculateBoundingRect();
         void setRenameAction(QAction* action);
+        bool renderAsHairline(const QPainter& painter) const;     // Low level of detail
+
+        /**
+         * Invalidates the cached geometry.
+         *
+         * @details This is called whenever the points or the position of the wire change. Subclasses caching
+         *          geometry of their own should re-implement this and call the base class implementation.
+         */
+        virtual void invalidateGeometryCache();
+        const QVector<QPointF>& cachedPolyline() const;     // Relative
+        const QVector<QPointF>& cachedJunctions() const;    // Relative
 
         void mousePressEvent(QGraphicsSceneMouseEvent* event) override;
         void mouseReleaseEvent(QGraphicsSceneMouseEvent* event) override;
@@ -73,7 +97,20 @@ namespace QSchematic::Items
 
         void label_to_cursor(const QPointF& scenePos, std::shared_ptr<Label>& label) const;
 
+        struct GeometryCache
+        {
+            bool valid = false;
+            QVector<QPointF> polyline;
+            QVector<QPointF> junctions;
+            std::optional<QPainterPath> shape;      // Built on first use
+        };
+
+        const GeometryCache& geometryCache() const;
+        QColor penColor() const;
+        void updateWireLayer();
+
         QRectF _rect;
+        mutable GeometryCache _geometryCache;
         int _pointToMoveIndex;
         int _lineSegmentToMoveIndex;
         QPointF _prevMousePos;
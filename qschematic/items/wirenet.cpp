@@ -4,6 +4,7 @@
 #include "label.hpp"
 #include "itemfactory.hpp"
 #include "../scene.hpp"
+#include "../wire_layer.hpp"
 #include "../utils.hpp"
 
 #include <QVector2D>
@@ -48,15 +49,27 @@ WireNet::to_container() const
             root.add_value("wire", wire_net->to_container());
     }
 
-    // The coordinates of the label need to be in the scene space
-    if (_label->parentItem())
-        _label->moveBy(QVector2D(_label->parentItem()->pos()));
-
-    root.add_value("label", _label->to_container());
+    // Label (hidden empty labels carry no information)
+    if (_label->isVisible() || !_label->text().isEmpty()) {
+        gpds::container label = _label->to_container();
+
+        // The coordinates of the label need to be in the scene space
+        // Note: The label is not moved temporarily to keep this free of side effects (see Scene::to_container()).
+        if (_label->parentItem()) {
+            const QPointF pos = _label->pos() + _label->parentItem()->pos();
+            for (auto& [key, value] : label.values) {
+                gpds::container* item = key == "item" ? value.get<gpds::container*>().value_or(nullptr) : nullptr;
+                if (!item)
+                    continue;
+
+                std::erase_if(item->values, [](const auto& pair) { return pair.first == "x" || pair.first == "y"; });
+                item->add_value("x", pos.x());
+                item->add_value("y", pos.y());
+            }
+        }
 
-    // Move the label back to the correct position
-    if (_label->parentItem())
-        _label->moveBy(-QVector2D(_label->parentItem()->pos()));
+        root.add_value("label", label);
+    }
 
     return root;
 }
@@ -144,39 +157,63 @@ WireNet::set_name(const QString& name)
 void
 WireNet::setHighlighted(bool highlighted)
 {
+    QVector<const Wire*> changedWires;
+    const QRectF dirtyRect = applyHighlight(highlighted, changedWires);
+
+    repaint(dirtyRect, changedWires);
+}
+
+QRectF
+WireNet::applyHighlight(bool highlighted, QVector<const Wire*>& changedWires)
+{
+    QRectF dirtyRect;
+
     // Wires
     for (auto& wire : wires()) {
-        if (!wire)
-            continue;
-
-        if (auto wire_item = std::dynamic_pointer_cast<Wire>(wire))
-            wire_item->setHighlighted(highlighted);
+        if (auto wire_item = std::dynamic_pointer_cast<Wire>(wire)) {
+            wire_item->setHighlightedDeferred(highlighted);
+            dirtyRect |= wire_item->sceneBoundingRect();
+            changedWires.append(wire_item.get());
+        }
     }
 
-    // Label
-    _label->setHighlighted(highlighted);
+    // Label (the bounding rect depends on the highlight state)
+    if (_label->isVisible())
+        dirtyRect |= _label->sceneBoundingRect();
+    _label->setHighlightedDeferred(highlighted);
+    if (_label->isVisible())
+        dirtyRect |= _label->sceneBoundingRect();
 
+    return dirtyRect;
+}
+
+void
+WireNet::repaint(const QRectF& dirtyRect, const QVector<const Wire*>& changedWires)
+{
+    // Sanity check
+    if (!_scene)
+        return;
+
+    // Highlighted wires are not painted by the wire layer
+    if (auto wireLayer = _scene->wireLayer(); wireLayer && !changedWires.isEmpty())
+        wireLayer->invalidate(changedWires);
+
+    if (!dirtyRect.isNull())
+        _scene->update(dirtyRect);
 }
 
-/**
- * Returns a list of all the nets that are in the same global net as the given net
- */
 QList<std::shared_ptr<WireNet>>
 WireNet::nets() const
 {
     QList<std::shared_ptr<WireNet>> list;
 
-    for (auto& net : manager()->nets()) {
-        if (!net)
-            continue;
-
-        if (net->name().isEmpty())
-            continue;
+    // Sanity check
+    if (!manager())
+        return list;
 
-        if (QString::compare(net->name(), name(), Qt::CaseSensitive) == 0) {
-            if (auto otherNet = std::dynamic_pointer_cast<WireNet>(net))
-                list.append(otherNet);
-        }
+    for (auto& net : manager()->nets_named(name_id())) {
+        if (auto otherNet = std::dynamic_pointer_cast<WireNet>(net))
+            list.append(otherNet);
     }
 
     return list;
@@ -186,15 +223,19 @@ void
 WireNet::highlight_global_net(bool highlighted)
 {
     // Highlight the net
-    setHighlighted(highlighted);
+    QVector<const Wire*> changedWires;
+    QRectF dirtyRect = applyHighlight(highlighted, changedWires);
 
     // Highlight all wire nets that are part of this net
     for (auto& otherWireNet : nets()) {
+        if (otherWireNet.get() == this)
+            continue;
 
-        otherWireNet->blockSignals(true);
-        otherWireNet->setHighlighted(highlighted);
-        otherWireNet->blockSignals(false);
+        dirtyRect |= otherWireNet->applyHighlight(highlighted, changedWires);
     }
+
+    // Repaint everything in one go
+    repaint(dirtyRect, changedWires);
 }
 
 void
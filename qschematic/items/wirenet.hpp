@@ -6,6 +6,8 @@
 #include <gpds/serialize.hpp>
 #include <QObject>
 #include <QList>
+#include <QRectF>
+#include <QVector>
 
 #include <memory>
 
@@ -96,6 +98,22 @@ namespace QSchematic::Items
 
         void
         highlight_global_net(bool highlighted);
+
+        /**
+         * Sets the highlight state without triggering a repaint.
+         *
+         * @param changedWires Appended with the wires whose highlight state got set.
+         * @return The scene rect which needs to be repainted.
+         */
+        QRectF
+        applyHighlight(bool highlighted, QVector<const Wire*>& changedWires);
+
+        /**
+         * Repaints the result of one or more applyHighlight() calls with a single wire layer invalidation and a
+         * single scene update.
+         */
+        void
+        repaint(const QRectF& dirtyRect, const QVector<const Wire*>& changedWires);
     };
 
 }
@@ -42,31 +42,20 @@ WireRoundedCorners::from_container(const gpds::container& container)
 void
 WireRoundedCorners::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
 {
-    Q_UNUSED(option);
-    Q_UNUSED(widget);
-
-    // Retrieve the scene points as we'll need them a lot
-    auto sceneWirePoints(wirePointsRelative());
-    QVector<point> scenePoints;
-    for (const auto& wirePoint : sceneWirePoints) {
-        scenePoints << wirePoint;
+    // The corners are not distinguishable at low level of detail
+    if (renderAsHairline(*painter)) {
+        Wire::paint(painter, option, widget);
+        return;
     }
 
     // Nothing to do if there are no points
-    if (scenePoints.count() < 2) {
+    const auto& points = cachedPolyline();
+    if (points.count() < 2) {
         return;
     }
 
-    QPen penJunction;
-    penJunction.setStyle(Qt::NoPen);
-
-    QBrush brushJunction;
-    brushJunction.setStyle(Qt::SolidPattern);
-    brushJunction.setColor(isHighlighted() ? COLOR_HIGHLIGHTED : COLOR);
-
     // Draw the actual line
     {
-        QPainterPath path;
         // Pen
         QPen penLine;
         penLine.setStyle(Qt::SolidLine);
@@ -82,107 +71,27 @@ WireRoundedCorners::paint(QPainter* painter, const QStyleOptionGraphicsItem* opt
         penLine.setWidth(LINE_WIDTH);
         penLine.setColor(penColor);
 
-        // Brush
-        QBrush brushLine;
-        brushLine.setStyle(Qt::NoBrush);
-
         // Prepare the painter
         painter->setPen(penLine);
-        painter->setBrush(brushLine);
+        painter->setBrush(Qt::NoBrush);
 
         // Render
-        for (int i = 0; i < scenePoints.count(); i++) {
-            // Retrieve point
-            point point = scenePoints.at(i);
-
-            // If it's the last point
-            if (i == scenePoints.count()-1) {
-                path.lineTo(point.toPointF());
-            }
-            // If it's the first point
-            else if (i == 0) {
-                wire_system::point nPoint = scenePoints.at(i + 1);
-                path.moveTo(point.toPointF());
-                path.lineTo(Utils::centerPoint(point.toPointF(), nPoint.toPointF()));
-            }
-            // It's a point in the middle of the wire
-            else {
-                // Get the previous and next points
-                wire_system::point pPoint = scenePoints.at(i - 1);
-                wire_system::point nPoint = scenePoints.at(i + 1);
-
-                // Find if there is a junction on this point
-                bool hasJunction = false;
-                for (const auto& wire: connected_wires()) {
-                    for (const auto& jIndex: wire->junctions()) {
-                        const auto& junction = wire->points().at(jIndex);
-                        if (junction.toPoint() == (point + pos()).toPoint()) {
-                            hasJunction = true;
-                            break;
-                        }
-                    }
-                    if (hasJunction) {
-                        break;
-                    }
-                }
-
-                // Lines form the current point up to half way to the next/previous point
-                QLineF line1(Utils::centerPoint(pPoint.toPoint(), point.toPoint()), point.toPoint());
-                QLineF line2(Utils::centerPoint(point.toPoint(), nPoint.toPoint()), point.toPoint());
-
-                int linePointAdjust = _settings.gridSize/2;
-                // If one of the lines is smaller that linePointAdjust make its length the new linePointAdjust
-                if (line1.length() < linePointAdjust) {
-                    linePointAdjust = line1.length();
-                }
-                if (line2.length() < linePointAdjust) {
-                    linePointAdjust = line2.length();
-                }
-                // We certainly don't want an arc if this is a junction
-                if (!hasJunction && !point.is_junction()) {
-                    // Shorten lines if there is a rounded corner
-                    line1.setLength(line1.length() - linePointAdjust);
-                    line2.setLength(line2.length() - linePointAdjust);
-                }
-
-                // Render lines
-                path.lineTo(line1.p2());
-                // Render the arc if there is no junction
-                if (!hasJunction && !point.is_junction()) {
-                    path.quadTo(point.toPointF(), line2.p2());
-                }
-                path.lineTo(line2.p2());
-            }
-        }
-        painter->drawPath(path);
+        painter->drawPath(roundedPath());
     }
 
     // Draw the junction points
     int junctionRadius = 4;
-    for (const wire_system::point& wirePoint : wirePointsRelative()) {
-        if (wirePoint.is_junction()) {
-            painter->setPen(penJunction);
-            painter->setBrush(brushJunction);
-            painter->drawEllipse(wirePoint.toPoint(), junctionRadius, junctionRadius);
-        }
+    painter->setPen(Qt::NoPen);
+    painter->setBrush(isHighlighted() ? COLOR_HIGHLIGHTED : COLOR);
+    for (const QPointF& junction : cachedJunctions()) {
+        painter->drawEllipse(junction.toPoint(), junctionRadius, junctionRadius);
     }
 
     // Draw the handles (if selected)
     if (isSelected()) {
-        // Pen
-        QPen penHandle;
-        penHandle.setColor(Qt::black);
-        penHandle.setStyle(Qt::SolidLine);
-
-        // Brush
-        QBrush brushHandle;
-        brushHandle.setColor(Qt::black);
-        brushHandle.setStyle(Qt::SolidPattern);
-
-        // Render
-        painter->setPen(penHandle);
-        painter->setBrush(brushHandle);
-        for (const point& point : scenePoints) {
+        painter->setPen(Qt::black);
+        painter->setBrush(Qt::black);
+        for (const QPointF& point : points) {
             QRectF handleRect(point.x() - HANDLE_SIZE, point.toPoint().y() - HANDLE_SIZE, 2*HANDLE_SIZE, 2*HANDLE_SIZE);
             painter->drawRect(handleRect);
         }
@@ -199,3 +108,89 @@ WireRoundedCorners::paint(QPainter* painter, const QStyleOptionGraphicsItem* opt
         painter->drawPath(shape());
     }
 }
+
+void
+WireRoundedCorners::invalidateGeometryCache()
+{
+    Wire::invalidateGeometryCache();
+
+    _pathCache.reset();
+}
+
+const QPainterPath&
+WireRoundedCorners::roundedPath()
+{
+    // Corners which coincide with a junction of a connected wire are not rounded. Therefore, the path also needs to
+    // be rebuilt if any of those junctions change.
+    QVector<QPoint> connectedJunctions;
+    for (const auto& wire : connected_wires()) {
+        for (const auto& jIndex : wire->junctions())
+            connectedJunctions << wire->points().at(jIndex).toPoint();
+    }
+
+    if (_pathCache && _pathCacheJunctions == connectedJunctions && _pathCacheGridSize == _settings.gridSize)
+        return *_pathCache;
+
+    _pathCacheJunctions = std::move(connectedJunctions);
+    _pathCacheGridSize = _settings.gridSize;
+
+    // Retrieve the scene points as we'll need them a lot
+    const auto scenePoints = wirePointsRelative();
+
+    QPainterPath path;
+    for (int i = 0; i < scenePoints.count(); i++) {
+        // Retrieve point
+        point point = scenePoints.at(i);
+
+        // If it's the last point
+        if (i == scenePoints.count()-1) {
+            path.lineTo(point.toPointF());
+        }
+        // If it's the first point
+        else if (i == 0) {
+            wire_system::point nPoint = scenePoints.at(i + 1);
+            path.moveTo(point.toPointF());
+            path.lineTo(Utils::centerPoint(point.toPointF(), nPoint.toPointF()));
+        }
+        // It's a point in the middle of the wire
+        else {
+            // Get the previous and next points
+            wire_system::point pPoint = scenePoints.at(i - 1);
+            wire_system::point nPoint = scenePoints.at(i + 1);
+
+            // Find if there is a junction on this point
+            const bool hasJunction = _pathCacheJunctions.contains((point + pos()).toPoint());
+
+            // Lines form the current point up to half way to the next/previous point
+            QLineF line1(Utils::centerPoint(pPoint.toPoint(), point.toPoint()), point.toPoint());
+            QLineF line2(Utils::centerPoint(point.toPoint(), nPoint.toPoint()), point.toPoint());
+
+            int linePointAdjust = _settings.gridSize/2;
+            // If one of the lines is smaller that linePointAdjust make its length the new linePointAdjust
+            if (line1.length() < linePointAdjust) {
+                linePointAdjust = line1.length();
+            }
+            if (line2.length() < linePointAdjust) {
+                linePointAdjust = line2.length();
+            }
+            // We certainly don't want an arc if this is a junction
+            if (!hasJunction && !point.is_junction()) {
+                // Shorten lines if there is a rounded corner
+                line1.setLength(line1.length() - linePointAdjust);
+                line2.setLength(line2.length() - linePointAdjust);
+            }
+
+            // Render lines
+            path.lineTo(line1.p2());
+            // Render the arc if there is no junction
+            if (!hasJunction && !point.is_junction()) {
+                path.quadTo(point.toPointF(), line2.p2());
+            }
+            path.lineTo(line2.p2());
+        }
+    }
+
+    _pathCache = std::move(path);
+
+    return *_pathCache;
+}
@@ -26,7 +26,19 @@ namespace QSchematic::Items
         void
         paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget = nullptr) override;
 
+    protected:
+        void
+        invalidateGeometryCache() override;
+
     private:
+        std::optional<QPainterPath> _pathCache;
+        QVector<QPoint> _pathCacheJunctions;    // Junctions of connected wires the cached path was built for
+        int _pathCacheGridSize = 0;
+
+        [[nodiscard]]
+        const QPainterPath&
+        roundedPath();
+
         enum QuarterCircleSegment {
             None,
             TopLeft,
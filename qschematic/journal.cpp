@@ -0,0 +1,410 @@
+#include "journal.hpp"
+#include "archiver_binary.hpp"
+#include "scene.hpp"
+#include "items/itemfactory.hpp"
+#include "items/wire.hpp"
+#include "items/wirenet.hpp"
+#include "wire_system/manager.hpp"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QSaveFile>
+
+#include <algorithm>
+#include <cstring>
+#include <optional>
+#include <sstream>
+
+using namespace QSchematic;
+
+namespace
+{
+
+    constexpr char MAGIC[4] = { 'Q', 'S', 'J', 'L' };
+    constexpr const char* GENERATION_ATTRIBUTE = "journal-generation";
+    constexpr const char* ITEM_ROOT = "item";
+    constexpr const char* NET_ROOT = "net";
+    constexpr QDataStream::Version STREAM_VERSION = QDataStream::Qt_6_0;
+
+    [[nodiscard]]
+    QString
+    snapshotPath(const QString& basePath)
+    {
+        return basePath + QStringLiteral(".qsb");
+    }
+
+    [[nodiscard]]
+    QString
+    journalPath(const QString& basePath)
+    {
+        return basePath + QStringLiteral(".journal");
+    }
+
+    [[nodiscard]]
+    std::optional<QByteArray>
+    encode(const gpds::container& container, const char* rootName)
+    {
+        std::ostringstream stream;
+        if (!QSchematic::ArchiverBinary().save(stream, container, rootName).first)
+            return std::nullopt;
+
+        const std::string data = stream.str();
+        return QByteArray(data.data(), static_cast<qsizetype>(data.size()));
+    }
+
+    [[nodiscard]]
+    bool
+    decode(const QByteArray& data, gpds::container& container, const char* rootName)
+    {
+        const std::string_view view(data.constData(), static_cast<std::size_t>(data.size()));
+        return QSchematic::ArchiverBinary().loadFromMemory(view, container, rootName).first;
+    }
+
+}
+
+Journal::Journal(Scene* scene, QObject* parent) :
+    QObject(parent),
+    m_scene(scene),
+    m_changes(scene)
+{
+}
+
+Journal::~Journal() = default;
+
+bool
+Journal::open(const QString& basePath)
+{
+    close();
+
+    m_basePath = basePath;
+    m_generation = static_cast<std::uint64_t>(QDateTime::currentMSecsSinceEpoch());
+    if (!snapshot()) {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void
+Journal::close()
+{
+    m_file.close();
+    m_basePath.clear();
+    m_itemIds.clear();
+    m_netIds.clear();
+    m_changes.clear();
+}
+
+bool
+Journal::isOpen() const
+{
+    return m_file.isOpen();
+}
+
+bool
+Journal::snapshot()
+{
+    // Sanity check
+    if (!m_scene || m_basePath.isEmpty())
+        return false;
+
+    // Write the snapshot
+    // Note: The journal is only replaced afterward. The generation makes sure that a journal which belongs to a
+    //       previous snapshot is never replayed on top of this one.
+    const std::uint64_t generation = m_generation + 1;
+    gpds::container container = m_scene->to_container();
+    container.add_attribute(GENERATION_ATTRIBUTE, std::to_string(generation));
+    const auto data = encode(container, Scene::gpds_name);
+    if (!data)
+        return false;
+
+    QSaveFile snapshotFile(snapshotPath(m_basePath));
+    if (!snapshotFile.open(QIODevice::WriteOnly))
+        return false;
+    if (snapshotFile.write(*data) != data->size() || !snapshotFile.commit())
+        return false;
+
+    // Start a new journal
+    m_file.close();
+    m_file.setFileName(journalPath(m_basePath));
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+
+    QDataStream stream(&m_file);
+    stream.setVersion(STREAM_VERSION);
+    stream.writeRawData(MAGIC, sizeof(MAGIC));
+    stream << quint16(format_version) << quint64(generation);
+    if (stream.status() != QDataStream::Ok || !m_file.flush()) {
+        m_file.close();
+        return false;
+    }
+
+    // Assign the IDs in the same order as Scene::to_container() writes the items & nets
+    m_itemIds.clear();
+    m_netIds.clear();
+    m_nextId = 0;
+    for (const auto& item : m_scene->items()) {
+        if (!item || std::dynamic_pointer_cast<Items::Wire>(item))
+            continue;
+
+        m_itemIds.insert(item.get(), { item, m_nextId++ });
+    }
+    for (const auto& net : m_scene->wire_manager()->nets()) {
+        auto wireNet = std::dynamic_pointer_cast<Items::WireNet>(net);
+        if (!wireNet)
+            continue;
+
+        m_netIds.insert(net.get(), { wireNet, m_nextId++ });
+    }
+
+    m_generation = generation;
+    m_snapshotSize = data->size();
+    m_changes.clear();
+
+    Q_EMIT compacted();
+
+    return true;
+}
+
+bool
+Journal::flush()
+{
+    // Sanity check
+    if (!m_scene || !isOpen())
+        return false;
+
+    // The entire scene changed
+    if (m_changes.takeReset())
+        return snapshot();
+
+    bool success = true;
+
+    // Items
+    const auto changedItems = m_changes.takeItems();
+    for (auto it = changedItems.cbegin(); it != changedItems.cend(); ++it) {
+        const auto item = it.value().lock();
+        const bool inScene = item && item->scene() == m_scene && !item->parentItem();
+
+        // Forget the previous item if it is gone (or if another item took over its address)
+        auto entry = m_itemIds.find(it.key());
+        if (entry != m_itemIds.end() && (!inScene || entry->item.lock() != item)) {
+            success &= append(RecordType::ItemRemove, entry->id);
+            m_itemIds.erase(entry);
+            entry = m_itemIds.end();
+        }
+        if (!inScene)
+            continue;
+
+        if (entry == m_itemIds.end())
+            entry = m_itemIds.insert(it.key(), { item, m_nextId++ });
+
+        const auto payload = encode(item->to_container(), ITEM_ROOT);
+        success &= payload.has_value() && append(RecordType::ItemUpsert, entry->id, *payload);
+    }
+
+    // Nets
+    const auto wm = m_scene->wire_manager();
+    const auto changedNets = m_changes.takeNets();
+    for (auto it = changedNets.cbegin(); it != changedNets.cend(); ++it) {
+        const auto net = std::dynamic_pointer_cast<Items::WireNet>(it.value().lock());
+        const bool inScene = net && wm->has_net(net.get());
+
+        // Forget the previous net if it is gone (or if another net took over its address)
+        auto entry = m_netIds.find(it.key());
+        if (entry != m_netIds.end() && (!inScene || entry->net.lock() != net)) {
+            success &= append(RecordType::NetRemove, entry->id);
+            m_netIds.erase(entry);
+            entry = m_netIds.end();
+        }
+        if (!inScene)
+            continue;
+
+        if (entry == m_netIds.end())
+            entry = m_netIds.insert(it.key(), { net, m_nextId++ });
+
+        const auto payload = encode(net->to_container(), NET_ROOT);
+        success &= payload.has_value() && append(RecordType::NetUpsert, entry->id, *payload);
+    }
+
+    success &= m_file.flush();
+
+    // Compact
+    if (success && m_file.size() > m_snapshotSize * m_compactionRatio)
+        return snapshot();
+
+    return success;
+}
+
+void
+Journal::setCompactionRatio(double ratio)
+{
+    m_compactionRatio = std::max(ratio, 0.0);
+}
+
+double
+Journal::compactionRatio() const
+{
+    return m_compactionRatio;
+}
+
+std::size_t
+Journal::pendingCount() const
+{
+    return m_changes.count();
+}
+
+std::pair<bool, std::string>
+Journal::recover(Scene& scene, const QString& basePath)
+{
+    // Snapshot
+    QFile snapshotFile(snapshotPath(basePath));
+    if (!snapshotFile.open(QIODevice::ReadOnly))
+        return { false, "could not open snapshot: " + snapshotFile.errorString().toStdString() };
+
+    const QByteArray data = snapshotFile.readAll();
+    gpds::container root;
+    if (const auto [success, message] = ArchiverBinary().loadFromMemory({ data.constData(), static_cast<std::size_t>(data.size()) }, root, Scene::gpds_name); !success)
+        return { false, "could not load snapshot: " + message };
+
+    const std::size_t version = root.get_attribute<std::size_t>("version").value_or(-1);
+    if (version < Scene::serdes_version_min || version > Scene::serdes_version)
+        return { false, "unsupported version" };
+
+    bool generationValid = false;
+    const std::uint64_t generation = QByteArray::fromStdString(root.get_attribute<std::string>(GENERATION_ATTRIBUTE).value_or("")).toULongLong(&generationValid);
+    if (!generationValid)
+        return { false, "snapshot has no journal generation" };
+
+    scene.clear();
+
+    // Allocate the items in bulk
+    const Items::Factory::PooledConstruction pooledConstruction;
+    const Scene::LoadingScope loadingScope(scene);
+
+    // Load the snapshot
+    // Note: The connectivity stored in the snapshot is ignored as the journal might change any of the items it
+    //       refers to. It gets reconstructed once the journal was replayed.
+    if (const gpds::container* sceneContainer = root.get_value<gpds::container*>("scene").value_or(nullptr); sceneContainer)
+        scene.loadSceneProperties(*sceneContainer);
+    for (const gpds::container* itemContainer : root.get_values<gpds::container*>("item")) {
+        if (itemContainer)
+            scene.loadItem(*itemContainer);
+    }
+    for (const gpds::container* netContainer : root.get_values<gpds::container*>("net")) {
+        if (netContainer)
+            scene.loadNet(*netContainer);
+    }
+
+    QHash<std::uint64_t, std::shared_ptr<Items::Item>> items;
+    QHash<std::uint64_t, std::shared_ptr<Items::WireNet>> nets;
+    for (std::size_t i = 0; i < std::size(scene._loadedItems); i++) {
+        if (scene._loadedItems[i])
+            items.insert(i, scene._loadedItems[i]);
+    }
+    for (std::size_t i = 0; i < std::size(scene._loadedNets); i++)
+        nets.insert(std::size(scene._loadedItems) + i, scene._loadedNets[i]);
+
+    // Replay the journal
+    QFile journalFile(journalPath(basePath));
+    if (journalFile.open(QIODevice::ReadOnly)) {
+        QDataStream stream(&journalFile);
+        stream.setVersion(STREAM_VERSION);
+
+        char magic[sizeof(MAGIC)] = { };
+        quint16 fileVersion = 0;
+        quint64 fileGeneration = 0;
+        stream.readRawData(magic, sizeof(magic));
+        stream >> fileVersion >> fileGeneration;
+
+        // A journal of another generation belongs to another snapshot
+        const bool valid =
+            stream.status() == QDataStream::Ok &&
+            std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0 &&
+            fileVersion == format_version &&
+            fileGeneration == generation;
+
+        while (valid && !stream.atEnd()) {
+            QByteArray record;
+            quint16 checksum = 0;
+            stream >> record >> checksum;
+
+            // Incomplete or corrupt record
+            if (stream.status() != QDataStream::Ok || qChecksum(record) != checksum)
+                break;
+
+            QDataStream recordStream(record);
+            recordStream.setVersion(STREAM_VERSION);
+            quint8 type = 0;
+            quint64 id = 0;
+            QByteArray payload;
+            recordStream >> type >> id >> payload;
+            if (recordStream.status() != QDataStream::Ok)
+                break;
+
+            switch (static_cast<RecordType>(type)) {
+                case RecordType::ItemUpsert:
+                case RecordType::ItemRemove: {
+                    gpds::container container;
+                    if (type == quint8(RecordType::ItemUpsert) && !decode(payload, container, ITEM_ROOT))
+                        break;
+
+                    if (auto item = items.take(id))
+                        scene.removeItem(item);
+
+                    if (type == quint8(RecordType::ItemUpsert)) {
+                        scene.loadItem(container);
+                        if (auto item = scene._loadedItems.back())
+                            items.insert(id, std::move(item));
+                    }
+                    continue;
+                }
+
+                case RecordType::NetUpsert:
+                case RecordType::NetRemove: {
+                    gpds::container container;
+                    if (type == quint8(RecordType::NetUpsert) && !decode(payload, container, NET_ROOT))
+                        break;
+
+                    if (auto net = nets.take(id)) {
+                        for (const auto& wire : net->wires()) {
+                            if (auto wireItem = std::dynamic_pointer_cast<Items::Wire>(wire))
+                                scene.removeWire(wireItem);
+                        }
+                    }
+
+                    if (type == quint8(RecordType::NetUpsert)) {
+                        scene.loadNet(container);
+                        nets.insert(id, scene._loadedNets.back());
+                    }
+                    continue;
+                }
+            }
+
+            // Unknown record type or undecodable payload
+            break;
+        }
+    }
+
+    // Reconstruct the connectivity
+    scene.finishLoading();
+
+    return { true, "" };
+}
+
+bool
+Journal::append(RecordType type, std::uint64_t id, const QByteArray& payload)
+{
+    QByteArray record;
+    {
+        QDataStream stream(&record, QIODevice::WriteOnly);
+        stream.setVersion(STREAM_VERSION);
+        stream << quint8(type) << quint64(id) << payload;
+    }
+
+    QDataStream stream(&m_file);
+    stream.setVersion(STREAM_VERSION);
+    stream << record << qChecksum(record);
+
+    return stream.status() == QDataStream::Ok;
+}
@@ -0,0 +1,185 @@
+#pragma once
+
+#include "change_tracker.hpp"
+
+#include <QFile>
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace wire_system
+{
+    class net;
+}
+
+namespace QSchematic::Items
+{
+    class Item;
+    class WireNet;
+}
+
+namespace QSchematic
+{
+
+    class Scene;
+
+    /**
+     * An append-only journal of the changes made to a scene.
+     *
+     * @details The journal consists of two files:
+     *            - `<basePath>.qsb`: A full snapshot of the scene (see ArchiverBinary).
+     *            - `<basePath>.journal`: The changes made since the snapshot was taken.
+     *          The changes made to the scene are tracked (see ChangeTracker). flush() then appends one record per
+     *          changed top-level item or net holding either its new (serialized) state or its removal. Therefore, the
+     *          cost of a flush only depends on the number of edits made since the last flush, not on the size of the
+     *          scene.
+     *          Once the journal grows too large relative to the snapshot, it is compacted into a new snapshot.
+     *
+     *          Each record carries a checksum. A record which was only partially written (eg. because the
+     *          application crashed) ends the replay in recover().
+     *
+     * @note Changes to existing items are only journaled when they are made through the undo stack.
+     */
+    class Journal :
+        public QObject
+    {
+        Q_OBJECT
+        Q_DISABLE_COPY_MOVE(Journal)
+
+    public:
+        static constexpr std::uint16_t format_version = 1;
+        static constexpr double default_compaction_ratio = 0.5;
+
+        /**
+         * Constructor.
+         *
+         * @param scene The scene.
+         * @param parent The parent object.
+         */
+        explicit
+        Journal(Scene* scene, QObject* parent = nullptr);
+
+        /**
+         * Destructor.
+         *
+         * @note This does not flush pending changes.
+         */
+        ~Journal() override;
+
+        /**
+         * Start journaling.
+         *
+         * @details This writes a new snapshot & starts a new journal.
+         *
+         * @param basePath The path of the files without extension.
+         * @return Success indicator.
+         */
+        bool
+        open(const QString& basePath);
+
+        void
+        close();
+
+        [[nodiscard]]
+        bool
+        isOpen() const;
+
+        /**
+         * Write a new snapshot & start a new (empty) journal.
+         *
+         * @return Success indicator.
+         */
+        bool
+        snapshot();
+
+        /**
+         * Append the pending changes to the journal.
+         *
+         * @details This compacts the journal if it exceeds the compaction ratio.
+         *
+         * @return Success indicator.
+         */
+        bool
+        flush();
+
+        /**
+         * Set the size of the journal relative to the size of the snapshot at which the journal is compacted.
+         */
+        void
+        setCompactionRatio(double ratio);
+
+        [[nodiscard]]
+        double
+        compactionRatio() const;
+
+        /**
+         * Get the number of items & nets with changes that were not flushed yet.
+         */
+        [[nodiscard]]
+        std::size_t
+        pendingCount() const;
+
+        /**
+         * Restore a scene from a snapshot & its journal.
+         *
+         * @note The scene is cleared first. Journal records following a corrupt or incomplete record are ignored.
+         *
+         * @param scene The scene.
+         * @param basePath The path of the files without extension.
+         * @return Success indicator & message.
+         */
+        [[nodiscard]]
+        static
+        std::pair<bool, std::string>
+        recover(Scene& scene, const QString& basePath);
+
+    Q_SIGNALS:
+        /**
+         * Signal emitted after a new snapshot was written.
+         */
+        void
+        compacted();
+
+    private:
+        enum class RecordType : std::uint8_t
+        {
+            ItemUpsert = 0,
+            ItemRemove = 1,
+            NetUpsert  = 2,
+            NetRemove  = 3,
+        };
+
+        struct ItemEntry
+        {
+            std::weak_ptr<Items::Item> item;
+            std::uint64_t id = 0;
+        };
+
+        struct NetEntry
+        {
+            std::weak_ptr<Items::WireNet> net;
+            std::uint64_t id = 0;
+        };
+
+        QPointer<Scene> m_scene;
+        QString m_basePath;
+        QFile m_file;
+        std::uint64_t m_generation = 0;
+        std::uint64_t m_nextId = 0;
+        qint64 m_snapshotSize = 0;
+        double m_compactionRatio = default_compaction_ratio;
+        ChangeTracker m_changes;
+        QHash<const Items::Item*, ItemEntry> m_itemIds;
+        QHash<const wire_system::net*, NetEntry> m_netIds;
+
+        bool
+        append(RecordType type, std::uint64_t id, const QByteArray& payload = { });
+    };
+
+}
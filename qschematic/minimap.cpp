@@ -0,0 +1,252 @@
+#include "minimap.hpp"
+#include "scene.hpp"
+#include "view.hpp"
+
+#include <QMouseEvent>
+#include <QPainter>
+#include <QScrollBar>
+#include <QTimer>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+using namespace QSchematic;
+
+const int MAX_DIRTY_RECTS = 16;
+const int UPDATE_DELAY_MS = 50;
+const qreal REBUILD_THRESHOLD_PX = 4.0;        // How far (in widget pixels) the scene rect may drift before rebuilding
+
+Minimap::Minimap(QWidget* parent) :
+    QWidget(parent)
+{
+    // Coalesce scene changes
+    m_timer = new QTimer(this);
+    m_timer->setSingleShot(true);
+    m_timer->setInterval(UPDATE_DELAY_MS);
+    connect(m_timer, &QTimer::timeout, this, &Minimap::flush);
+
+    setMouseTracking(false);
+    setCursor(Qt::PointingHandCursor);
+}
+
+void
+Minimap::setScene(Scene* scene)
+{
+    for (const auto& connection : m_sceneConnections)
+        disconnect(connection);
+    m_sceneConnections.clear();
+
+    m_scene = scene;
+    if (m_scene) {
+        m_sceneConnections << connect(m_scene, &Scene::contentChanged, this, &Minimap::contentChanged);
+        m_sceneConnections << connect(m_scene, &QGraphicsScene::sceneRectChanged, this, &Minimap::sceneRectChanged);
+    }
+
+    rebuild();
+}
+
+void
+Minimap::setView(View* view)
+{
+    for (const auto& connection : m_viewConnections)
+        disconnect(connection);
+    m_viewConnections.clear();
+
+    m_view = view;
+    if (m_view) {
+        const auto repaint = [this] { update(); };
+        m_viewConnections << connect(m_view->horizontalScrollBar(), &QScrollBar::valueChanged, this, repaint);
+        m_viewConnections << connect(m_view->verticalScrollBar(), &QScrollBar::valueChanged, this, repaint);
+        m_viewConnections << connect(m_view, &View::zoomChanged, this, repaint);
+    }
+
+    update();
+}
+
+QSize
+Minimap::sizeHint() const
+{
+    return { 200, 150 };
+}
+
+void
+Minimap::paintEvent(QPaintEvent* event)
+{
+    Q_UNUSED(event)
+
+    QPainter painter(this);
+    painter.fillRect(rect(), palette().window());
+
+    // Scene
+    if (!m_image.isNull())
+        painter.drawImage(m_target, m_image);
+
+    // Visible area of the view
+    if (m_view && m_scene) {
+        const QRectF visible = m_view->mapToScene(m_view->viewport()->rect()).boundingRect();
+
+        painter.setPen(QPen(palette().highlight(), 1));
+        painter.setBrush(Qt::NoBrush);
+        painter.drawRect(m_sceneToWidget.mapRect(visible).intersected(m_target));
+    }
+}
+
+void
+Minimap::resizeEvent(QResizeEvent* event)
+{
+    QWidget::resizeEvent(event);
+
+    rebuild();
+}
+
+void
+Minimap::mousePressEvent(QMouseEvent* event)
+{
+    if (event->button() != Qt::LeftButton) {
+        QWidget::mousePressEvent(event);
+        return;
+    }
+
+    navigate(event->position());
+    event->accept();
+}
+
+void
+Minimap::mouseMoveEvent(QMouseEvent* event)
+{
+    if (!(event->buttons() & Qt::LeftButton)) {
+        QWidget::mouseMoveEvent(event);
+        return;
+    }
+
+    navigate(event->position());
+    event->accept();
+}
+
+void
+Minimap::rebuild()
+{
+    m_timer->stop();
+    m_dirty = { };
+    m_image = { };
+    m_sceneRectChanged = false;
+    m_sceneRect = { };
+
+    // Sanity check
+    if (!m_scene || width() <= 0 || height() <= 0) {
+        update();
+        return;
+    }
+
+    const QRectF sceneRect = m_scene->sceneRect();
+    if (sceneRect.isEmpty()) {
+        update();
+        return;
+    }
+    m_sceneRect = sceneRect;
+
+    // Fit the scene rect into the widget
+    const qreal scale = std::min(width() / sceneRect.width(), height() / sceneRect.height());
+    const QSizeF size = sceneRect.size() * scale;
+    m_target = QRectF(QPointF((width() - size.width()) / 2, (height() - size.height()) / 2), size);
+    m_sceneToWidget = QTransform::fromTranslate(-sceneRect.x(), -sceneRect.y()) * QTransform::fromScale(scale, scale) * QTransform::fromTranslate(m_target.x(), m_target.y());
+
+    // The image is kept in device pixels
+    const qreal dpr = devicePixelRatioF();
+    m_image = QImage((size * dpr).toSize(), QImage::Format_ARGB32_Premultiplied);
+    if (m_image.isNull()) {
+        update();
+        return;
+    }
+    m_sceneToImage = QTransform::fromTranslate(-sceneRect.x(), -sceneRect.y()) * QTransform::fromScale(scale * dpr, scale * dpr);
+
+    render(m_image.rect());
+    update();
+}
+
+void
+Minimap::contentChanged(const QRectF& rect)
+{
+    if (m_image.isNull())
+        return;
+
+    const QRect imageRect = m_sceneToImage.mapRect(rect).toAlignedRect().adjusted(-1, -1, 1, 1);
+    m_dirty += imageRect.intersected(m_image.rect());
+
+    if (!m_dirty.isEmpty() && !m_timer->isActive())
+        m_timer->start();
+}
+
+void
+Minimap::sceneRectChanged()
+{
+    // Coalesced with the scene changes (the scene rect grows step by step while dragging items near the edge)
+    m_sceneRectChanged = true;
+    if (!m_timer->isActive())
+        m_timer->start();
+}
+
+bool
+Minimap::mappingChanged() const
+{
+    // Sanity check
+    if (!m_scene || m_image.isNull())
+        return true;
+
+    // Only rebuild once the difference is actually visible
+    const QRectF current = m_sceneToWidget.mapRect(m_sceneRect);
+    const QRectF next = m_sceneToWidget.mapRect(m_scene->sceneRect());
+
+    return std::abs(current.left() - next.left()) > REBUILD_THRESHOLD_PX ||
+           std::abs(current.top() - next.top()) > REBUILD_THRESHOLD_PX ||
+           std::abs(current.right() - next.right()) > REBUILD_THRESHOLD_PX ||
+           std::abs(current.bottom() - next.bottom()) > REBUILD_THRESHOLD_PX;
+}
+
+void
+Minimap::flush()
+{
+    if (std::exchange(m_sceneRectChanged, false) && mappingChanged()) {
+        rebuild();
+        return;
+    }
+
+    if (m_image.isNull() || m_dirty.isEmpty())
+        return;
+
+    // Don't bother with many small rects
+    if (m_dirty.rectCount() > MAX_DIRTY_RECTS)
+        render(m_dirty.boundingRect());
+    else {
+        for (const QRect& rect : m_dirty)
+            render(rect);
+    }
+    m_dirty = { };
+
+    update();
+}
+
+void
+Minimap::render(const QRect& imageRect)
+{
+    // Sanity check
+    if (!m_scene || imageRect.isEmpty())
+        return;
+
+    QPainter painter(&m_image);
+    painter.setClipRect(imageRect);
+    painter.fillRect(imageRect, Qt::white);
+
+    const QRectF source = m_sceneToImage.inverted().mapRect(QRectF(imageRect));
+    m_scene->render(&painter, QRectF(imageRect), source, Qt::IgnoreAspectRatio);
+}
+
+void
+Minimap::navigate(const QPointF& pos)
+{
+    if (!m_view)
+        return;
+
+    m_view->centerOn(m_sceneToWidget.inverted().map(pos));
+}
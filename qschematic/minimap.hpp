@@ -0,0 +1,117 @@
+#pragma once
+
+#include <QImage>
+#include <QList>
+#include <QPointer>
+#include <QRectF>
+#include <QRegion>
+#include <QTransform>
+#include <QWidget>
+
+class QTimer;
+
+namespace QSchematic
+{
+
+    class Scene;
+    class View;
+
+    /**
+     * An overview of a scene.
+     *
+     * @details The scene is rendered into a low resolution image which is kept up to date by re-rendering only the
+     *          regions reported by Scene::contentChanged(). As the image is rendered at a very low level of detail,
+     *          the items use their simplified representations. A full detail render of the scene is never triggered.
+     *          Changes of the scene rect are coalesced as well. The image is only rebuilt once the scene rect moved
+     *          visibly relative to the one the image was built for.
+     *          The visible area of the attached view is shown as a rectangle. Clicking or dragging inside the minimap
+     *          centers the view on that location.
+     *
+     * @note The minimap intentionally does not connect to QGraphicsScene::changed(). Doing so would disable the direct
+     *       item to view updates of all views of the scene. Therefore, changes of an item's appearance which do not
+     *       affect its bounds (eg. highlighting) only show up once the affected region is rendered again.
+     */
+    class Minimap :
+        public QWidget
+    {
+        Q_OBJECT
+        Q_DISABLE_COPY_MOVE(Minimap)
+
+    public:
+        /**
+         * Constructor.
+         *
+         * @param parent The parent widget.
+         */
+        explicit
+        Minimap(QWidget* parent = nullptr);
+
+        /**
+         * Destructor.
+         */
+        ~Minimap() override = default;
+
+        /**
+         * Set the scene to show.
+         *
+         * @param scene The scene.
+         */
+        void
+        setScene(Scene* scene);
+
+        /**
+         * Set the view to navigate.
+         *
+         * @param view The view.
+         */
+        void
+        setView(View* view);
+
+        [[nodiscard]]
+        QSize
+        sizeHint() const override;
+
+    protected:
+        void paintEvent(QPaintEvent* event) override;
+        void resizeEvent(QResizeEvent* event) override;
+        void mousePressEvent(QMouseEvent* event) override;
+        void mouseMoveEvent(QMouseEvent* event) override;
+
+    private:
+        QPointer<Scene> m_scene;
+        QPointer<View> m_view;
+        QList<QMetaObject::Connection> m_sceneConnections;
+        QList<QMetaObject::Connection> m_viewConnections;
+        QTimer* m_timer = nullptr;
+        QImage m_image;
+        QRegion m_dirty;            // In image coordinates
+        QRectF m_target;            // Where the image is drawn (in widget coordinates)
+        QTransform m_sceneToImage;
+        QTransform m_sceneToWidget;
+        QRectF m_sceneRect;         // The scene rect the image was built for
+        bool m_sceneRectChanged = false;
+
+        void
+        rebuild();
+
+        void
+        contentChanged(const QRectF& rect);
+
+        void
+        sceneRectChanged();
+
+        [[nodiscard]]
+        bool
+        mappingChanged() const;
+
+        void
+        flush();
+
+        void
+        render(const QRect& imageRect);
+
+        void
+        navigate(const QPointF& pos);
+    };
+
+}
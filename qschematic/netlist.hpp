@@ -21,6 +21,7 @@ namespace QSchematic
     struct Net
     {
         QString name;
+        bool anonymous = false;     // The net has no name in the wire system (the name got generated)
         std::vector<TWire> wires;
         std::vector<TNode> nodes;
         std::vector<TConnector> connectors;
@@ -0,0 +1,273 @@
+#pragma once
+
+#include "netlist.hpp"
+
+#include <QString>
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace QSchematic
+{
+
+    /**
+     * The difference between two netlists.
+     *
+     * @details Pins are identified by their connector. Therefore, both netlists are expected to be generated from the
+     *          same scene (eg. before & after an edit).
+     */
+    template<
+        typename TNode = Items::Node*,
+        typename TConnector = Items::Connector*,
+        typename TWire = Items::Wire*,
+        typename TNet = Net<TWire, TNode, TConnector>
+    >
+    struct NetlistDiff
+    {
+        struct Rename
+        {
+            QString from;
+            QString to;
+        };
+
+        /**
+         * A pin which is connected to a different net than before.
+         *
+         * @note A pin which was not connected before has an empty @p from. A pin which is no longer connected has an
+         *       empty @p to.
+         */
+        struct PinMove
+        {
+            TConnector connector;
+            TNode node;
+            QString from;
+            QString to;
+        };
+
+        std::vector<TNet> added;
+        std::vector<TNet> removed;
+        std::vector<Rename> renamed;
+        std::vector<PinMove> movedPins;
+
+        [[nodiscard]]
+        bool
+        isEmpty() const
+        {
+            return added.empty() && removed.empty() && renamed.empty() && movedPins.empty();
+        }
+    };
+
+    /**
+     * Check whether a net is anonymous (ie. it has no name in the wire system and got a generated one like `N001`).
+     *
+     * @note Generated names get renumbered whenever the set of anonymous nets changes. They therefore don't carry
+     *       any identity. Nets without an `anonymous` member (see Net) are always considered to be named.
+     */
+    template<typename TNet>
+    [[nodiscard]]
+    constexpr
+    bool
+    isAnonymousNet(const TNet& net)
+    {
+        if constexpr (requires { net.anonymous; })
+            return net.anonymous;
+        else
+            return false;
+    }
+
+    /**
+     * Compute the difference between two netlists.
+     *
+     * @details Each net is reduced to an order-independent hash of its connector set. Nets with identical connector
+     *          sets are matched first. The remaining nets are matched by name (if not anonymous) and then by the
+     *          largest pin overlap. The matching is used to report renamed nets and moved pins. Nets which could not
+     *          be matched are reported as added or removed.
+     *          The names of anonymous nets (see isAnonymousNet()) are never considered to carry identity. A renumbered
+     *          anonymous net is therefore not reported as renamed.
+     *
+     * @param from The old netlist.
+     * @param to The new netlist.
+     * @return The difference.
+     */
+    template<
+        typename TNode,
+        typename TConnector,
+        typename TWire,
+        typename TNet
+    >
+    [[nodiscard]]
+    NetlistDiff<TNode, TConnector, TWire, TNet>
+    diff(const Netlist<TNode, TConnector, TWire, TNet>& from, const Netlist<TNode, TConnector, TWire, TNet>& to)
+    {
+        using index_t = std::size_t;
+        constexpr index_t none = static_cast<index_t>(-1);
+
+        // Order-independent hash of a connector set
+        const auto netHash = [](const TNet& net) {
+            std::uint64_t hash = 0;
+            for (const auto& [connector, node] : net.connectorNodePairs) {
+                // splitmix64 finalizer to spread the pointer bits before summing
+                std::uint64_t h = std::hash<TConnector>{}(connector) + 0x9e3779b97f4a7c15ull;
+                h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ull;
+                h = (h ^ (h >> 27)) * 0x94d049bb133111ebull;
+                h = h ^ (h >> 31);
+                hash += h;
+            }
+            return hash;
+        };
+
+        // Map each pin to the net it belongs to
+        const auto pinMap = [](const std::vector<TNet>& nets) {
+            std::unordered_map<TConnector, index_t> map;
+            for (index_t i = 0; i < std::size(nets); i++) {
+                for (const auto& [connector, node] : nets[i].connectorNodePairs)
+                    map.try_emplace(connector, i);
+            }
+            return map;
+        };
+
+        const auto& oldNets = from.nets;
+        const auto& newNets = to.nets;
+        const auto oldPins = pinMap(oldNets);
+        const auto newPins = pinMap(newNets);
+
+        std::vector<index_t> oldToNew(std::size(oldNets), none);
+        std::vector<index_t> newToOld(std::size(newNets), none);
+        const auto match = [&](index_t oldIndex, index_t newIndex) {
+            oldToNew[oldIndex] = newIndex;
+            newToOld[newIndex] = oldIndex;
+        };
+
+        // Pass 1: Match identical connector sets
+        {
+            std::unordered_multimap<std::uint64_t, index_t> hashes;
+            hashes.reserve(std::size(oldNets));
+            for (index_t i = 0; i < std::size(oldNets); i++)
+                hashes.emplace(netHash(oldNets[i]), i);
+
+            for (index_t i = 0; i < std::size(newNets); i++) {
+                const auto& newNet = newNets[i];
+                const auto [begin, end] = hashes.equal_range(netHash(newNet));
+                for (auto it = begin; it != end; ++it) {
+                    const index_t candidate = it->second;
+                    if (oldToNew[candidate] != none)
+                        continue;
+
+                    // Verify to guard against hash collisions
+                    const auto& oldNet = oldNets[candidate];
+                    if (std::size(oldNet.connectorNodePairs) != std::size(newNet.connectorNodePairs))
+                        continue;
+                    bool equal = true;
+                    for (const auto& [connector, node] : newNet.connectorNodePairs) {
+                        const auto pin = oldPins.find(connector);
+                        if (pin == std::cend(oldPins) || pin->second != candidate) {
+                            equal = false;
+                            break;
+                        }
+                    }
+                    if (!equal)
+                        continue;
+
+                    match(candidate, i);
+                    break;
+                }
+            }
+        }
+
+        // Pass 2: Match remaining named nets by name
+        {
+            std::unordered_map<QString, index_t> names;
+            for (index_t i = 0; i < std::size(oldNets); i++) {
+                if (oldToNew[i] == none && !isAnonymousNet(oldNets[i]))
+                    names.try_emplace(oldNets[i].name, i);
+            }
+
+            for (index_t i = 0; i < std::size(newNets); i++) {
+                if (newToOld[i] != none || isAnonymousNet(newNets[i]))
+                    continue;
+
+                const auto it = names.find(newNets[i].name);
+                if (it == std::cend(names))
+                    continue;
+
+                match(it->second, i);
+                names.erase(it);
+            }
+        }
+
+        // Pass 3: Match remaining nets by largest pin overlap
+        {
+            std::unordered_map<index_t, std::size_t> overlaps;
+            for (index_t i = 0; i < std::size(newNets); i++) {
+                if (newToOld[i] != none)
+                    continue;
+
+                overlaps.clear();
+                for (const auto& [connector, node] : newNets[i].connectorNodePairs) {
+                    const auto pin = oldPins.find(connector);
+                    if (pin != std::cend(oldPins) && oldToNew[pin->second] == none)
+                        overlaps[pin->second]++;
+                }
+
+                index_t best = none;
+                std::size_t bestCount = 0;
+                for (const auto& [oldIndex, count] : overlaps) {
+                    if (count > bestCount || (count == bestCount && oldIndex < best)) {
+                        best = oldIndex;
+                        bestCount = count;
+                    }
+                }
+
+                if (best != none)
+                    match(best, i);
+            }
+        }
+
+        NetlistDiff<TNode, TConnector, TWire, TNet> ret;
+
+        // Added & renamed nets
+        for (index_t i = 0; i < std::size(newNets); i++) {
+            const index_t oldIndex = newToOld[i];
+            if (oldIndex == none) {
+                ret.added.push_back(newNets[i]);
+                continue;
+            }
+
+            const TNet& oldNet = oldNets[oldIndex];
+            const TNet& newNet = newNets[i];
+            if (oldNet.name != newNet.name && !(isAnonymousNet(oldNet) && isAnonymousNet(newNet)))
+                ret.renamed.push_back({ oldNet.name, newNet.name });
+        }
+
+        // Removed nets
+        for (index_t i = 0; i < std::size(oldNets); i++) {
+            if (oldToNew[i] == none)
+                ret.removed.push_back(oldNets[i]);
+        }
+
+        // Pins which are now on a different (or no) net
+        for (index_t i = 0; i < std::size(newNets); i++) {
+            for (const auto& [connector, node] : newNets[i].connectorNodePairs) {
+                const auto pin = oldPins.find(connector);
+                if (pin == std::cend(oldPins))
+                    ret.movedPins.push_back({ connector, node, { }, newNets[i].name });
+                else if (oldToNew[pin->second] != i)
+                    ret.movedPins.push_back({ connector, node, oldNets[pin->second].name, newNets[i].name });
+            }
+        }
+
+        // Pins which are no longer connected
+        for (const auto& oldNet : oldNets) {
+            for (const auto& [connector, node] : oldNet.connectorNodePairs) {
+                if (!newPins.contains(connector))
+                    ret.movedPins.push_back({ connector, node, oldNet.name, { } });
+            }
+        }
+
+        return ret;
+    }
+
+}
@@ -5,6 +5,13 @@
 #include "items/wirenet.hpp"
 #include "items/node.hpp"
 
+#include <algorithm>
+#include <future>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
 namespace QSchematic
 {
     class Wire;
@@ -15,6 +22,48 @@ namespace QSchematic
     class NetlistGenerator
     {
     public:
+        /**
+         * Immutable snapshot of the connection data required to generate a netlist.
+         *
+         * @details The snapshot is captured on the thread owning the scene. Afterward, it is never required to touch
+         *          any of the QGraphicsItems again to build the nets. The node, connector and wire pointers are only
+         *          carried along as opaque values. This allows processing the snapshot from worker threads.
+         */
+        template<
+            typename TNode,
+            typename TConnector,
+            typename TWire
+        >
+        struct Snapshot
+        {
+            struct ConnectorRecord
+            {
+                TNode node;
+                TConnector connector;
+                const wire_system::wire* wire = nullptr;    // The attached wire
+                bool hasConnection = false;
+            };
+
+            struct GlobalNetRecord
+            {
+                QString name;
+                bool anonymous = false;                 // The name got generated by the wire system
+                std::vector<TWire> wires;
+                std::vector<std::size_t> connectors;    // Indices into Snapshot::connectors
+            };
+
+            std::vector<TNode> nodes;
+            std::vector<ConnectorRecord> connectors;
+            std::vector<GlobalNetRecord> nets;
+        };
+
+        /**
+         * Generate a netlist from a scene.
+         *
+         * @param netlist The netlist to populate.
+         * @param scene The scene.
+         * @return Success indicator.
+         */
         template<
             typename TNode = Node*,
             typename TConnector = Connector*,
@@ -24,106 +73,193 @@ namespace QSchematic
         static
         bool
         generate(Netlist<TNode, TConnector, TWire, TNet>& netlist, const Scene& scene)
+        {
+            return generateParallel(netlist, scene, 1);
+        }
+
+        /**
+         * Generate a netlist from a scene while processing the global nets on multiple threads.
+         *
+         * @details The connection data is first captured into a snapshot on the calling thread. The global nets are
+         *          then partitioned across the worker threads. The resulting nets are merged in the same order
+         *          as produced by generate().
+         *
+         * @param netlist The netlist to populate.
+         * @param scene The scene.
+         * @param maxThreads The maximum number of threads to use. Zero uses the hardware concurrency.
+         * @return Success indicator.
+         */
+        template<
+            typename TNode = Node*,
+            typename TConnector = Connector*,
+            typename TWire = Wire*,
+            typename TNet = Net<TWire, TNode, TConnector>
+        >
+        static
+        bool
+        generateParallel(Netlist<TNode, TConnector, TWire, TNet>& netlist, const Scene& scene, std::size_t maxThreads = 0)
+        {
+            auto s = snapshot<TNode, TConnector, TWire>(scene);
+            if (!s)
+                return false;
+
+            netlist.nets = nets<TNet>(*s, maxThreads);
+            netlist.nodes = std::move(s->nodes);
+
+            return true;
+        }
+
+        /**
+         * Capture the connection data of a scene.
+         *
+         * @note This must be called from the thread owning the scene.
+         *
+         * @param scene The scene.
+         * @return The snapshot (if any).
+         */
+        template<
+            typename TNode = Node*,
+            typename TConnector = Connector*,
+            typename TWire = Wire*
+        >
+        [[nodiscard]]
+        static
+        std::optional<Snapshot<TNode, TConnector, TWire>>
+        snapshot(const Scene& scene)
         {
             // Get the wiresystem manager
             auto wm = scene.wire_manager();
             if (!wm)
-                return false;
+                return std::nullopt;
+
+            Snapshot<TNode, TConnector, TWire> s;
 
             // Add all nodes
-            std::vector<TNode> nodes;
-            for (const auto& node : scene.nodes()) {
+            const auto sceneNodes = scene.nodes();
+            for (const auto& node : sceneNodes) {
                 // Sanity check
                 if (!node)
                     continue;
 
-                nodes.push_back( static_cast<TNode>( node.get() ) );
+                s.nodes.push_back( static_cast<TNode>( node.get() ) );
             }
 
-            // Get global nets from the wiresystem
-            auto globalNets = wm->global_nets();
+            // Build a list of all connectors which have a wire attached
+            for (const auto& node : sceneNodes) {
+                // Convert to template node type
+                TNode templateNode = qgraphicsitem_cast<TNode>(node.get());
+                if (!templateNode)
+                    continue;
 
-            // Export nets
-            std::vector<TNet> nets;
-            for (const auto& globalNet : globalNets) {
-                // Create the new Net
-                TNet net;
-                net.name = QString::fromStdString(globalNet.name);
+                // Loop through all Node's connectors
+                for (const auto& connector : node->connectors()) {
+                    // Convert to template connector type
+                    TConnector templateConnector = qgraphicsitem_cast<TConnector>(connector.get());
+                    if (!templateConnector)
+                        continue;
 
-                // Build a list of all wire net points in scene coordinates
-                QList<QPointF> wireScenePoints;
-                for (const auto& wireNet : globalNet.nets) {
-                    for (const auto& p : wireNet->points()) {
-                        wireScenePoints << p.toPointF();
-                    }
+                    // Get the connection record
+                    const auto cr = wm->attached_wire(connector.get());
+                    if (!cr || !cr->wire)
+                        continue;
 
-                    // Store wires
-                    for ( const auto& wire : wireNet->wires()) {
-                        TWire w = qobject_cast<TWire>( std::dynamic_pointer_cast<Items::Wire>(wire).get() );
-                        if (w)
-                            net.wires.push_back( w );
-                    }
+                    s.connectors.push_back({ templateNode, templateConnector, cr->wire, templateConnector->hasConnection() });
                 }
+            }
 
-                // Build a list of all connectors
-                for (auto& node : scene.nodes()) {
-                    // Convert to template node type
-                    TNode templateNode = qgraphicsitem_cast<TNode>(node.get());
-                    if (!templateNode)
-                        continue;
+            // Get global nets from the wiresystem
+            std::unordered_map<const wire_system::wire*, std::size_t> netIndices;
+            for (const auto& globalNet : wm->global_nets()) {
+                typename Snapshot<TNode, TConnector, TWire>::GlobalNetRecord record;
+                record.anonymous = globalNet.name_id == wire_system::name_table::empty_id;
+                if (record.anonymous)
+                    record.name = QString::fromStdString(globalNet.name);
+                else
+                    record.name = wm->names().name(globalNet.name_id);
 
-                    // Loop through all Node's connectors
-                    for (auto& connector : node->connectors()) {
-                        // Convert to template connector type
-                        TConnector templateConnector = qgraphicsitem_cast<TConnector>(connector.get());
-                        if (!templateConnector)
+                // Store wires
+                for (const auto& wireNet : globalNet.nets) {
+                    for (const auto& wire : wireNet->wires()) {
+                        TWire w = qobject_cast<TWire>( std::dynamic_pointer_cast<Items::Wire>(wire).get() );
+                        if (!w)
                             continue;
 
-                        // Get the connection record
-                        const auto cr = wm->attached_wire(connector.get());
-                        if (!cr)
-                            continue;
-                        const auto* wire = cr->wire;
-                        if (!wire)
-                            continue;
+                        record.wires.push_back(w);
+                        netIndices.emplace(wire.get(), std::size(s.nets));
+                    }
+                }
 
-                        // Create the Connector/Node pairs
-                        if (std::find(net.wires.begin(), net.wires.end(), wire) != net.wires.end()) {
+                s.nets.push_back(std::move(record));
+            }
 
-                            // Create list of all nodes in this net
-                            net.nodes.push_back(templateNode);
+            // Assign the connectors to their global net
+            for (std::size_t i = 0; i < std::size(s.connectors); i++) {
+                const auto it = netIndices.find(s.connectors[i].wire);
+                if (it != std::cend(netIndices))
+                    s.nets[it->second].connectors.push_back(i);
+            }
 
-                            // Create a list of all connectors in this net
-                            net.connectors.push_back(templateConnector);
+            return s;
+        }
 
-                            // Connector/Node pairs
-                            net.connectorNodePairs.emplace(std::pair<TConnector, TNode>(templateConnector, templateNode));
-                        }
-                    }
-                }
+        /**
+         * Build the nets from a snapshot.
+         *
+         * @note This does not access the scene and can therefore be called from any thread.
+         *
+         * @param snapshot The snapshot.
+         * @param maxThreads The maximum number of threads to use. Zero uses the hardware concurrency.
+         * @return The nets.
+         */
+        template<
+            typename TNet,
+            typename TSnapshot
+        >
+        [[nodiscard]]
+        static
+        std::vector<TNet>
+        nets(const TSnapshot& snapshot, std::size_t maxThreads = 0)
+        {
+            const std::size_t count = std::size(snapshot.nets);
 
-                // Check if the net makes a connection
-                // A net is considered to make a connection if at least two wire points are on connectors.
-                // Note: This implicitly also ensures that the connectors are individual/separate connectors as long as we
-                //       ensure that the net::connectors collection does not contain duplicate items.
-                bool netMakesConnection = false;
-                int connectionsCount = 0;
-                for (const auto& conn : net.connectors) {
-                    if (conn->hasConnection())
-                        connectionsCount++;
+            // Figure out how many threads we want to use
+            std::size_t threadCount = maxThreads;
+            if (threadCount == 0)
+                threadCount = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+            threadCount = std::min(threadCount, count);
+
+            // Each global net is processed independently. Every worker writes to its own slots only.
+            std::vector<std::optional<TNet>> results(count);
+            if (threadCount <= 1) {
+                for (std::size_t i = 0; i < count; i++)
+                    results[i] = net<TNet>(snapshot, snapshot.nets[i]);
+            }
+            else {
+                const std::size_t chunkSize = (count + threadCount - 1) / threadCount;
+
+                std::vector<std::future<void>> futures;
+                futures.reserve(threadCount);
+                for (std::size_t begin = 0; begin < count; begin += chunkSize) {
+                    const std::size_t end = std::min(begin + chunkSize, count);
+                    futures.push_back(std::async(std::launch::async, [&snapshot, &results, begin, end] {
+                        for (std::size_t i = begin; i < end; i++)
+                            results[i] = net<TNet>(snapshot, snapshot.nets[i]);
+                    }));
                 }
-                netMakesConnection = connectionsCount >= 2;
 
-                // Add the net (if supposed to)
-                if (netMakesConnection)
-                    nets.push_back( net );
+                for (auto& future : futures)
+                    future.get();
             }
 
-            // Set the netlist
-            netlist.nodes = std::move(nodes);
-            netlist.nets = std::move(nets);
+            // Merge in deterministic order
+            std::vector<TNet> ret;
+            ret.reserve(count);
+            for (auto& result : results) {
+                if (result)
+                    ret.push_back(std::move(*result));
+            }
 
-            return true;
+            return ret;
         }
 
     private:
@@ -131,6 +267,56 @@ namespace QSchematic
         NetlistGenerator(const NetlistGenerator& other) = default;
         NetlistGenerator(NetlistGenerator&& other) = default;
         virtual ~NetlistGenerator() = default;
+
+        /**
+         * Build a single net from a global net record.
+         *
+         * @return The net or nothing if the net does not make a connection.
+         */
+        template<
+            typename TNet,
+            typename TSnapshot,
+            typename TGlobalNetRecord
+        >
+        [[nodiscard]]
+        static
+        std::optional<TNet>
+        net(const TSnapshot& snapshot, const TGlobalNetRecord& globalNet)
+        {
+            // Create the new Net
+            TNet net;
+            net.name = globalNet.name;
+            if constexpr (requires { net.anonymous; })
+                net.anonymous = globalNet.anonymous;
+            net.wires = globalNet.wires;
+
+            // Create the Connector/Node pairs
+            std::size_t connectionsCount = 0;
+            for (const std::size_t index : globalNet.connectors) {
+                const auto& record = snapshot.connectors[index];
+
+                // Create list of all nodes in this net
+                net.nodes.push_back(record.node);
+
+                // Create a list of all connectors in this net
+                net.connectors.push_back(record.connector);
+
+                // Connector/Node pairs
+                net.connectorNodePairs.emplace(record.connector, record.node);
+
+                if (record.hasConnection)
+                    connectionsCount++;
+            }
+
+            // Check if the net makes a connection
+            // A net is considered to make a connection if at least two wire points are on connectors.
+            // Note: This implicitly also ensures that the connectors are individual/separate connectors as long as we
+            //       ensure that the net::connectors collection does not contain duplicate items.
+            if (connectionsCount < 2)
+                return std::nullopt;
+
+            return net;
+        }
     };
 
 }
@@ -1,4 +1,9 @@
 #include <algorithm>
+#include <future>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
 
 #include <QPainter>
 #include <QGraphicsSceneMouseEvent>
@@ -7,9 +12,12 @@
 #include <QMimeData>
 #include <QtMath>
 #include <QTimer>
+#include <QPointer>
 
 #include "scene.hpp"
 #include "background.hpp"
+#include "serdes.hpp"
+#include "wire_layer.hpp"
 #include "commands/item_move.hpp"
 #include "commands/item_add.hpp"
 #include "commands/item_remove.hpp"
@@ -19,10 +27,71 @@
 #include "items/node.hpp"
 #include "items/label.hpp"
 #include "items/widget.hpp"
+#include "items/wirenet.hpp"
 #include "utils/itemscontainerutils.hpp"
 
 using namespace QSchematic;
 
+/**
+ * Checks whether a rect touches (or exceeds) any edge of some bounds.
+ */
+static
+bool
+onEdge(const QRectF& rect, const QRectF& bounds)
+{
+    return rect.left() <= bounds.left() || rect.top() <= bounds.top() || rect.right() >= bounds.right() || rect.bottom() >= bounds.bottom();
+}
+
+/**
+ * Serializes objects on multiple threads.
+ *
+ * @details The objects are split into contiguous ranges, one per thread. The containers are returned in the order of
+ *          the objects. Therefore, the result does not depend on the number of threads.
+ *
+ * @note The to_container() implementations of the objects must be free of side effects.
+ *
+ * @param objects The objects.
+ * @param maxThreads The maximum number of threads to use. Zero uses the hardware concurrency.
+ * @return The containers.
+ */
+template<typename T>
+static
+std::vector<gpds::container>
+toContainers(const std::vector<std::shared_ptr<T>>& objects, int maxThreads)
+{
+    // Not worth spinning up a thread for fewer objects
+    constexpr std::size_t minChunkSize = 256;
+
+    const std::size_t count = std::size(objects);
+
+    // Figure out how many threads we want to use
+    std::size_t threadCount = maxThreads > 0 ? static_cast<std::size_t>(maxThreads) : std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    threadCount = std::min(threadCount, std::max<std::size_t>(1, count / minChunkSize));
+
+    // Every worker writes to its own slots only
+    std::vector<gpds::container> ret(count);
+    const auto serialize = [&objects, &ret](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++)
+            ret[i] = objects[i]->to_container();
+    };
+
+    if (threadCount <= 1)
+        serialize(0, count);
+    else {
+        const std::size_t chunkSize = (count + threadCount - 1) / threadCount;
+
+        std::vector<std::future<void>> futures;
+        futures.reserve(threadCount);
+        for (std::size_t begin = 0; begin < count; begin += chunkSize)
+            futures.push_back(std::async(std::launch::async, serialize, begin, std::min(begin + chunkSize, count)));
+
+        for (auto& future : futures)
+            future.get();
+    }
+
+    return ret;
+}
+
 Scene::Scene(QObject* parent) :
     QGraphicsScene(parent)
 {
@@ -58,13 +127,22 @@ Scene::Scene(QObject* parent) :
     // Background
     setupBackground();
     connect(this, &QGraphicsScene::sceneRectChanged, [this](const QRectF rect){
+        // Someone set the scene rect via QGraphicsScene::setSceneRect(). Stop managing it.
+        if (!_settingSceneRect && !_managedSceneRect.isNull())
+            _sceneRectManaged = false;
+
         if (_background) {
             // Note: We adjust the scene rect (make it smaller) before we set it as the background rect because the scene automatically resizes
             //       to accommodate all items. If we were not ot do this, the scene would resize (get larger) after setting the background rect
             //       triggering this slot again and we'd end up in an infinite loop.
             _background->setRect(rect.adjusted(1, 1, -1, -1));
         }
+        if (_wireLayer)
+            _wireLayer->setRect(rect.adjusted(1, 1, -1, -1));
     });
+
+    // Wire layer
+    setupWireLayer();
 }
 
 Scene::~Scene()
@@ -80,20 +158,12 @@ Scene::to_container() const
     c.add_attribute("version", serdes_version);
 
     // Scene
-    gpds::container scene;
-    {
-        // Rect
-        gpds::container r;
-        const QRect& rect = sceneRect().toRect();
-        r.add_value("x", rect.x());
-        r.add_value("y", rect.y());
-        r.add_value("width", rect.width());
-        r.add_value("height", rect.height());
-        scene.add_value("rect", r);
-    }
-    c.add_value("scene", scene);
+    c.add_value("scene", saveSceneProperties());
 
     // Items
+    // Note: Connectors & wires are identified by their position within the file to store the connectivity.
+    std::vector<std::shared_ptr<Items::Item>> sceneItems;
+    std::vector<std::tuple<const Items::Connector*, int, int>> connectorIds;
     for (const auto& item : items()) {
         // Sanity check
         if (!item) [[unlikely]]
@@ -103,17 +173,81 @@ Scene::to_container() const
         if (auto wire = std::dynamic_pointer_cast<Items::Wire>(item); wire)
             continue;
 
-        c.add_value("item", item->to_container());
+        if (auto node = std::dynamic_pointer_cast<Items::Node>(item)) {
+            const auto& connectors = node->connectors();
+            for (int i = 0; i < connectors.size(); i++)
+                connectorIds.emplace_back(connectors[i].get(), static_cast<int>(sceneItems.size()), i);
+        }
+
+        sceneItems.push_back(item);
     }
 
+    for (auto& itemContainer : toContainers(sceneItems, _settings.serializationThreads))
+        c.add_value("item", std::move(itemContainer));
+
     // Nets
+    std::vector<std::shared_ptr<Items::WireNet>> wireNets;
+    std::vector<std::pair<wire_system::wire*, std::pair<int, int>>> wires;
+    std::unordered_map<const wire_system::wire*, std::pair<int, int>> wireIds;
     for (const auto& net : m_wire_manager->nets()) {
         // Make sure it's a WireNet
         auto wire_net = std::dynamic_pointer_cast<Items::WireNet>(net);
         if (!wire_net)
             continue;
 
-        c.add_value("net", wire_net->to_container());
+        const int netIndex = static_cast<int>(wireNets.size());
+        int wireIndex = 0;
+        for (const auto& wire : wire_net->wires()) {
+            if (!std::dynamic_pointer_cast<Items::Wire>(wire))
+                continue;
+
+            wires.emplace_back(wire.get(), std::make_pair(netIndex, wireIndex));
+            wireIds.emplace(wire.get(), std::make_pair(netIndex, wireIndex));
+            wireIndex++;
+        }
+
+        wireNets.push_back(std::move(wire_net));
+    }
+
+    for (auto& netContainer : toContainers(wireNets, _settings.serializationThreads))
+        c.add_value("net", std::move(netContainer));
+
+    // Connectivity
+    {
+        // Connector <-> wire point
+        std::vector<int> connections;
+        for (const auto& [connector, item, index] : connectorIds) {
+            const auto record = m_wire_manager->attached_wire(connector);
+            if (!record || !record->wire)
+                continue;
+
+            const auto wireId = wireIds.find(record->wire);
+            if (wireId == std::cend(wireIds))
+                continue;
+
+            connections.insert(connections.end(), { item, index, wireId->second.first, wireId->second.second, record->point_index });
+        }
+
+        // Wire <-> wire (one record per junction point of the other wire which is on the wire)
+        std::vector<int> junctions;
+        for (const auto& [wire, id] : wires) {
+            for (const wire_system::wire* otherWire : wire->connected_wires()) {
+                const auto otherId = wireIds.find(otherWire);
+                if (otherId == std::cend(wireIds))
+                    continue;
+
+                const auto points = otherWire->points();
+                for (const int point : otherWire->junctions()) {
+                    if (wire->point_is_on_wire(points.at(point).toPointF()))
+                        junctions.insert(junctions.end(), { id.first, id.second, otherId->second.first, otherId->second.second, point });
+                }
+            }
+        }
+
+        gpds::container connectivity;
+        connectivity.add_value("connections", Serdes::packIndices(connections, 5));
+        connectivity.add_value("junctions", Serdes::packIndices(junctions, 5));
+        c.add_value("connectivity", connectivity);
     }
 
     return c;
@@ -124,59 +258,222 @@ Scene::from_container(const gpds::container& container)
 {
     // Check the version
     const std::size_t version = container.get_attribute<std::size_t>("version").value_or(-1);
-    if (version != serdes_version)
+    if (version < serdes_version_min || version > serdes_version)
         return;
 
+    // Allocate the items in bulk
+    const Items::Factory::PooledConstruction pooledConstruction;
+    const LoadingScope loadingScope(*this);
+
     // Scene
-    if (const gpds::container* sceneContainer = container.get_value<gpds::container*>("scene").value_or(nullptr); sceneContainer) {
-        // Rect
-        const gpds::container* rectContainer = sceneContainer->get_value<gpds::container*>("rect").value_or(nullptr);
-        if ( rectContainer ) {
-            QRect rect;
-            rect.setX(rectContainer->get_value<int>("x").value_or(0));
-            rect.setY(rectContainer->get_value<int>("y").value_or(0));
-            rect.setWidth(rectContainer->get_value<int>("width").value_or(0));
-            rect.setHeight(rectContainer->get_value<int>("height").value_or(0));
-
-            setSceneRect( rect );
-        }
-    }
+    if (const gpds::container* sceneContainer = container.get_value<gpds::container*>("scene").value_or(nullptr); sceneContainer)
+        loadSceneProperties(*sceneContainer);
 
     // Items
     for (const auto& itemContainer : container.get_values<gpds::container*>("item")) {
-        if (!itemContainer)
-            continue;
-
-        auto item = Items::Factory::instance().from_container(*itemContainer);
-        if (!item)
-            continue;
-        item->from_container(*itemContainer);
-        addItem(item);
+        if (itemContainer)
+            loadItem(*itemContainer);
     }
 
     // Nets
     for (const gpds::container* netContainer : container.get_values<gpds::container*>("net")) {
-        if (!netContainer)
-            continue;
+        if (netContainer)
+            loadNet(*netContainer);
+    }
+
+    // Connectivity
+    if (const gpds::container* connectivityContainer = container.get_value<gpds::container*>("connectivity").value_or(nullptr); connectivityContainer)
+        loadConnectivity(*connectivityContainer);
+
+    finishLoading();
+}
 
-        auto net = std::make_shared<Items::WireNet>();
-        net->setScene(this);
-        net->set_manager(wire_manager().get());
-        net->from_container( *netContainer );
+gpds::container
+Scene::saveSceneProperties() const
+{
+    gpds::container c;
+
+    // Rect
+    gpds::container r;
+    const QRect& rect = sceneRect().toRect();
+    r.add_value("x", rect.x());
+    r.add_value("y", rect.y());
+    r.add_value("width", rect.width());
+    r.add_value("height", rect.height());
+    c.add_value("rect", r);
+
+    return c;
+}
 
-        m_wire_manager->add_net(net);
+void
+Scene::loadSceneProperties(const gpds::container& container)
+{
+    // Rect
+    const gpds::container* rectContainer = container.get_value<gpds::container*>("rect").value_or(nullptr);
+    if ( rectContainer ) {
+        QRect rect;
+        rect.setX(rectContainer->get_value<int>("x").value_or(0));
+        rect.setY(rectContainer->get_value<int>("y").value_or(0));
+        rect.setWidth(rectContainer->get_value<int>("width").value_or(0));
+        rect.setHeight(rectContainer->get_value<int>("height").value_or(0));
+
+        setSceneRect( rect );
     }
+}
+
+void
+Scene::loadItem(const gpds::container& container)
+{
+    auto item = Items::Factory::instance().from_container(container);
+    _loadedItems.push_back(item);   // Keep the indices aligned with the file for loadConnectivity()
+    if (!item)
+        return;
+    item->from_container(container);
+    addItem(item);
+}
+
+void
+Scene::loadNet(const gpds::container& container)
+{
+    auto net = std::make_shared<Items::WireNet>();
+    net->setScene(this);
+    net->set_manager(wire_manager().get());
+    net->from_container(container);
 
-    // Attach the wires to the nodes
-    generateConnections();
+    m_wire_manager->add_net(net);
+    _loadedNets.push_back(net);
+}
+
+void
+Scene::loadConnectivity(const gpds::container& container)
+{
+    _connectivityRestored = restoreConnectivity(container);
+    if (!_connectivityRestored)
+        qWarning("Scene::loadConnectivity(): Invalid connectivity records. Reconstructing connections.");
+}
+
+bool
+Scene::restoreConnectivity(const gpds::container& container)
+{
+    constexpr std::size_t TUPLE_SIZE = 5;
+
+    const auto connections = Serdes::unpackIndices(container.get_value<std::string>("connections").value_or(""), TUPLE_SIZE);
+    const auto junctions = Serdes::unpackIndices(container.get_value<std::string>("junctions").value_or(""), TUPLE_SIZE);
+    if (!connections || !junctions)
+        return false;
+
+    const auto connectorAt = [this](int item, int index) -> std::shared_ptr<Items::Connector> {
+        if (item < 0 || item >= std::ssize(_loadedItems))
+            return { };
+        auto node = std::dynamic_pointer_cast<Items::Node>(_loadedItems[item]);
+        if (!node)
+            return { };
+        const auto& connectors = node->connectors();
+        if (index < 0 || index >= connectors.size())
+            return { };
+        return connectors[index];
+    };
+    const auto wireAt = [this](int net, int index) -> std::shared_ptr<wire_system::wire> {
+        if (net < 0 || net >= std::ssize(_loadedNets))
+            return { };
+        const auto& wires = _loadedNets[net]->wires();
+        if (index < 0 || index >= std::ssize(wires))
+            return { };
+        return wires[index];
+    };
+    const auto isEndpoint = [](const wire_system::wire& wire, int point) {
+        return point >= 0 && point < wire.points_count() && (point == 0 || point == wire.points_count() - 1);
+    };
 
-    // Find junctions
-    m_wire_manager->generate_junctions();
+    // Resolve & validate everything first (applying junctions merges nets which changes their wires)
+    struct Attachment
+    {
+        std::shared_ptr<wire_system::wire> wire;
+        int point;
+        std::shared_ptr<Items::Connector> connector;
+    };
+    std::vector<Attachment> attachments;
+    attachments.reserve(connections->size() / TUPLE_SIZE);
+    for (std::size_t i = 0; i < connections->size(); i += TUPLE_SIZE) {
+        const auto& record = *connections;
+        Attachment attachment{ wireAt(record[i+2], record[i+3]), record[i+4], connectorAt(record[i], record[i+1]) };
+        if (!attachment.wire || !attachment.connector || !isEndpoint(*attachment.wire, attachment.point))
+            return false;
+        if (attachment.wire->points().at(attachment.point).toPoint() != attachment.connector->position().toPoint())
+            return false;
+
+        attachments.push_back(std::move(attachment));
+    }
+
+    struct Junction
+    {
+        std::shared_ptr<wire_system::wire> wire;
+        std::shared_ptr<wire_system::wire> otherWire;
+        int point;
+    };
+    std::vector<Junction> wireJunctions;
+    wireJunctions.reserve(junctions->size() / TUPLE_SIZE);
+    for (std::size_t i = 0; i < junctions->size(); i += TUPLE_SIZE) {
+        const auto& record = *junctions;
+        Junction junction{ wireAt(record[i], record[i+1]), wireAt(record[i+2], record[i+3]), record[i+4] };
+        if (!junction.wire || !junction.otherWire || junction.wire == junction.otherWire || !isEndpoint(*junction.otherWire, junction.point))
+            return false;
+        if (!junction.wire->point_is_on_wire(junction.otherWire->points().at(junction.point).toPointF()))
+            return false;
+
+        wireJunctions.push_back(std::move(junction));
+    }
+
+    // Apply
+    for (const auto& attachment : attachments)
+        m_wire_manager->attach_wire_to_connector(attachment.wire.get(), attachment.point, attachment.connector.get());
+    for (const auto& junction : wireJunctions)
+        m_wire_manager->connect_wire(junction.wire.get(), junction.otherWire.get(), junction.point);
+
+    return true;
+}
+
+void
+Scene::finishLoading()
+{
+    // Connectivity was restored from the file
+    if (_connectivityRestored)
+        Q_EMIT netlistChanged();
+
+    // Reconstruct the connectivity geometrically (older files)
+    else {
+        // Attach the wires to the nodes
+        generateConnections();
+
+        // Find junctions
+        m_wire_manager->generate_junctions();
+    }
+
+    resetLoading();
 
     // Clear the undo history
     _undoStack->clear();
 }
 
+void
+Scene::resetLoading()
+{
+    _loadedItems.clear();
+    _loadedNets.clear();
+    _connectivityRestored = false;
+}
+
+Scene::LoadingScope::LoadingScope(Scene& scene) :
+    _scene(scene)
+{
+    _scene.resetLoading();
+}
+
+Scene::LoadingScope::~LoadingScope()
+{
+    _scene.resetLoading();
+}
+
 void
 Scene::setSettings(const Settings& settings)
 {
@@ -194,6 +491,11 @@ Scene::setSettings(const Settings& settings)
     // Store new settings
     _settings = settings;
 
+    // Create or remove the wire layer
+    setupWireLayer();
+    if (_wireLayer)
+        _wireLayer->setSettings(settings);
+
     // Redraw
     update();
 }
@@ -283,12 +585,14 @@ Scene::clear()
 
     // Now that all the top-level items are safeguarded we can call the underlying scene's clear()
     QGraphicsScene::clear();
+    _wireLayer = nullptr;
 
     // No longer dirty
     clearIsDirty();
 
     // Setup the background again
     setupBackground();
+    setupWireLayer();
 }
 
 bool
@@ -307,6 +611,10 @@ Scene::addItem(const std::shared_ptr<Items::Item>& item)
     // Store the shared pointer to keep the item alive for the QGraphicsScene
     _items << item;
 
+    // Track the content bounds
+    trackItemBounds(*item);
+    itemBoundsChanged(*item);
+
     // Let the world know
     Q_EMIT itemAdded(item);
     Q_EMIT netlistChanged();
@@ -334,6 +642,19 @@ Scene::removeItem(const std::shared_ptr<Items::Item> item)
     // Remove shared pointer from local list to reduce instance count
     _items.removeAll(item);
 
+    // Stop tracking the content bounds
+    untrackItemBounds(*item);
+    if (const auto it = _itemBounds.constFind(item.get()); it != _itemBounds.cend()) {
+        const QRectF bounds = *it;
+        _itemBounds.erase(it);
+
+        // The bounds can only shrink if the item was on the edge
+        if (_contentBoundsValid && onEdge(bounds, _contentBounds))
+            _contentBoundsValid = false;
+
+        Q_EMIT contentChanged(bounds);
+    }
+
     // Update the corresponding scene area (redraw)
     update(itemBoundsToUpdate);
 
@@ -358,6 +679,50 @@ Scene::isBackground(const QGraphicsItem* item) const
     return dynamic_cast<const Background*>(item) == _background;
 }
 
+bool
+Scene::isWireLayer(const QGraphicsItem* item) const
+{
+    return _wireLayer && item == _wireLayer;
+}
+
+WireLayer*
+Scene::wireLayer() const
+{
+    return _wireLayer;
+}
+
+QRectF
+Scene::contentBounds() const
+{
+    if (!_contentBoundsValid) {
+        _contentBounds = { };
+        for (const QRectF& bounds : _itemBounds)
+            _contentBounds |= bounds;
+        _contentBoundsValid = true;
+    }
+
+    return _contentBounds;
+}
+
+void
+Scene::setSceneRect(const QRectF& rect)
+{
+    _sceneRectManaged = rect.isNull();
+    _managedSceneRect = { };
+
+    QGraphicsScene::setSceneRect(rect);
+
+    // Take over again
+    if (_sceneRectManaged)
+        growSceneRect(contentBounds());
+}
+
+void
+Scene::setSceneRect(qreal x, qreal y, qreal w, qreal h)
+{
+    setSceneRect(QRectF(x, y, w, h));
+}
+
 QList<std::shared_ptr<Items::Item>>
 Scene::items() const
 {
@@ -955,6 +1320,132 @@ Scene::setupBackground()
     QGraphicsScene::addItem(_background);
 }
 
+void
+Scene::trackItemBounds(Items::Item& item)
+{
+    untrackItemBounds(item);
+
+    auto& connections = _itemBoundsConnections[&item];
+    const Items::Item* raw = &item;
+    const auto boundsChanged = [this, raw] { itemBoundsChanged(*raw); };
+
+    // Children might be added or removed at any time (eg. wire net labels). Re-track once things settled.
+    const auto childrenChanged = [this, pointer = QPointer<Items::Item>(&item)] {
+        if (!pointer || !_itemBoundsConnections.contains(pointer.data()))
+            return;
+
+        trackItemBounds(*pointer);
+        itemBoundsChanged(*pointer);
+    };
+
+    // The item and all of its children
+    const auto track = [&](const auto& self, Items::Item& i) -> void {
+        connections << connect(&i, &Items::Item::moved, this, boundsChanged);
+        connections << connect(&i, &Items::Item::rotated, this, boundsChanged);
+        connections << connect(&i, &QGraphicsObject::childrenChanged, this, childrenChanged, Qt::QueuedConnection);
+        if (const auto rectItem = qobject_cast<Items::RectItem*>(&i))
+            connections << connect(rectItem, &Items::RectItem::sizeChanged, this, boundsChanged);
+        if (const auto wire = qobject_cast<Items::Wire*>(&i))
+            connections << connect(wire, &Items::Wire::boundingRectChanged, this, boundsChanged);
+        if (const auto label = qobject_cast<Items::Label*>(&i))
+            connections << connect(label, &Items::Label::textChanged, this, boundsChanged);
+
+        for (QGraphicsItem* child : i.childItems()) {
+            if (auto childItem = dynamic_cast<Items::Item*>(child); childItem)
+                self(self, *childItem);
+        }
+    };
+    track(track, item);
+}
+
+void
+Scene::untrackItemBounds(const Items::Item& item)
+{
+    const auto it = _itemBoundsConnections.find(&item);
+    if (it == _itemBoundsConnections.end())
+        return;
+
+    for (const auto& connection : std::as_const(it.value()))
+        disconnect(connection);
+    _itemBoundsConnections.erase(it);
+}
+
+void
+Scene::itemBoundsChanged(const Items::Item& item)
+{
+    const QRectF bounds = item.sceneBoundingRect() | item.mapRectToScene(item.childrenBoundingRect());
+
+    // Update bookkeeping
+    auto& known = _itemBounds[&item];
+    const QRectF previous = known;
+    known = bounds;
+
+    // Update the content bounds
+    if (_contentBoundsValid) {
+        // The bounds can only shrink if the item was on the edge
+        if (!previous.isNull() && !bounds.contains(previous) && onEdge(previous, _contentBounds))
+            _contentBoundsValid = false;
+        else
+            _contentBounds |= bounds;
+    }
+
+    growSceneRect(bounds);
+
+    Q_EMIT contentChanged(previous | bounds);
+}
+
+void
+Scene::growSceneRect(const QRectF& rect)
+{
+    // Sanity check
+    if (!_sceneRectManaged || rect.isNull())
+        return;
+
+    // Nothing to do if it's already covered
+    if (!_managedSceneRect.isNull() && _managedSceneRect.contains(rect))
+        return;
+
+    _managedSceneRect = _managedSceneRect.isNull() ? rect : _managedSceneRect.united(rect);
+
+    // Note: Once a scene rect was set, QGraphicsScene no longer re-computes the bounding rect of all items.
+    _settingSceneRect = true;
+    QGraphicsScene::setSceneRect(_managedSceneRect);
+    _settingSceneRect = false;
+}
+
+void
+Scene::setupWireLayer()
+{
+    // Remove if no longer needed
+    if (!_settings.batchedWireRendering) {
+        if (_wireLayer) {
+            QGraphicsScene::removeItem(_wireLayer);
+            delete _wireLayer;
+            _wireLayer = nullptr;
+        }
+        return;
+    }
+
+    // Already set up
+    if (_wireLayer)
+        return;
+
+    // Configure
+    _wireLayer = new WireLayer;
+    _wireLayer->setRect(sceneRect().adjusted(1, 1, -1, -1));
+    _wireLayer->setZValue(z_value_wire_layer);
+    _wireLayer->setSettings(_settings);
+
+    // Add to scene
+    QGraphicsScene::addItem(_wireLayer);
+
+    // Register the existing wires
+    for (const auto& wire : m_wire_manager->wires()) {
+        if (const auto w = dynamic_cast<const Items::Wire*>(wire.get()); w)
+            _wireLayer->invalidate(*w);
+    }
+}
+
 void
 Scene::updateNodeConnections(const Items::Node* node)
 {
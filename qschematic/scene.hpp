@@ -8,11 +8,14 @@
 
 #include <gpds/serialize.hpp>
 #include <QGraphicsScene>
+#include <QHash>
+#include <QList>
 #include <QUndoStack>
 
 #include <algorithm>
 #include <memory>
 #include <functional>
+#include <vector>
 
 namespace QSchematic
 {
@@ -26,6 +29,7 @@ namespace QSchematic
     }
 
     class Background;
+    class WireLayer;
 
     /**
      * The QSchematic Scene.
@@ -40,12 +44,18 @@ namespace QSchematic
         Q_OBJECT
         Q_DISABLE_COPY_MOVE(Scene)
 
+        friend class AutoSave;
+        friend class Journal;
+        friend class XmlLoader;
+
     public:
         static constexpr const char* gpds_name = "qschematic";
 
-        constexpr static std::size_t serdes_version = 2;
+        constexpr static std::size_t serdes_version = 3;
+        constexpr static std::size_t serdes_version_min = 2;    // Oldest version that can still be loaded
 
         qreal z_value_background = -10'000;
+        qreal z_value_wire_layer = -11;     // Just below the wires
 
         enum Mode
         {
@@ -67,6 +77,12 @@ namespace QSchematic
          */
         ~Scene() override;
 
+        /**
+         * Serialize the scene.
+         *
+         * @details The items & nets are serialized on up to Settings::serializationThreads threads. The result does
+         *          not depend on the number of threads.
+         */
         [[nodiscard]]
         gpds::container
         to_container() const override;
@@ -196,6 +212,57 @@ namespace QSchematic
         bool
         isBackground(const QGraphicsItem* item) const;
 
+        /**
+         * Check whether an item is the current wire layer item.
+         *
+         * @param item The item to check.
+         * @return Whether the item is the current wire layer item.
+         */
+        [[nodiscard]]
+        bool
+        isWireLayer(const QGraphicsItem* item) const;
+
+        /**
+         * Get the wire layer item.
+         *
+         * @return The wire layer item (if Settings::batchedWireRendering is enabled).
+         */
+        [[nodiscard]]
+        WireLayer*
+        wireLayer() const;
+
+        /**
+         * Get the combined bounding rect of all top-level items (including their children).
+         *
+         * @details This is maintained incrementally as items are added, removed, moved, resized or rotated. Removing
+         *          (or moving) an item on the edge of the bounds only marks the bounds for recomputation on the next
+         *          call.
+         *
+         * @return The content bounds.
+         */
+        [[nodiscard]]
+        QRectF
+        contentBounds() const;
+
+        /**
+         * Set the scene rect.
+         *
+         * @details Unless a scene rect was set explicitly, the scene rect grows with the content bounds (like
+         *          QGraphicsScene does) without having to re-compute the bounding rect of all items.
+         *
+         * @note This hides the non-virtual QGraphicsScene::setSceneRect(). Setting the scene rect through a
+         *       QGraphicsScene pointer (or the sceneRect property) bypasses this function. The scene notices the change
+         *       via QGraphicsScene::sceneRectChanged() and stops managing the scene rect. Call this function with a
+         *       null rect to re-enable the automatic scene rect.
+         *
+         * @param rect The scene rect. Pass a null rect to re-enable the automatic scene rect.
+         */
+        void
+        setSceneRect(const QRectF& rect);
+
+        void
+        setSceneRect(qreal x, qreal y, qreal w, qreal h);
+
         [[nodiscard]]
         QList<std::shared_ptr<Items::Item>>
         itemsAt(const QPointF& scenePos, Qt::SortOrder order = Qt::DescendingOrder) const;
@@ -284,6 +351,20 @@ namespace QSchematic
         void
         netlistChanged();
 
+        /**
+         * Signal emitted when the geometry of the content changed (items added, removed, moved, resized or rotated).
+         *
+         * @details This is driven by the content bounds tracking (see contentBounds()). Unlike connecting to
+         *          QGraphicsScene::changed(), connecting to this signal keeps the direct item to view updates of the
+         *          views.
+         *
+         * @note Changes of an item's appearance which do not affect its bounds are not reported.
+         *
+         * @param rect The affected scene rect (covering the old & the new bounds).
+         */
+        void
+        contentChanged(const QRectF& rect);
+
     protected:
         Settings _settings;
 
@@ -322,9 +403,46 @@ namespace QSchematic
         void wirePointMoved(wire& rawWire, int index);
 
     private:
+        /**
+         * Scope guard for loading.
+         *
+         * @details Resets the loading state (see loadItem(), loadNet() & loadConnectivity()) when entering and leaving
+         *          the scope. Therefore, the state of a load which failed halfway never leaks into the next one.
+         */
+        class LoadingScope
+        {
+        public:
+            explicit
+            LoadingScope(Scene& scene);
+            LoadingScope(const LoadingScope& other) = delete;
+            LoadingScope(LoadingScope&& other) = delete;
+            ~LoadingScope();
+
+            LoadingScope& operator=(const LoadingScope& rhs) = delete;
+            LoadingScope& operator=(LoadingScope&& rhs) = delete;
+
+        private:
+            Scene& _scene;
+        };
+
         void
         setupBackground();
 
+        void
+        setupWireLayer();
+
+        void
+        trackItemBounds(Items::Item& item);
+
+        void
+        untrackItemBounds(const Items::Item& item);
+
+        void
+        itemBoundsChanged(const Items::Item& item);
+
+        void
+        growSceneRect(const QRectF& rect);
+
         void
         setupNewItem(Items::Item& item);
 
@@ -334,6 +452,32 @@ namespace QSchematic
         void
         generateConnections();
 
+        [[nodiscard]]
+        gpds::container
+        saveSceneProperties() const;
+
+        void
+        loadSceneProperties(const gpds::container& container);
+
+        void
+        loadItem(const gpds::container& container);
+
+        void
+        loadNet(const gpds::container& container);
+
+        void
+        loadConnectivity(const gpds::container& container);
+
+        [[nodiscard]]
+        bool
+        restoreConnectivity(const gpds::container& container);
+
+        void
+        finishLoading();
+
+        void
+        resetLoading();
+
         void
         finishCurrentWire();
 
@@ -383,6 +527,17 @@ namespace QSchematic
         QTimer* _popupTimer = nullptr;
         std::shared_ptr<QGraphicsProxyWidget> _popup;
         Background* _background = nullptr;
+        WireLayer* _wireLayer = nullptr;
+        QHash<const Items::Item*, QRectF> _itemBounds;     // Last known bounds of each top-level item
+        QHash<const Items::Item*, QList<QMetaObject::Connection>> _itemBoundsConnections;
+        mutable QRectF _contentBounds;
+        mutable bool _contentBoundsValid = true;
+        QRectF _managedSceneRect;
+        bool _sceneRectManaged = true;
+        bool _settingSceneRect = false;
+        std::vector<std::shared_ptr<Items::Item>> _loadedItems;     // Items in file order while loading (null if not loadable)
+        std::vector<std::shared_ptr<Items::WireNet>> _loadedNets;   // Nets in file order while loading
+        bool _connectivityRestored = false;
     };
 
 }
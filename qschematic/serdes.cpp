@@ -0,0 +1,202 @@
+#include "serdes.hpp"
+#include "scene.hpp"
+
+#include <gpds/container.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <vector>
+
+using namespace QSchematic;
+
+namespace
+{
+
+    void
+    appendNumber(std::string& string, double value)
+    {
+        char buffer[32];
+        const auto [end, ec] = std::to_chars(std::begin(buffer), std::end(buffer), value);
+        if (ec == std::errc{ })
+            string.append(buffer, end);
+    }
+
+    /**
+     * Replace the v2 point containers of all wires within a container tree by packed points.
+     */
+    void
+    packWirePoints(gpds::container& container)
+    {
+        // Recurse
+        for (auto& [key, value] : container.values) {
+            if (!value.is_type<gpds::container*>())
+                continue;
+            if (gpds::container* child = value.get<gpds::container*>().value_or(nullptr))
+                packWirePoints(*child);
+        }
+
+        // Collect the points
+        std::vector<std::pair<int, QPointF>> points;
+        for (const gpds::container* point : container.get_values<gpds::container*>("point")) {
+            if (!point)
+                continue;
+
+            points.emplace_back(
+                point->get_attribute<int>("index").value_or(0),
+                QPointF(point->get_value<double>("x").value_or(0), point->get_value<double>("y").value_or(0))
+            );
+        }
+        if (points.empty())
+            return;
+
+        // Sort points by index
+        std::ranges::stable_sort(points, { }, &std::pair<int, QPointF>::first);
+        QVector<QPointF> packed;
+        packed.reserve(std::ssize(points));
+        for (const auto& [index, point] : points)
+            packed.append(point);
+
+        std::erase_if(container.values, [](const auto& pair) { return pair.first == "point"; });
+        container.add_value("points", Serdes::packPoints(packed));
+    }
+
+}
+
+std::string
+Serdes::packPoints(const QVector<QPointF>& points)
+{
+    std::string ret;
+    ret.reserve(points.size() * 12);
+
+    for (const QPointF& point : points) {
+        if (!ret.empty())
+            ret.push_back(' ');
+        appendNumber(ret, point.x());
+        ret.push_back(',');
+        appendNumber(ret, point.y());
+    }
+
+    return ret;
+}
+
+std::optional<QVector<QPointF>>
+Serdes::unpackPoints(std::string_view string)
+{
+    QVector<QPointF> points;
+
+    const char* it = string.data();
+    const char* end = string.data() + string.size();
+    const auto skipWhitespace = [&it, end] {
+        while (it != end && (*it == ' ' || *it == '\t' || *it == '\n' || *it == '\r'))
+            ++it;
+    };
+
+    skipWhitespace();
+    while (it != end) {
+        double x;
+        double y;
+
+        auto result = std::from_chars(it, end, x);
+        if (result.ec != std::errc{ } || result.ptr == end || *result.ptr != ',')
+            return std::nullopt;
+
+        result = std::from_chars(result.ptr + 1, end, y);
+        if (result.ec != std::errc{ })
+            return std::nullopt;
+
+        points.append(QPointF(x, y));
+        it = result.ptr;
+        skipWhitespace();
+    }
+
+    return points;
+}
+
+std::string
+Serdes::packIndices(const std::vector<int>& values, std::size_t tupleSize)
+{
+    std::string ret;
+    ret.reserve(values.size() * 4);
+
+    for (std::size_t i = 0; i < values.size(); i++) {
+        if (i > 0)
+            ret.push_back(i % tupleSize == 0 ? ' ' : ',');
+
+        char buffer[16];
+        const auto [end, ec] = std::to_chars(std::begin(buffer), std::end(buffer), values[i]);
+        if (ec == std::errc{ })
+            ret.append(buffer, end);
+    }
+
+    return ret;
+}
+
+std::optional<std::vector<int>>
+Serdes::unpackIndices(std::string_view string, std::size_t tupleSize)
+{
+    // Sanity check
+    if (tupleSize == 0)
+        return std::nullopt;
+
+    std::vector<int> values;
+
+    const char* it = string.data();
+    const char* end = string.data() + string.size();
+    while (it != end) {
+        // Separator
+        if (!values.empty()) {
+            const char expected = values.size() % tupleSize == 0 ? ' ' : ',';
+            if (*it != expected)
+                return std::nullopt;
+            ++it;
+        }
+
+        int value;
+        const auto result = std::from_chars(it, end, value);
+        if (result.ec != std::errc{ })
+            return std::nullopt;
+
+        values.push_back(value);
+        it = result.ptr;
+    }
+
+    if (values.size() % tupleSize != 0)
+        return std::nullopt;
+
+    return values;
+}
+
+bool
+Serdes::upgrade(gpds::container& root)
+{
+    const std::size_t version = root.get_attribute<std::size_t>("version").value_or(0);
+    if (version == Scene::serdes_version)
+        return true;
+    if (version < Scene::serdes_version_min || version > Scene::serdes_version)
+        return false;
+
+    // 2 -> 3
+    for (auto& [key, value] : root.values) {
+        if (key != "net" || !value.is_type<gpds::container*>())
+            continue;
+
+        gpds::container* net = value.get<gpds::container*>().value_or(nullptr);
+        if (!net)
+            continue;
+
+        // Wires
+        packWirePoints(*net);
+
+        // Drop labels which are hidden and empty
+        if (const gpds::container* label = net->get_value<gpds::container*>("label").value_or(nullptr)) {
+            const gpds::container* item = label->get_value<gpds::container*>("item").value_or(nullptr);
+            const bool visible = item && item->get_value<bool>("visible").value_or(true);
+            if (!visible && label->get_value<std::string>("text").value_or("").empty())
+                std::erase_if(net->values, [](const auto& pair) { return pair.first == "label"; });
+        }
+    }
+
+    root.attributes.map.insert_or_assign("version", std::to_string(Scene::serdes_version));
+
+    return true;
+}
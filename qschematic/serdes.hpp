@@ -0,0 +1,88 @@
+#pragma once
+
+#include <QPointF>
+#include <QVector>
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace gpds
+{
+    class container;
+}
+
+namespace QSchematic
+{
+
+    /**
+     * Helpers for the (de)serialization format of scenes.
+     *
+     * @details Format versions:
+     *            - 2: Wire points are stored as individual `point` containers with an `index` attribute.
+     *            - 3: Wire points are stored as a single packed `points` value. The labels of WireNets are only stored
+     *                 if they are visible or not empty. The connectivity (connector & junction records) is stored
+     *                 explicitly. Files without connectivity get their connections reconstructed geometrically.
+     */
+    class Serdes
+    {
+    public:
+        Serdes() = delete;
+
+        /**
+         * Pack a list of points into a string.
+         *
+         * @details The points are separated by spaces, the coordinates of each point by a comma (eg. `0,0 10,0 10,20`).
+         *          The coordinates use the shortest representation which round-trips exactly.
+         */
+        [[nodiscard]]
+        static
+        std::string
+        packPoints(const QVector<QPointF>& points);
+
+        /**
+         * Unpack a list of points packed with packPoints().
+         *
+         * @return The points or nothing if the string is malformed.
+         */
+        [[nodiscard]]
+        static
+        std::optional<QVector<QPointF>>
+        unpackPoints(std::string_view string);
+
+        /**
+         * Pack a list of index tuples into a string.
+         *
+         * @details The tuples are separated by spaces, the values of each tuple by a comma (eg. `0,1,2 3,4,5`).
+         *
+         * @param values The values of all tuples.
+         * @param tupleSize The number of values per tuple.
+         */
+        [[nodiscard]]
+        static
+        std::string
+        packIndices(const std::vector<int>& values, std::size_t tupleSize);
+
+        /**
+         * Unpack a list of index tuples packed with packIndices().
+         *
+         * @return The values of all tuples or nothing if the string is malformed.
+         */
+        [[nodiscard]]
+        static
+        std::optional<std::vector<int>>
+        unpackIndices(std::string_view string, std::size_t tupleSize);
+
+        /**
+         * Convert the container of a scene to the current format version.
+         *
+         * @param root The root container of the scene (as produced by Scene::to_container()).
+         * @return Success indicator. Fails if the version is not supported.
+         */
+        static
+        bool
+        upgrade(gpds::container& root);
+    };
+
+}
@@ -18,6 +18,32 @@ namespace QSchematic
     class Settings
     {
     public:
+        /**
+         * How the view repaints its viewport.
+         *
+         * @note These map to QGraphicsView::ViewportUpdateMode.
+         */
+        enum class ViewportUpdate
+        {
+            Full,           // Repaint the entire viewport on any change
+            Minimal,        // Repaint the minimal dirty region
+            Smart,          // Repaint the dirty region or its bounding rect (whatever Qt deems cheaper)
+            BoundingRect,   // Repaint the bounding rect of all dirty regions
+        };
+
+        /**
+         * Cache policy of cacheable items (nodes, labels & connectors).
+         *
+         * @note These map to QGraphicsItem::CacheMode. The item coordinate cache is shared by all views showing the
+         *       same scene. The device coordinate cache is kept per view and is re-rendered whenever the zoom changes.
+         */
+        enum class ItemCache
+        {
+            None,
+            ItemCoordinate,
+            DeviceCoordinate,
+        };
+
         bool debug                  = false;
         int gridSize                = 20;
         int gridPointSize           = 3;
@@ -28,6 +54,18 @@ namespace QSchematic
         bool preserveStraightAngles = true;
         bool antialiasing           = true;
         std::chrono::milliseconds popupDelay{ 400 };
+        bool batchedWireRendering   = false;    // Render plain wires from a single scene-level layer (see WireLayer)
+        ViewportUpdate viewportUpdate = ViewportUpdate::Full;
+        bool progressiveRendering   = false;    // Show a rescaled copy of the last frame while zooming/panning
+        std::chrono::milliseconds progressiveRenderingDelay{ 150 };     // Idle time before rendering at full quality
+        ItemCache itemCache = ItemCache::None;
+        int serializationThreads    = 1;        // Threads used by Scene::to_container(). Zero uses the hardware concurrency.
+
+        // Level of detail. A level of detail of 1.0 means that one scene unit maps to one device pixel.
+        qreal lodTextMinPixelSize   = 4.0;      // Text smaller than this many device pixels is not rendered
+        qreal lodNodeSimplified     = 0.35;     // Below this level of detail, nodes are rendered as plain rectangles
+        qreal lodConnectorHidden    = 0.5;      // Below this level of detail, connector symbols are not rendered
+        qreal lodWireHairline       = 0.35;     // Below this level of detail, wires are rendered as hairlines
 
         // Construction
         Settings() = default;
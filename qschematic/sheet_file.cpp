@@ -0,0 +1,908 @@
+#include "sheet_file.hpp"
+#include "archiver_binary.hpp"
+#include "netlistgenerator.hpp"
+#include "scene.hpp"
+#include "view.hpp"
+#include "items/connector.hpp"
+#include "items/itemfactory.hpp"
+#include "items/node.hpp"
+#include "items/wire.hpp"
+#include "items/wirenet.hpp"
+
+#include <QSaveFile>
+#include <QScrollBar>
+#include <QTimer>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+using namespace QSchematic;
+
+namespace
+{
+
+    constexpr char MAGIC[4] = { 'Q', 'S', 'S', 'F' };
+    constexpr const char* ITEM_ROOT = "item";
+    constexpr const char* NET_ROOT = "net";
+    constexpr double MAX_TILES = 1 << 20;
+    constexpr qreal VISIBLE_MARGIN = 0.25;
+
+    /**
+     * Convert between the byte order of the file (little endian) and the byte order of the host.
+     */
+    template<typename T>
+    void
+    swapBytes(T& value)
+    {
+        if constexpr (std::endian::native == std::endian::little)
+            return;
+        else if constexpr (requires { value.swapFields(); })
+            value.swapFields();
+        else if constexpr (std::is_enum_v<T>)
+            value = static_cast<T>(std::byteswap(std::to_underlying(value)));
+        else if constexpr (std::is_same_v<T, double>)
+            value = std::bit_cast<double>(std::byteswap(std::bit_cast<std::uint64_t>(value)));
+        else
+            value = std::byteswap(value);
+    }
+
+    template<typename T>
+    void
+    store(char* destination, T value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        swapBytes(value);
+        std::memcpy(destination, &value, sizeof(T));
+    }
+
+    template<typename T>
+    void
+    append(QByteArray& data, const T& value)
+    {
+        const auto size = data.size();
+        data.resize(size + qsizetype(sizeof(T)));
+        store(data.data() + size, value);
+    }
+
+    void
+    align(QByteArray& data)
+    {
+        while (data.size() % 8)
+            data.append('\0');
+    }
+
+    [[nodiscard]]
+    std::string
+    serialize(const gpds::container& container, std::string_view rootName)
+    {
+        std::ostringstream stream;
+        if (!ArchiverBinary().save(stream, container, rootName).first)
+            return { };
+
+        return stream.str();
+    }
+
+    /**
+     * Table of interned UTF-8 strings.
+     */
+    class StringTable
+    {
+    public:
+        std::uint32_t
+        intern(const QString& string)
+        {
+            const auto [it, inserted] = m_ids.try_emplace(string, static_cast<std::uint32_t>(m_strings.size()));
+            if (inserted)
+                m_strings.push_back(string.toUtf8());
+
+            return it->second;
+        }
+
+        [[nodiscard]]
+        std::uint32_t
+        count() const
+        {
+            return static_cast<std::uint32_t>(m_strings.size());
+        }
+
+        [[nodiscard]]
+        QByteArray
+        data() const
+        {
+            QByteArray ret;
+
+            // Offsets
+            std::uint32_t offset = 0;
+            for (const QByteArray& string : m_strings) {
+                append(ret, offset);
+                offset += static_cast<std::uint32_t>(string.size());
+            }
+            append(ret, offset);
+
+            // Strings
+            for (const QByteArray& string : m_strings)
+                ret.append(string);
+
+            return ret;
+        }
+
+    private:
+        std::unordered_map<QString, std::uint32_t> m_ids;
+        std::vector<QByteArray> m_strings;
+    };
+
+}
+
+struct SheetFile::Header
+{
+    char magic[4];
+    std::uint16_t version;
+    std::uint16_t reserved;
+    std::uint32_t recordCount;
+    std::uint32_t stringCount;
+    double sceneRect[4];
+    double gridOrigin[2];
+    double tileSize;
+    std::uint32_t columns;
+    std::uint32_t rows;
+    std::uint64_t tilesOffset;
+    std::uint64_t tileRecordsOffset;
+    std::uint64_t tileRecordCount;
+    std::uint64_t directoryOffset;
+    std::uint64_t stringsOffset;
+    std::uint64_t connectivityOffset;
+    std::uint64_t connectivitySize;
+
+    void
+    swapFields()
+    {
+        swapBytes(version);
+        swapBytes(reserved);
+        swapBytes(recordCount);
+        swapBytes(stringCount);
+        for (double& v : sceneRect)
+            swapBytes(v);
+        for (double& v : gridOrigin)
+            swapBytes(v);
+        swapBytes(tileSize);
+        swapBytes(columns);
+        swapBytes(rows);
+        swapBytes(tilesOffset);
+        swapBytes(tileRecordsOffset);
+        swapBytes(tileRecordCount);
+        swapBytes(directoryOffset);
+        swapBytes(stringsOffset);
+        swapBytes(connectivityOffset);
+        swapBytes(connectivitySize);
+    }
+};
+
+struct SheetFile::Record
+{
+    double rect[4];
+    std::uint64_t offset;
+    std::uint32_t size;
+    Kind kind;
+
+    void
+    swapFields()
+    {
+        for (double& v : rect)
+            swapBytes(v);
+        swapBytes(offset);
+        swapBytes(size);
+        swapBytes(kind);
+    }
+};
+
+template<typename T>
+T
+SheetFile::read(std::uint64_t offset) const
+{
+    // Note: The data is copied out as the mapped memory is not necessarily aligned for T
+    T value;
+    std::memcpy(&value, m_data + offset, sizeof(T));
+    swapBytes(value);
+
+    return value;
+}
+
+bool
+SheetFile::write(const Scene& scene, const QString& filePath, qreal tileSize)
+{
+    static_assert(std::is_trivially_copyable_v<Header> && sizeof(Header) == 136);
+    static_assert(std::is_trivially_copyable_v<Record> && sizeof(Record) == 48);
+
+    // Sanity check
+    if (tileSize <= 0)
+        return false;
+
+    struct Entry
+    {
+        QRectF rect;
+        Kind kind;
+        std::string data;
+        const void* key = nullptr;
+        std::vector<QRectF> parts;      // The regions the entry actually covers
+        std::uint32_t tile = 0;
+        std::vector<std::uint32_t> tiles;
+    };
+    std::vector<Entry> entries;
+
+    // Items
+    for (const auto& item : scene.items()) {
+        // Sanity check
+        if (!item) [[unlikely]]
+            continue;
+
+        // Ignore wire items as they will be added by the nets below
+        if (std::dynamic_pointer_cast<Items::Wire>(item))
+            continue;
+
+        const Kind kind = std::dynamic_pointer_cast<Items::Node>(item) ? Kind::Node : Kind::Item;
+        const QRectF rect = item->sceneBoundingRect();
+        entries.push_back({ rect, kind, serialize(item->to_container(), ITEM_ROOT), item.get(), { rect } });
+    }
+
+    // Nets
+    std::unordered_map<const wire_system::wire*, const void*> wireNets;
+    for (const auto& net : scene.wire_manager()->nets()) {
+        auto wireNet = std::dynamic_pointer_cast<Items::WireNet>(net);
+        if (!wireNet)
+            continue;
+
+        // A net (eg. GND) can span the entire scene. Only the regions of its wires are covered.
+        QRectF rect;
+        std::vector<QRectF> parts;
+        for (const auto& wire : wireNet->wires()) {
+            if (auto wireItem = std::dynamic_pointer_cast<Items::Wire>(wire)) {
+                parts.push_back(wireItem->sceneBoundingRect());
+                rect |= parts.back();
+            }
+            wireNets.emplace(wire.get(), wireNet.get());
+        }
+
+        entries.push_back({ rect, Kind::Net, serialize(wireNet->to_container(), NET_ROOT), wireNet.get(), std::move(parts) });
+    }
+
+    // Grid
+    QRectF bounds;
+    for (const auto& entry : entries)
+        bounds |= entry.rect;
+    while ((bounds.width() / tileSize) * (bounds.height() / tileSize) > MAX_TILES)
+        tileSize *= 2;
+    const auto columns = std::max<std::uint32_t>(1, static_cast<std::uint32_t>(std::ceil(bounds.width() / tileSize)));
+    const auto rows = std::max<std::uint32_t>(1, static_cast<std::uint32_t>(std::ceil(bounds.height() / tileSize)));
+
+    // Sort the entries into the tiles
+    // Each entry is registered in every tile covered by one of its parts. The directory is ordered by the tile
+    // containing the top-left corner of each entry to keep neighbouring entries close together.
+    const auto column = [&](qreal x) {
+        return std::clamp<qint64>(std::floor((x - bounds.left()) / tileSize), 0, columns - 1);
+    };
+    const auto row = [&](qreal y) {
+        return std::clamp<qint64>(std::floor((y - bounds.top()) / tileSize), 0, rows - 1);
+    };
+    std::uint64_t tileRecordCount = 0;
+    for (auto& entry : entries) {
+        entry.tile = static_cast<std::uint32_t>(row(entry.rect.top()) * columns + column(entry.rect.left()));
+
+        for (const QRectF& part : entry.parts) {
+            for (qint64 r = row(part.top()); r <= row(part.bottom()); r++) {
+                for (qint64 c = column(part.left()); c <= column(part.right()); c++)
+                    entry.tiles.push_back(static_cast<std::uint32_t>(r * columns + c));
+            }
+        }
+        std::ranges::sort(entry.tiles);
+        const auto [first, last] = std::ranges::unique(entry.tiles);
+        entry.tiles.erase(first, last);
+
+        tileRecordCount += std::size(entry.tiles);
+    }
+    if (tileRecordCount > std::numeric_limits<std::uint32_t>::max())
+        return false;
+    std::ranges::stable_sort(entries, [](const Entry& a, const Entry& b) {
+        if (a.tile != b.tile)
+            return a.tile < b.tile;
+        return a.rect.left() < b.rect.left();
+    });
+
+    std::unordered_map<const void*, std::uint32_t> indices;
+    for (std::uint32_t i = 0; i < std::size(entries); i++)
+        indices.emplace(entries[i].key, i);
+
+    // Connectivity
+    StringTable strings;
+    QByteArray connectivity;
+    {
+        QSchematic::Netlist<Items::Node*, Items::Connector*, Items::Wire*> netlist;
+        NetlistGenerator::generate(netlist, scene);
+
+        append(connectivity, static_cast<std::uint32_t>(std::size(netlist.nets)));
+        for (const auto& net : netlist.nets) {
+            append(connectivity, strings.intern(net.name));
+            append(connectivity, static_cast<std::uint32_t>(net.anonymous ? 1 : 0));
+
+            // Wires (identified by the record of their net)
+            std::vector<std::uint32_t> wires;
+            for (const Items::Wire* wire : net.wires) {
+                const auto wireNet = wireNets.find(wire);
+                if (wireNet != std::cend(wireNets))
+                    wires.push_back(indices.at(wireNet->second));
+            }
+            std::ranges::sort(wires);
+            const auto [first, last] = std::ranges::unique(wires);
+            wires.erase(first, last);
+            append(connectivity, static_cast<std::uint32_t>(std::size(wires)));
+            for (const std::uint32_t wire : wires)
+                append(connectivity, wire);
+
+            // Pins
+            std::vector<Pin> pins;
+            for (const auto& [connector, node] : net.connectorNodePairs) {
+                const auto nodeIndex = indices.find(static_cast<const Items::Item*>(node));
+                if (nodeIndex == std::cend(indices))
+                    continue;
+
+                const auto& connectors = node->connectors();
+                const auto it = std::ranges::find_if(connectors, [connector](const auto& c) { return c.get() == connector; });
+                if (it == std::cend(connectors))
+                    continue;
+
+                pins.push_back({ nodeIndex->second, static_cast<std::uint32_t>(std::distance(std::cbegin(connectors), it)), strings.intern(connector->text()) });
+            }
+            append(connectivity, static_cast<std::uint32_t>(std::size(pins)));
+            for (const Pin& pin : pins) {
+                append(connectivity, pin.node);
+                append(connectivity, pin.index);
+                append(connectivity, pin.name);
+            }
+        }
+    }
+
+    // Layout: header, tiles, directory, strings, connectivity, blobs
+    Header header{ };
+    std::ranges::copy(MAGIC, header.magic);
+    header.version = format_version;
+    header.recordCount = static_cast<std::uint32_t>(std::size(entries));
+    header.stringCount = strings.count();
+    const QRectF sceneRect = scene.sceneRect();
+    header.sceneRect[0] = sceneRect.x();
+    header.sceneRect[1] = sceneRect.y();
+    header.sceneRect[2] = sceneRect.width();
+    header.sceneRect[3] = sceneRect.height();
+    header.gridOrigin[0] = bounds.left();
+    header.gridOrigin[1] = bounds.top();
+    header.tileSize = tileSize;
+    header.tileRecordCount = tileRecordCount;
+    header.columns = columns;
+    header.rows = rows;
+
+    QByteArray data;
+    append(data, header);
+
+    // Tiles: Index of the first tile record of each tile & the tile records (the directory records of each tile)
+    {
+        std::vector<std::uint32_t> tiles(std::size_t(columns) * rows + 1, 0);
+        for (const auto& entry : entries) {
+            for (const std::uint32_t tile : entry.tiles)
+                tiles[tile + 1]++;
+        }
+        for (std::size_t i = 1; i < std::size(tiles); i++)
+            tiles[i] += tiles[i - 1];
+
+        std::vector<std::uint32_t> tileRecords(tileRecordCount);
+        std::vector<std::uint32_t> next(std::cbegin(tiles), std::prev(std::cend(tiles)));
+        for (std::uint32_t i = 0; i < std::size(entries); i++) {
+            for (const std::uint32_t tile : entries[i].tiles)
+                tileRecords[next[tile]++] = i;
+        }
+
+        align(data);
+        header.tilesOffset = data.size();
+        for (const std::uint32_t tile : tiles)
+            append(data, tile);
+
+        align(data);
+        header.tileRecordsOffset = data.size();
+        for (const std::uint32_t record : tileRecords)
+            append(data, record);
+    }
+
+    // Directory (filled in below)
+    align(data);
+    header.directoryOffset = data.size();
+    data.append(qsizetype(sizeof(Record) * std::size(entries)), '\0');
+
+    // Strings
+    align(data);
+    header.stringsOffset = data.size();
+    data.append(strings.data());
+
+    // Connectivity
+    align(data);
+    header.connectivityOffset = data.size();
+    header.connectivitySize = connectivity.size();
+    data.append(connectivity);
+
+    // Blobs
+    for (std::size_t i = 0; i < std::size(entries); i++) {
+        const auto& entry = entries[i];
+
+        align(data);
+        Record record{ };
+        record.rect[0] = entry.rect.x();
+        record.rect[1] = entry.rect.y();
+        record.rect[2] = entry.rect.width();
+        record.rect[3] = entry.rect.height();
+        record.offset = data.size();
+        record.size = static_cast<std::uint32_t>(entry.data.size());
+        record.kind = entry.kind;
+        store(data.data() + header.directoryOffset + i * sizeof(Record), record);
+
+        data.append(entry.data.data(), qsizetype(entry.data.size()));
+    }
+
+    // Header
+    store(data.data(), header);
+
+    // Write
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+    if (file.write(data) != data.size())
+        return false;
+
+    return file.commit();
+}
+
+SheetFile::SheetFile(QObject* parent) :
+    QObject(parent)
+{
+    // Coalesce view changes
+    m_timer = new QTimer(this);
+    m_timer->setSingleShot(true);
+    m_timer->setInterval(0);
+    connect(m_timer, &QTimer::timeout, this, &SheetFile::materializeVisible);
+}
+
+SheetFile::~SheetFile()
+{
+    close();
+}
+
+bool
+SheetFile::open(const QString& filePath)
+{
+    close();
+
+    // Map the file
+    m_file.setFileName(filePath);
+    if (!m_file.open(QIODevice::ReadOnly))
+        return false;
+    m_size = m_file.size();
+    if (m_size < sizeof(Header) || !(m_data = m_file.map(0, qint64(m_size)))) {
+        close();
+        return false;
+    }
+
+    // Validate the header
+    auto header = std::make_unique<Header>(read<Header>(0));
+    const auto fits = [this](std::uint64_t offset, std::uint64_t size) {
+        return offset <= m_size && size <= m_size - offset;
+    };
+    const bool valid =
+        std::equal(std::cbegin(MAGIC), std::cend(MAGIC), std::cbegin(header->magic)) &&
+        header->version == format_version &&
+        std::isfinite(header->gridOrigin[0]) && std::isfinite(header->gridOrigin[1]) &&
+        std::isfinite(header->tileSize) && header->tileSize > 0 &&
+        header->columns > 0 && header->rows > 0 &&
+        std::uint64_t(header->columns) * header->rows < m_size &&
+        fits(header->tilesOffset, (std::uint64_t(header->columns) * header->rows + 1) * sizeof(std::uint32_t)) &&
+        header->tileRecordCount <= m_size &&
+        fits(header->tileRecordsOffset, header->tileRecordCount * sizeof(std::uint32_t)) &&
+        fits(header->directoryOffset, std::uint64_t(header->recordCount) * sizeof(Record)) &&
+        fits(header->stringsOffset, (std::uint64_t(header->stringCount) + 1) * sizeof(std::uint32_t)) &&
+        fits(header->connectivityOffset, header->connectivitySize);
+    if (!valid) {
+        close();
+        return false;
+    }
+
+    m_header = std::move(header);
+    m_materialized.assign(m_header->recordCount, false);
+
+    return true;
+}
+
+void
+SheetFile::close()
+{
+    if (m_data)
+        m_file.unmap(const_cast<uchar*>(m_data));
+    m_file.close();
+
+    m_data = nullptr;
+    m_size = 0;
+    m_header.reset();
+    m_materialized.clear();
+    m_connectors.clear();
+    m_wireEnds.clear();
+}
+
+bool
+SheetFile::isOpen() const
+{
+    return m_header != nullptr;
+}
+
+QRectF
+SheetFile::sceneRect() const
+{
+    if (!isOpen())
+        return { };
+
+    return { m_header->sceneRect[0], m_header->sceneRect[1], m_header->sceneRect[2], m_header->sceneRect[3] };
+}
+
+std::uint32_t
+SheetFile::count() const
+{
+    if (!isOpen())
+        return 0;
+
+    return m_header->recordCount;
+}
+
+SheetFile::Kind
+SheetFile::kind(std::uint32_t record) const
+{
+    return this->record(record).kind;
+}
+
+QRectF
+SheetFile::bounds(std::uint32_t record) const
+{
+    const Record r = this->record(record);
+
+    return { r.rect[0], r.rect[1], r.rect[2], r.rect[3] };
+}
+
+std::vector<std::uint32_t>
+SheetFile::records(const QRectF& rect) const
+{
+    if (!isOpen())
+        return { };
+
+    const Header& h = *m_header;
+    const auto column = [&h](qreal x) {
+        return std::clamp<qint64>(std::floor((x - h.gridOrigin[0]) / h.tileSize), 0, qint64(h.columns) - 1);
+    };
+    const auto row = [&h](qreal y) {
+        return std::clamp<qint64>(std::floor((y - h.gridOrigin[1]) / h.tileSize), 0, qint64(h.rows) - 1);
+    };
+    const auto tile = [this, &h](qint64 index) {
+        return std::min<std::uint64_t>(read<std::uint32_t>(h.tilesOffset + index * sizeof(std::uint32_t)), h.tileRecordCount);
+    };
+
+    // Collect the records of all tiles intersecting the region
+    // Note: Records are registered in every tile they cover. Therefore, they can show up more than once.
+    std::vector<std::uint32_t> candidates;
+    const qint64 firstColumn = column(rect.left());
+    const qint64 lastColumn = column(rect.right());
+    for (qint64 r = row(rect.top()); r <= row(rect.bottom()); r++) {
+        // The tiles of a row are stored contiguously
+        const std::uint64_t first = tile(r * h.columns + firstColumn);
+        const std::uint64_t last = tile(r * h.columns + lastColumn + 1);
+        for (std::uint64_t i = first; i < last; i++) {
+            const auto index = read<std::uint32_t>(h.tileRecordsOffset + i * sizeof(std::uint32_t));
+            if (index < h.recordCount)
+                candidates.push_back(index);
+        }
+    }
+    std::ranges::sort(candidates);
+    const auto [first, last] = std::ranges::unique(candidates);
+    candidates.erase(first, last);
+
+    std::vector<std::uint32_t> ret;
+    for (const std::uint32_t i : candidates) {
+        const QRectF bounds = this->bounds(i);
+        if (bounds.left() <= rect.right() && bounds.right() >= rect.left() &&
+            bounds.top() <= rect.bottom() && bounds.bottom() >= rect.top())
+            ret.push_back(i);
+    }
+
+    return ret;
+}
+
+std::shared_ptr<Items::Item>
+SheetFile::item(std::uint32_t record) const
+{
+    // Sanity check
+    if (record >= count() || kind(record) == Kind::Net)
+        return { };
+
+    gpds::container container;
+    if (!ArchiverBinary().loadFromMemory(blob(record), container, ITEM_ROOT).first)
+        return { };
+
+    auto item = Items::Factory::instance().from_container(container);
+    if (!item)
+        return { };
+    item->from_container(container);
+
+    return item;
+}
+
+QString
+SheetFile::string(std::uint32_t id) const
+{
+    // Sanity check
+    if (!isOpen() || id >= m_header->stringCount)
+        return { };
+
+    const std::uint64_t table = m_header->stringsOffset;
+    const std::uint64_t base = table + (std::uint64_t(m_header->stringCount) + 1) * sizeof(std::uint32_t);
+    const std::uint32_t begin = read<std::uint32_t>(table + id * sizeof(std::uint32_t));
+    const std::uint32_t end = read<std::uint32_t>(table + (id + 1) * sizeof(std::uint32_t));
+    if (end < begin || base + end > m_size)
+        return { };
+
+    return QString::fromUtf8(reinterpret_cast<const char*>(m_data + base + begin), end - begin);
+}
+
+bool
+SheetFile::netlist(Netlist& netlist) const
+{
+    if (!isOpen())
+        return false;
+
+    netlist.nodes.clear();
+    netlist.nets.clear();
+
+    // Nodes
+    for (std::uint32_t i = 0; i < count(); i++) {
+        if (kind(i) == Kind::Node)
+            netlist.nodes.push_back(i);
+    }
+
+    // Nets
+    std::uint64_t offset = m_header->connectivityOffset;
+    const std::uint64_t end = offset + m_header->connectivitySize;
+    const auto next = [this, &offset, end](std::uint32_t& value) {
+        if (end - offset < sizeof(std::uint32_t))
+            return false;
+        value = read<std::uint32_t>(offset);
+        offset += sizeof(std::uint32_t);
+        return true;
+    };
+
+    std::uint32_t netCount;
+    if (!next(netCount))
+        return false;
+    for (std::uint32_t i = 0; i < netCount; i++) {
+        decltype(netlist.nets)::value_type net;
+
+        // Name
+        std::uint32_t name;
+        std::uint32_t anonymous;
+        if (!next(name) || !next(anonymous))
+            return false;
+        net.name = string(name);
+        net.anonymous = anonymous != 0;
+
+        // Wires
+        std::uint32_t wireCount;
+        if (!next(wireCount))
+            return false;
+        for (std::uint32_t j = 0; j < wireCount; j++) {
+            std::uint32_t wire;
+            if (!next(wire))
+                return false;
+            net.wires.push_back(wire);
+        }
+
+        // Pins
+        std::uint32_t pinCount;
+        if (!next(pinCount))
+            return false;
+        for (std::uint32_t j = 0; j < pinCount; j++) {
+            Pin pin;
+            if (!next(pin.node) || !next(pin.index) || !next(pin.name))
+                return false;
+
+            net.nodes.push_back(pin.node);
+            net.connectors.push_back(pin);
+            net.connectorNodePairs.emplace(pin, pin.node);
+        }
+
+        netlist.nets.push_back(std::move(net));
+    }
+
+    return true;
+}
+
+void
+SheetFile::setScene(Scene* scene)
+{
+    m_scene = scene;
+    m_materialized.assign(count(), false);
+    m_connectors.clear();
+    m_wireEnds.clear();
+
+    if (m_scene && isOpen())
+        m_scene->setSceneRect(sceneRect());
+
+    m_timer->start();
+}
+
+void
+SheetFile::setView(View* view)
+{
+    for (const auto& connection : m_viewConnections)
+        disconnect(connection);
+    m_viewConnections.clear();
+
+    m_view = view;
+    if (m_view) {
+        const auto schedule = [this] { m_timer->start(); };
+        m_viewConnections << connect(m_view->horizontalScrollBar(), &QScrollBar::valueChanged, this, schedule);
+        m_viewConnections << connect(m_view->verticalScrollBar(), &QScrollBar::valueChanged, this, schedule);
+        m_viewConnections << connect(m_view->horizontalScrollBar(), &QScrollBar::rangeChanged, this, schedule);
+        m_viewConnections << connect(m_view->verticalScrollBar(), &QScrollBar::rangeChanged, this, schedule);
+        m_viewConnections << connect(m_view, &View::zoomChanged, this, schedule);
+    }
+
+    m_timer->start();
+}
+
+std::size_t
+SheetFile::materialize(const QRectF& rect)
+{
+    // Sanity check
+    if (!isOpen() || !m_scene)
+        return 0;
+
+    auto manager = m_scene->wire_manager();
+    std::vector<std::shared_ptr<Items::Connector>> newConnectors;
+    std::vector<std::shared_ptr<Items::WireNet>> newNets;
+    std::size_t materializedCount = 0;
+
+    for (const std::uint32_t index : records(rect)) {
+        if (m_materialized[index])
+            continue;
+        m_materialized[index] = true;
+
+        // Net
+        if (kind(index) == Kind::Net) {
+            gpds::container container;
+            if (!ArchiverBinary().loadFromMemory(blob(index), container, NET_ROOT).first)
+                continue;
+
+            auto net = std::make_shared<Items::WireNet>();
+            net->setScene(m_scene);
+            net->set_manager(manager.get());
+            net->from_container(container);
+            manager->add_net(net);
+
+            for (const auto& wire : net->wires()) {
+                const auto& points = wire->points();
+                if (points.isEmpty())
+                    continue;
+                m_wireEnds.insert(points.first().toPoint(), wire);
+                m_wireEnds.insert(points.last().toPoint(), wire);
+            }
+
+            newNets.push_back(std::move(net));
+        }
+
+        // Item
+        else {
+            auto item = this->item(index);
+            if (!item)
+                continue;
+            m_scene->addItem(item);
+
+            if (auto node = std::dynamic_pointer_cast<Items::Node>(item)) {
+                for (const auto& connector : node->connectors()) {
+                    m_connectors.insert(connector->position().toPoint(), connector);
+                    newConnectors.push_back(connector);
+                }
+            }
+        }
+
+        materializedCount++;
+    }
+
+    if (materializedCount == 0)
+        return 0;
+
+    // Attach the wires of the new nets to the materialized connectors
+    // Note: The entries might have been moved since they got materialized.
+    for (const auto& net : newNets) {
+        for (const auto& wire : net->wires()) {
+            const auto& points = wire->points();
+            if (points.isEmpty())
+                continue;
+
+            for (const QPoint point : { points.first().toPoint(), points.last().toPoint() }) {
+                for (auto it = m_connectors.constFind(point); it != m_connectors.cend() && it.key() == point; ++it) {
+                    const auto connector = it.value().lock();
+                    if (connector && connector->position().toPoint() == point)
+                        manager->attach_wire_to_connector(wire.get(), connector.get());
+                }
+            }
+        }
+    }
+
+    // Attach the connectors of the new nodes to the materialized wires
+    for (const auto& connector : newConnectors) {
+        if (manager->attached_wire(connector.get()))
+            continue;
+
+        const QPoint point = connector->position().toPoint();
+        for (auto it = m_wireEnds.constFind(point); it != m_wireEnds.cend() && it.key() == point; ++it) {
+            const auto wire = it.value().lock();
+            if (!wire || wire->points().isEmpty())
+                continue;
+            if (wire->points().first().toPoint() == point || wire->points().last().toPoint() == point) {
+                manager->attach_wire_to_connector(wire.get(), connector.get());
+                break;
+            }
+        }
+    }
+
+    manager->generate_junctions();
+
+    Q_EMIT materialized(materializedCount);
+
+    return materializedCount;
+}
+
+bool
+SheetFile::isMaterialized(std::uint32_t record) const
+{
+    return record < std::size(m_materialized) && m_materialized[record];
+}
+
+SheetFile::Record
+SheetFile::record(std::uint32_t index) const
+{
+    // Sanity check
+    if (index >= count())
+        return { };
+
+    return read<Record>(m_header->directoryOffset + std::uint64_t(index) * sizeof(Record));
+}
+
+std::string_view
+SheetFile::blob(std::uint32_t record) const
+{
+    const Record r = this->record(record);
+    if (r.offset > m_size || r.size > m_size - r.offset)
+        return { };
+
+    return { reinterpret_cast<const char*>(m_data + r.offset), r.size };
+}
+
+void
+SheetFile::materializeVisible()
+{
+    if (!m_view)
+        return;
+
+    // Materialize a bit more than what is visible to reduce pop-in while panning
+    const QRectF visible = m_view->mapToScene(m_view->viewport()->rect()).boundingRect();
+    const qreal dx = visible.width() * VISIBLE_MARGIN;
+    const qreal dy = visible.height() * VISIBLE_MARGIN;
+
+    materialize(visible.adjusted(-dx, -dy, dx, dy));
+}
@@ -0,0 +1,270 @@
+#pragma once
+
+#include "netlist.hpp"
+
+#include <QFile>
+#include <QMultiHash>
+#include <QObject>
+#include <QPoint>
+#include <QPointer>
+#include <QRectF>
+#include <QString>
+
+#include <compare>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+class QTimer;
+
+namespace wire_system
+{
+    class wire;
+}
+
+namespace QSchematic
+{
+
+    namespace Items
+    {
+        class Connector;
+        class Item;
+    }
+
+    class Scene;
+    class View;
+
+    /**
+     * A scene file which can be memory mapped.
+     *
+     * @details The file contains a directory of all top-level items & nets. Each directory record holds the scene
+     *          bounding rect of the entry and the location of its (binary) serialized data. The records are registered
+     *          in every tile of a uniform grid they cover (nets only in the tiles covered by their wires). Looking up
+     *          the entries within a region therefore only touches the directory records of the tiles intersecting
+     *          that region.
+     *          The entries are only materialized into QGraphicsItems once their region becomes visible in the attached
+     *          view or when explicitly requested via materialize().
+     *          The file also contains the connectivity (nets & the pins they connect) captured when the file was
+     *          written. This allows generating a netlist without materializing any items.
+     *
+     * @note The file is intended for read-mostly workflows (reviewing, printing, netlisting). Edits are not written
+     *       back. Use write() to create a new file from a scene.
+     */
+    class SheetFile :
+        public QObject
+    {
+        Q_OBJECT
+        Q_DISABLE_COPY_MOVE(SheetFile)
+
+    public:
+        static constexpr std::uint16_t format_version = 3;
+        static constexpr qreal default_tile_size = 1000;
+
+        /**
+         * The kind of a directory record.
+         */
+        enum class Kind : std::uint32_t
+        {
+            Item = 0,
+            Node = 1,
+            Net  = 2,
+        };
+
+        /**
+         * A pin of a node as stored in the connectivity section.
+         */
+        struct Pin
+        {
+            std::uint32_t node = 0;         // Directory record of the node
+            std::uint32_t index = 0;        // Index of the connector within the node
+            std::uint32_t name = 0;         // The connector text (see string())
+
+            auto operator<=>(const Pin& rhs) const = default;
+        };
+
+        /**
+         * Netlist generated from the connectivity section.
+         *
+         * @details Nodes & wires are identified by the directory record they are stored in.
+         */
+        using Netlist = QSchematic::Netlist<std::uint32_t, Pin, std::uint32_t>;
+
+        /**
+         * Write a scene to a file.
+         *
+         * @param scene The scene.
+         * @param filePath The file path.
+         * @param tileSize The size of the tiles of the directory grid.
+         * @return Success indicator.
+         */
+        static
+        bool
+        write(const Scene& scene, const QString& filePath, qreal tileSize = default_tile_size);
+
+        /**
+         * Constructor.
+         *
+         * @param parent The parent object.
+         */
+        explicit
+        SheetFile(QObject* parent = nullptr);
+
+        /**
+         * Destructor.
+         */
+        ~SheetFile() override;
+
+        /**
+         * Open & map a file.
+         *
+         * @param filePath The file path.
+         * @return Success indicator.
+         */
+        bool
+        open(const QString& filePath);
+
+        void
+        close();
+
+        [[nodiscard]]
+        bool
+        isOpen() const;
+
+        /**
+         * Get the scene rect stored in the file.
+         */
+        [[nodiscard]]
+        QRectF
+        sceneRect() const;
+
+        /**
+         * Get the number of directory records.
+         */
+        [[nodiscard]]
+        std::uint32_t
+        count() const;
+
+        [[nodiscard]]
+        Kind
+        kind(std::uint32_t record) const;
+
+        [[nodiscard]]
+        QRectF
+        bounds(std::uint32_t record) const;
+
+        /**
+         * Get all directory records whose bounds intersect a region.
+         *
+         * @param rect The region in scene coordinates.
+         * @return The records.
+         */
+        [[nodiscard]]
+        std::vector<std::uint32_t>
+        records(const QRectF& rect) const;
+
+        /**
+         * Deserialize a single item.
+         *
+         * @note The item is not added to any scene. Nets can't be deserialized without a scene and are therefore
+         *       only materialized via materialize().
+         *
+         * @param record The directory record.
+         * @return The item (if any).
+         */
+        [[nodiscard]]
+        std::shared_ptr<Items::Item>
+        item(std::uint32_t record) const;
+
+        /**
+         * Get a string of the string table.
+         */
+        [[nodiscard]]
+        QString
+        string(std::uint32_t id) const;
+
+        /**
+         * Generate a netlist from the connectivity section.
+         *
+         * @note This does not materialize any items.
+         *
+         * @param netlist The netlist to populate.
+         * @return Success indicator.
+         */
+        bool
+        netlist(Netlist& netlist) const;
+
+        /**
+         * Set the scene to materialize the items into.
+         *
+         * @note This resets the materialization state. The scene is expected to be empty.
+         *
+         * @param scene The scene.
+         */
+        void
+        setScene(Scene* scene);
+
+        /**
+         * Set the view whose visible region gets materialized automatically.
+         *
+         * @param view The view.
+         */
+        void
+        setView(View* view);
+
+        /**
+         * Materialize all entries within a region into the scene.
+         *
+         * @param rect The region in scene coordinates.
+         * @return The number of newly materialized entries.
+         */
+        std::size_t
+        materialize(const QRectF& rect);
+
+        [[nodiscard]]
+        bool
+        isMaterialized(std::uint32_t record) const;
+
+    Q_SIGNALS:
+        /**
+         * Signal emitted after entries got materialized.
+         *
+         * @param count The number of newly materialized entries.
+         */
+        void
+        materialized(std::size_t count);
+
+    private:
+        struct Header;
+        struct Record;
+
+        QFile m_file;
+        const uchar* m_data = nullptr;
+        std::uint64_t m_size = 0;
+        std::unique_ptr<Header> m_header;
+        QPointer<Scene> m_scene;
+        QPointer<View> m_view;
+        QList<QMetaObject::Connection> m_viewConnections;
+        QTimer* m_timer = nullptr;
+        std::vector<bool> m_materialized;
+        QMultiHash<QPoint, std::weak_ptr<Items::Connector>> m_connectors;       // By position when materialized
+        QMultiHash<QPoint, std::weak_ptr<wire_system::wire>> m_wireEnds;        // By position when materialized
+
+        template<typename T>
+        [[nodiscard]]
+        T
+        read(std::uint64_t offset) const;
+
+        [[nodiscard]]
+        Record
+        record(std::uint32_t index) const;
+
+        [[nodiscard]]
+        std::string_view
+        blob(std::uint32_t record) const;
+
+        void
+        materializeVisible();
+    };
+
+}
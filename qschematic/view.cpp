@@ -1,8 +1,16 @@
 #include <QKeyEvent>
 #include <QWheelEvent>
+#include <QPainter>
+#include <QPaintEvent>
+#include <QRubberBand>
 #include <QScrollBar>
+#include <QStyle>
+#include <QStyleOptionRubberBand>
+#include <QTimer>
 #include <QtMath>
 
+#include <utility>
+
 #include "view.hpp"
 #include "scene.hpp"
 #include "settings.hpp"
@@ -23,7 +31,13 @@ View::View(QWidget* parent) :
     setDragMode(QGraphicsView::RubberBandDrag);
 
     // Rendering options
-    setViewportUpdateMode(QGraphicsView::FullViewportUpdate);
+    updateViewportUpdateMode();
+
+    // Progressive rendering
+    _progressiveTimer = new QTimer(this);
+    _progressiveTimer->setSingleShot(true);
+    _progressiveTimer->setInterval(_settings.progressiveRenderingDelay);
+    connect(_progressiveTimer, &QTimer::timeout, this, &View::endProgressiveRendering);
 
     // Set initial zoom value
     setZoomValue(1.0);
@@ -165,6 +179,70 @@ View::mouseReleaseEvent(QMouseEvent *event)
     QGraphicsView::mouseReleaseEvent(event);
 }
 
+void
+View::paintEvent(QPaintEvent* event)
+{
+    // Render the scene
+    if (!_settings.progressiveRendering) {
+        QGraphicsView::paintEvent(event);
+        return;
+    }
+
+    // Map the last frame to the current viewport transform
+    if (_progressive) {
+        QPainter painter(viewport());
+        painter.fillRect(event->rect(), viewport()->palette().base());
+        painter.setTransform(_frameTransform.inverted() * viewportTransform());
+        painter.drawPixmap(0, 0, _frame);
+        return;
+    }
+
+    // Render the exposed region into the frame
+    const qreal dpr = viewport()->devicePixelRatioF();
+    const QSize frameSize = viewport()->size() * dpr;
+    if (_frame.size() != frameSize || _frame.devicePixelRatio() != dpr) {
+        _frame = QPixmap(frameSize);
+        _frame.setDevicePixelRatio(dpr);
+        _frame.fill(viewport()->palette().base().color());
+    }
+    {
+        QPainter painter(&_frame);
+        painter.setRenderHints(renderHints());
+        for (const QRect& rect : event->region()) {
+            painter.fillRect(rect, viewport()->palette().base());
+            render(&painter, rect, rect, Qt::IgnoreAspectRatio);
+        }
+    }
+    _frameTransform = viewportTransform();
+
+    // Present it
+    QPainter painter(viewport());
+    painter.setClipRegion(event->region());
+    painter.drawPixmap(0, 0, _frame);
+
+    // The rubber band is not part of the rendered scene
+    if (const QRect band = rubberBandRect(); !band.isEmpty()) {
+        QStyleOptionRubberBand option;
+        option.initFrom(viewport());
+        option.rect = band;
+        option.shape = QRubberBand::Rectangle;
+
+        QStyleHintReturnMask mask;
+        if (viewport()->style()->styleHint(QStyle::SH_RubberBand_Mask, &option, viewport(), &mask))
+            painter.setClipRegion(mask.region, Qt::IntersectClip);
+
+        viewport()->style()->drawControl(QStyle::CE_RubberBand, &option, &painter, viewport());
+    }
+}
+
+void
+View::scrollContentsBy(int dx, int dy)
+{
+    beginProgressiveRendering();
+
+    QGraphicsView::scrollContentsBy(dx, dy);
+}
+
 void
 View::setScene(Scene* scene)
 {
@@ -198,6 +276,15 @@ View::setSettings(const Settings& settings)
 
     // Rendering options
     setRenderHint(QPainter::Antialiasing, _settings.antialiasing);
+    updateViewportUpdateMode();
+
+    // Progressive rendering
+    _progressiveTimer->setInterval(_settings.progressiveRenderingDelay);
+    if (!_settings.progressiveRendering) {
+        endProgressiveRendering();
+        _frame = { };
+    }
+    viewport()->update();
 }
 
 void
@@ -218,6 +305,7 @@ View::updateScale()
     float zoom = qExp(logZoom);
 
     // Apply the new scale
+    beginProgressiveRendering();
     setTransform(QTransform::fromScale(zoom, zoom));
 
     Q_EMIT zoomChanged(zoom);
@@ -231,6 +319,53 @@ View::setMode(const Mode newMode)
     Q_EMIT modeChanged(_mode);
 }
 
+void
+View::updateViewportUpdateMode()
+{
+    switch (_settings.viewportUpdate) {
+        case Settings::ViewportUpdate::Full:
+            setViewportUpdateMode(QGraphicsView::FullViewportUpdate);
+            break;
+
+        case Settings::ViewportUpdate::Minimal:
+            setViewportUpdateMode(QGraphicsView::MinimalViewportUpdate);
+            break;
+
+        case Settings::ViewportUpdate::Smart:
+            setViewportUpdateMode(QGraphicsView::SmartViewportUpdate);
+            break;
+
+        case Settings::ViewportUpdate::BoundingRect:
+            setViewportUpdateMode(QGraphicsView::BoundingRectViewportUpdate);
+            break;
+    }
+}
+
+void
+View::beginProgressiveRendering()
+{
+    // Note: The frame is null until the viewport got painted once
+    if (!_settings.progressiveRendering || !isVisible() || _frame.isNull())
+        return;
+
+    // Keep showing the last frame
+    _progressive = true;
+
+    // Refine once the input has been idle
+    _progressiveTimer->start();
+}
+
+void
+View::endProgressiveRendering()
+{
+    _progressiveTimer->stop();
+
+    if (!std::exchange(_progressive, false))
+        return;
+
+    viewport()->update();
+}
+
 qreal
 View::zoomValue() const
 {
@@ -244,17 +379,8 @@ View::fitInView()
     if (!_scene)
         return;
 
-    // Find the combined bounding rect of all the items
-    QRectF rect;
-    for (const auto& item : _scene->QGraphicsScene::items()) {
-        // Ignore the background item
-        if (_scene->isBackground(item))
-            continue;
-
-        QRectF boundingRect = item->boundingRect();
-        boundingRect.moveTo(item->scenePos());
-        rect = rect.united(boundingRect);
-    }
+    // Get the combined bounding rect of all the items
+    QRectF rect = _scene->contentBounds();
 
     // Add some padding
     const auto adj = std::max(0.0, fitall_padding);
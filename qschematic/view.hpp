@@ -3,6 +3,10 @@
 #include "scene.hpp"
 
 #include <QGraphicsView>
+#include <QPixmap>
+#include <QTransform>
+
+class QTimer;
 
 namespace QSchematic
 {
@@ -94,6 +98,8 @@ namespace QSchematic
         void mouseMoveEvent(QMouseEvent* event) override;
         void mousePressEvent(QMouseEvent* event) override;
         void mouseReleaseEvent(QMouseEvent* event) override;
+        void paintEvent(QPaintEvent* event) override;
+        void scrollContentsBy(int dx, int dy) override;
 
     private:
         void
@@ -102,10 +108,31 @@ namespace QSchematic
         void
         setMode(Mode newMode);
 
+        void
+        updateViewportUpdateMode();
+
+        /**
+         * Start (or continue) progressive rendering.
+         *
+         * @details While progressive rendering is enabled, the scene is rendered into a backing frame which is then
+         *          copied to the viewport. Until the input of a zoom/pan sequence has been idle for
+         *          Settings::progressiveRenderingDelay, the viewport is painted by transforming the last frame instead
+         *          of rendering the scene.
+         */
+        void
+        beginProgressiveRendering();
+
+        void
+        endProgressiveRendering();
+
         Scene* _scene = nullptr;
         Settings _settings;
         qreal _scaleFactor = 1.0;
         Mode _mode = Mode::NormalMode;
         QPoint _panStart;
+        QTimer* _progressiveTimer = nullptr;
+        bool _progressive = false;
+        QPixmap _frame;                 // The last rendered frame (only maintained while progressive rendering is enabled)
+        QTransform _frameTransform;     // Viewport transform at the time the frame was rendered
     };
 }
@@ -0,0 +1,291 @@
+#include "wire_layer.hpp"
+#include "items/wire.hpp"
+
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+
+#include <cmath>
+#include <optional>
+
+using namespace QSchematic;
+
+const qreal JUNCTION_DIAMETER = 8.0;
+const qreal CELL_SIZE = 512.0;
+
+namespace
+{
+
+    [[nodiscard]]
+    QPoint
+    cellIndex(const QPointF& point)
+    {
+        return { static_cast<int>(std::floor(point.x() / CELL_SIZE)), static_cast<int>(std::floor(point.y() / CELL_SIZE)) };
+    }
+
+    [[nodiscard]]
+    QRectF
+    cellRect(const QPoint& index)
+    {
+        return { index.x() * CELL_SIZE, index.y() * CELL_SIZE, CELL_SIZE, CELL_SIZE };
+    }
+
+    /**
+     * Clip a line to a rectangle (Liang-Barsky).
+     */
+    [[nodiscard]]
+    std::optional<QLineF>
+    clip(const QLineF& line, const QRectF& rect)
+    {
+        const qreal dx = line.dx();
+        const qreal dy = line.dy();
+        const qreal p[4] = { -dx, dx, -dy, dy };
+        const qreal q[4] = { line.x1() - rect.left(), rect.right() - line.x1(), line.y1() - rect.top(), rect.bottom() - line.y1() };
+
+        qreal t0 = 0;
+        qreal t1 = 1;
+        for (int i = 0; i < 4; i++) {
+            if (p[i] == 0) {
+                if (q[i] < 0)
+                    return std::nullopt;
+                continue;
+            }
+
+            const qreal t = q[i] / p[i];
+            if (p[i] < 0)
+                t0 = std::max(t0, t);
+            else
+                t1 = std::min(t1, t);
+
+            if (t0 > t1)
+                return std::nullopt;
+        }
+
+        return QLineF(line.pointAt(t0), line.pointAt(t1));
+    }
+
+}
+
+WireLayer::WireLayer(QGraphicsItem* parent) :
+    QGraphicsRectItem(parent)
+{
+    setPen(Qt::NoPen);
+    setBrush(Qt::NoBrush);
+
+    // Configuration
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption, true);  // For QStyleOptionGraphicsItem::exposedRect
+    setFlag(QGraphicsItem::ItemIsMovable, false);
+    setFlag(QGraphicsItem::ItemIsSelectable, false);
+    setFlag(QGraphicsItem::ItemIsFocusable, false);
+    setFlag(QGraphicsItem::ItemSendsGeometryChanges, false);
+    setFlag(QGraphicsItem::ItemSendsScenePositionChanges, false);
+    setAcceptedMouseButtons(Qt::NoButton);
+    setAcceptHoverEvents(false);
+}
+
+void
+WireLayer::setSettings(const Settings& settings)
+{
+    m_settings = settings;
+    update();
+}
+
+void
+WireLayer::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
+{
+    Q_UNUSED(widget);
+
+    registerPending();
+
+    // Get the rectangle of interest (er = "exposed rect")
+    // Note: Junctions & line caps extend beyond the cell they belong to
+    const qreal margin = JUNCTION_DIAMETER / 2 + 1;
+    const QRectF er = (option ? option->exposedRect : rect()).adjusted(-margin, -margin, margin, margin);
+
+    // Collect the cells within the exposed rect
+    QVector<const Cell*> cells;
+    const QPoint first = cellIndex(er.topLeft());
+    const QPoint last = cellIndex(er.bottomRight());
+    const qint64 cellCount = qint64(last.x() - first.x() + 1) * qint64(last.y() - first.y() + 1);
+    const auto visit = [this, &cells](const QPoint& index, Cell& cell) {
+        if (cell.wires.isEmpty())
+            return;
+        if (!cell.valid)
+            build(index, cell);
+        cells.append(&cell);
+    };
+    if (cellCount > m_cells.size()) {
+        for (auto it = m_cells.begin(); it != m_cells.end(); ++it) {
+            if (cellRect(it.key()).intersects(er))
+                visit(it.key(), it.value());
+        }
+    }
+    else {
+        for (int y = first.y(); y <= last.y(); y++) {
+            for (int x = first.x(); x <= last.x(); x++) {
+                const QPoint index(x, y);
+                if (const auto it = m_cells.find(index); it != m_cells.end())
+                    visit(index, it.value());
+            }
+        }
+    }
+
+    // Prepare painter
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing, m_settings.antialiasing);
+    painter->setBrush(Qt::NoBrush);
+
+    // Draw the lines
+    const qreal lod = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+    const bool hairline = lod < m_settings.lodWireHairline;
+    QPen pen;
+    pen.setStyle(Qt::SolidLine);
+    pen.setCapStyle(Qt::RoundCap);
+    pen.setWidth(hairline ? 0 : 1);
+    for (const Cell* cell : std::as_const(cells)) {
+        for (auto it = cell->batches.cbegin(); it != cell->batches.cend(); ++it) {
+            if (it.value().lines.isEmpty())
+                continue;
+
+            pen.setColor(QColor::fromRgba(it.key()));
+            painter->setPen(pen);
+            painter->drawLines(it.value().lines);
+        }
+    }
+
+    // Draw the junctions (not rendered at low level of detail)
+    if (!hairline) {
+        pen.setWidthF(JUNCTION_DIAMETER);
+        for (const Cell* cell : std::as_const(cells)) {
+            for (auto it = cell->batches.cbegin(); it != cell->batches.cend(); ++it) {
+                if (it.value().junctions.isEmpty())
+                    continue;
+
+                pen.setColor(QColor::fromRgba(it.key()));
+                painter->setPen(pen);
+                painter->drawPoints(it.value().junctions.constData(), it.value().junctions.size());
+            }
+        }
+    }
+
+    painter->restore();
+}
+
+void
+WireLayer::invalidate(const Items::Wire& wire)
+{
+    unregister(wire);
+    m_pending.insert(&wire);
+}
+
+void
+WireLayer::invalidate(const QVector<const Items::Wire*>& wires)
+{
+    m_pending.reserve(m_pending.size() + wires.size());
+    for (const Items::Wire* wire : wires) {
+        unregister(*wire);
+        m_pending.insert(wire);
+    }
+}
+
+void
+WireLayer::remove(const Items::Wire& wire)
+{
+    unregister(wire);
+    m_pending.remove(&wire);
+}
+
+void
+WireLayer::unregister(const Items::Wire& wire)
+{
+    const auto it = m_wireCells.find(&wire);
+    if (it == m_wireCells.end())
+        return;
+
+    for (const QPoint& index : std::as_const(it.value())) {
+        const auto cell = m_cells.find(index);
+        if (cell == m_cells.end())
+            continue;
+
+        cell->wires.remove(&wire);
+        if (cell->wires.isEmpty())
+            m_cells.erase(cell);
+        else
+            cell->valid = false;
+    }
+
+    m_wireCells.erase(it);
+}
+
+void
+WireLayer::registerPending()
+{
+    for (const Items::Wire* wire : std::as_const(m_pending)) {
+        // Not (or no longer) our responsibility
+        if (!wire->isVisible() || !wire->isPaintedByWireLayer())
+            continue;
+
+        const QRectF bounds = wire->sceneBoundingRect();
+        const QPoint first = cellIndex(bounds.topLeft());
+        const QPoint last = cellIndex(bounds.bottomRight());
+
+        QVector<QPoint> indices;
+        indices.reserve((last.x() - first.x() + 1) * (last.y() - first.y() + 1));
+        for (int y = first.y(); y <= last.y(); y++) {
+            for (int x = first.x(); x <= last.x(); x++) {
+                Cell& cell = m_cells[QPoint(x, y)];
+                cell.wires.insert(wire);
+                cell.valid = false;
+                indices.append(QPoint(x, y));
+            }
+        }
+
+        m_wireCells.insert(wire, std::move(indices));
+    }
+
+    m_pending.clear();
+}
+
+void
+WireLayer::build(const QPoint& index, Cell& cell) const
+{
+    // Cells are half-open so that segments on a cell border are only drawn once
+    const QRectF rect = cellRect(index);
+    const auto contains = [&rect](const QPointF& point) {
+        return point.x() >= rect.left() && point.x() < rect.right() && point.y() >= rect.top() && point.y() < rect.bottom();
+    };
+
+    cell.batches.clear();
+    for (const Items::Wire* wire : std::as_const(cell.wires)) {
+        const QPointF offset = wire->pos();
+        Batch& batch = cell.batches[wire->penColor().rgba()];
+
+        const auto& points = wire->cachedPolyline();
+        for (qsizetype i = 1; i < points.size(); i++) {
+            const QLineF line(points[i-1] + offset, points[i] + offset);
+
+            // Degenerated segments belong to the cell containing them
+            if (line.p1() == line.p2()) {
+                if (contains(line.p1()))
+                    batch.lines.append(line);
+                continue;
+            }
+
+            const auto clipped = clip(line, rect);
+            if (!clipped || clipped->p1() == clipped->p2())
+                continue;
+
+            // Segments on the right or bottom border belong to the next cell
+            if ((clipped->x1() == rect.right() && clipped->x2() == rect.right()) || (clipped->y1() == rect.bottom() && clipped->y2() == rect.bottom()))
+                continue;
+
+            batch.lines.append(*clipped);
+        }
+
+        for (const QPointF& junction : wire->cachedJunctions()) {
+            if (contains(junction + offset))
+                batch.junctions.append(junction + offset);
+        }
+    }
+
+    cell.valid = true;
+}
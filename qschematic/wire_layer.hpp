@@ -0,0 +1,118 @@
+#pragma once
+
+#include "settings.hpp"
+#include "items/item.hpp"   // For QGraphicsItem::type() overload
+
+#include <QColor>
+#include <QGraphicsRectItem>
+#include <QHash>
+#include <QLineF>
+#include <QPoint>
+#include <QSet>
+#include <QVector>
+
+namespace QSchematic::Items
+{
+    class Wire;
+}
+
+namespace QSchematic
+{
+
+    /**
+     * Scene-level item rendering all plain wires in batches.
+     *
+     * @details This is only used if Settings::batchedWireRendering is enabled. In that case, unselected and
+     *          non-highlighted wires of type Items::Item::WireType do not paint themselves. Instead, this item draws
+     *          them using one drawLines() call and one drawPoints() call (for the junctions) per color and cell.
+     *          The scene is divided into square cells. Each cell caches the batches of the wire segments within it.
+     *          Wires report changes to their geometry or appearance via invalidate(). Only the cells the wire
+     *          covers get rebuilt and only the cells within the exposed rect get painted.
+     *          Wire sub-classes with custom painting (eg. rounded corners, bezier) keep painting themselves.
+     *
+     * @note We are intentionally not deriving from QSchematic::Items::Item for the same reasons as Background.
+     */
+    class WireLayer :
+        public QGraphicsRectItem
+    {
+    public:
+        explicit
+        WireLayer(QGraphicsItem* parent = nullptr);
+
+        ~WireLayer() override = default;
+
+        void
+        setSettings(const Settings& settings);
+
+        [[nodiscard]]
+        int
+        type() const override
+        {
+            return QSchematic::Items::Item::ItemType::WireLayerType;
+        }
+
+        /**
+         * Do not provide a shape.
+         *
+         * @note The wires themselves remain responsible for all interactions.
+         */
+        [[nodiscard]]
+        QPainterPath
+        shape() const override
+        {
+            return { };
+        }
+
+        void
+        paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) override;
+
+        /**
+         * Notify the layer that the geometry or the appearance of a wire changed.
+         *
+         * @note The wire is (re-)registered lazily on the next paint.
+         */
+        void
+        invalidate(const Items::Wire& wire);
+
+        /**
+         * Notify the layer that the geometry or the appearance of several wires changed.
+         */
+        void
+        invalidate(const QVector<const Items::Wire*>& wires);
+
+        /**
+         * Notify the layer that a wire is leaving the scene (or being destroyed).
+         */
+        void
+        remove(const Items::Wire& wire);
+
+    private:
+        struct Batch
+        {
+            QVector<QLineF> lines;
+            QVector<QPointF> junctions;
+        };
+
+        struct Cell
+        {
+            QSet<const Items::Wire*> wires;
+            bool valid = false;
+            QHash<QRgb, Batch> batches;
+        };
+
+        Settings m_settings;
+        QHash<QPoint, Cell> m_cells;
+        QHash<const Items::Wire*, QVector<QPoint>> m_wireCells;
+        QSet<const Items::Wire*> m_pending;
+
+        void
+        unregister(const Items::Wire& wire);
+
+        void
+        registerPending();
+
+        void
+        build(const QPoint& index, Cell& cell) const;
+    };
+
+}
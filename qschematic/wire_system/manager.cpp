@@ -20,7 +20,10 @@ manager::add_net(const std::shared_ptr<net> wireNet)
     wireNet->set_manager(this);
 
     // Keep track of stuff
-    m_nets.push_back(std::move(wireNet));
+    index_net(*wireNet);
+    m_nets.push_back(wireNet);
+
+    Q_EMIT net_added(wireNet.get());
 }
 
 std::vector<std::shared_ptr<net>>
@@ -29,58 +32,74 @@ manager::nets() const
     return m_nets;
 }
 
+bool
+manager::has_net(const net* net) const
+{
+    // Note: Every managed net is indexed (anonymous ones under the empty name)
+    return m_indexed_names.contains(net);
+}
+
 std::vector<manager::global_net>
 manager::global_nets() const
 {
     std::vector<global_net> global_nets;
     global_nets.reserve(std::size(m_nets));
 
+    std::unordered_map<name_table::id_t, std::size_t> named_global_nets;    // Name ID -> index in global_nets
     std::size_t anon_net_counter = 1;   // Used to generate global net names for unnamed nets
     for (const auto& net : m_nets) {
         // Sanity check
         if (!net) [[unlikely]]
             continue;
 
-        // Determine if we need to create a new global net
-        bool create_new = true;
-        for (auto& global_net : global_nets) {
-            // We need a new global net if this net is anonymous
-            if (net->name().isEmpty()) {
-                create_new = true;
-                break;
-            }
-
-            // At this point we know that the net is not anonymous. Now we check if the current global net
-            // has the same name. If yes, we add the net to the global net. If not, we need to create a
-            // new global net (down below).
-            if (net->name().toStdString() == global_net.name) {
-                create_new = false;
-                global_net.nets.push_back(net);
-                break;
+        // Named nets sharing the same name form one global net
+        const auto name_id = net->name_id();
+        if (name_id != name_table::empty_id) {
+            const auto [it, inserted] = named_global_nets.try_emplace(name_id, std::size(global_nets));
+            if (!inserted) {
+                global_nets[it->second].nets.push_back(net);
+                continue;
             }
         }
 
-        // Create a new global net if necessary
-        if (create_new) {
-            global_net gn;
+        // Create a new global net
+        global_net gn;
+        gn.name_id = name_id;
 
-            // Assign a net name if the net is anonymous
-            if (net->name().isEmpty())
-                gn.name = QString("N%1").arg(anon_net_counter++, 3, 10, QChar('0')).toStdString();
-            else
-                gn.name = net->name().toStdString();
+        // Assign a net name if the net is anonymous
+        if (name_id == name_table::empty_id)
+            gn.name = QString("N%1").arg(anon_net_counter++, 3, 10, QChar('0')).toStdString();
+        else
+            gn.name = net->name().toStdString();
 
-            // Add the net
-            gn.nets.push_back(net);
+        // Add the net
+        gn.nets.push_back(net);
 
-            // Add the global net
-            global_nets.push_back(std::move(gn));
-        }
+        // Add the global net
+        global_nets.push_back(std::move(gn));
     }
 
     return global_nets;
 }
 
+std::vector<std::shared_ptr<net>>
+manager::nets_named(const name_table::id_t name_id) const
+{
+    if (name_id == name_table::empty_id)
+        return { };
+
+    const auto it = m_nets_by_name.find(name_id);
+    if (it == std::cend(m_nets_by_name))
+        return { };
+
+    std::vector<std::shared_ptr<net>> list;
+    list.reserve(std::size(it->second));
+    for (auto* net : it->second)
+        list.push_back(net->shared_from_this());
+
+    return list;
+}
+
 /**
  * Returns a list of all the wires
  */
@@ -126,13 +145,13 @@ manager::connect_wire(wire* wire, wire_system::wire* rawWire, std::size_t point)
     if (!wire || !rawWire) [[unlikely]]
         return;
 
-    if (!wire->connect_wire(rawWire))
-        return;
-
-    std::shared_ptr<wire_system::net> net = wire->net();
-    std::shared_ptr<wire_system::net> otherNet = rawWire->net();
-    if (merge_nets(net, otherNet))
-        remove_net(otherNet);
+    // Note: Both ends of a wire can be connected to the same wire. The nets only need to be merged once.
+    if (wire->connect_wire(rawWire)) {
+        std::shared_ptr<wire_system::net> net = wire->net();
+        std::shared_ptr<wire_system::net> otherNet = rawWire->net();
+        if (merge_nets(net, otherNet))
+            remove_net(otherNet);
+    }
 
     // Set the wire point to be a junction
     rawWire->set_point_is_junction(point, true);
@@ -170,13 +189,21 @@ manager::remove_net(std::shared_ptr<net> net)
     if (!net) [[unlikely]]
         return;
 
+    Q_EMIT net_removed(net.get());
+
+    unindex_net(*net);
     std::erase(m_nets, net);
 }
 
 void
 manager::clear()
 {
+    for (const auto& net : m_nets)
+        Q_EMIT net_removed(net.get());
+
     m_nets.clear();
+    m_nets_by_name.clear();
+    m_indexed_names.clear();
 }
 
 void
@@ -388,7 +415,8 @@ manager::attach_wire_to_connector(wire* wire, int index, const connectable* conn
         return;
 
     // Note: Does nothing if the key already exists
-    m_connections.try_emplace(connector, connection_record{wire, index});
+    if (m_connections.try_emplace(connector, connection_record{wire, index}).second)
+        Q_EMIT connector_attachment_changed(connector);
 }
 
 /**
@@ -463,7 +491,8 @@ manager::detach_wire(const connectable* connector)
     if (!connector) [[unlikely]]
         return;
 
-    m_connections.erase(connector);
+    if (m_connections.erase(connector) > 0)
+        Q_EMIT connector_attachment_changed(connector);
 }
 
 bool
@@ -501,14 +530,21 @@ manager::detach_wire_from_all(const wire* wire)
     if (!wire) [[unlikely]]
         return;
 
+    std::vector<const connectable*> detached;
     std::erase_if(
         m_connections,
-        [wire](const auto& item) {
+        [wire, &detached](const auto& item) {
             const auto& cr = item.second;
+            if (cr.wire != wire)
+                return false;
 
-            return cr.wire == wire;
+            detached.push_back(item.first);
+            return true;
         }
     );
+
+    for (const auto* connector : detached)
+        Q_EMIT connector_attachment_changed(connector);
 }
 
 std::optional<manager::connection_record>
@@ -602,3 +638,55 @@ manager::create_net()
 
     return net;
 }
+
+name_table&
+manager::names() noexcept
+{
+    return m_names;
+}
+
+const name_table&
+manager::names() const noexcept
+{
+    return m_names;
+}
+
+void
+manager::index_net(net& net)
+{
+    const auto [it, inserted] = m_indexed_names.try_emplace(&net, net.name_id());
+    if (!inserted) [[unlikely]]
+        return;
+
+    if (it->second != name_table::empty_id)
+        m_nets_by_name[it->second].push_back(&net);
+}
+
+void
+manager::unindex_net(const net& net)
+{
+    const auto it = m_indexed_names.find(&net);
+    if (it == std::cend(m_indexed_names))
+        return;
+
+    if (it->second != name_table::empty_id) {
+        if (auto bucket = m_nets_by_name.find(it->second); bucket != std::end(m_nets_by_name)) {
+            std::erase(bucket->second, &net);
+            if (bucket->second.empty())
+                m_nets_by_name.erase(bucket);
+        }
+    }
+
+    m_indexed_names.erase(it);
+}
+
+void
+manager::update_name_index(net& net)
+{
+    // Only nets which were added to this manager are indexed
+    if (!m_indexed_names.contains(&net))
+        return;
+
+    unindex_net(net);
+    index_net(net);
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "name_table.hpp"
 #include "../settings.hpp"
 
 #include <QObject>
@@ -30,9 +31,31 @@ namespace wire_system
     {
         Q_OBJECT
 
+        friend class net;
+
     Q_SIGNALS:
         void wire_point_moved(wire& wire, int index);
 
+        /**
+         * Signal emitted when a wire got attached to or detached from a connector.
+         */
+        void connector_attachment_changed(const connectable* connector);
+
+        /**
+         * Signal emitted after a net got added.
+         */
+        void net_added(net* net);
+
+        /**
+         * Signal emitted before a net gets removed.
+         */
+        void net_removed(net* net);
+
+        /**
+         * Signal emitted when a wire got added to or removed from a net (eg. when nets get merged or split).
+         */
+        void net_wires_changed(net* net);
+
     public:
         /**
          * Structure used to record a connection of a wire.
@@ -52,6 +75,7 @@ namespace wire_system
         struct global_net
         {
             std::string name;
+            name_table::id_t name_id = name_table::empty_id;   // Empty for anonymous nets
             std::vector<std::shared_ptr<net>> nets;
         };
 
@@ -75,6 +99,13 @@ namespace wire_system
         std::vector<std::shared_ptr<net>>
         nets() const;
 
+        /**
+         * Checks whether a net is managed by this manager.
+         */
+        [[nodiscard]]
+        bool
+        has_net(const net* net) const;
+
         /**
          * Return a collection of all global nets.
          *
@@ -84,6 +115,15 @@ namespace wire_system
         std::vector<global_net>
         global_nets() const;
 
+        /**
+         * Return a collection of all nets with a specific name.
+         *
+         * @note Anonymous nets are not indexed. Passing name_table::empty_id returns an empty collection.
+         */
+        [[nodiscard]]
+        std::vector<std::shared_ptr<net>>
+        nets_named(name_table::id_t name_id) const;
+
         [[nodiscard]]
         std::vector<std::shared_ptr<wire>>
         wires() const;
@@ -166,11 +206,34 @@ namespace wire_system
         void
         connector_moved(const connectable* connector);
 
+        /**
+         * Get the table of interned net names.
+         */
+        [[nodiscard]]
+        name_table&
+        names() noexcept;
+
+        [[nodiscard]]
+        const name_table&
+        names() const noexcept;
+
     private:
         std::vector<std::shared_ptr<net>> m_nets;
         Settings m_settings;
         std::function<std::shared_ptr<net>()> m_net_factory;
         std::unordered_map<const connectable*, connection_record> m_connections;
+        name_table m_names;
+        std::unordered_map<name_table::id_t, std::vector<net*>> m_nets_by_name;
+        std::unordered_map<const net*, name_table::id_t> m_indexed_names;    // Name ID each net is indexed under
+
+        void
+        index_net(net& net);
+
+        void
+        unindex_net(const net& net);
+
+        void
+        update_name_index(net& net);
 
         [[nodiscard]]
         static
@@ -0,0 +1,44 @@
+#include "name_table.hpp"
+
+using namespace wire_system;
+
+name_table::id_t
+name_table::intern(const QString& name)
+{
+    if (name.isEmpty())
+        return empty_id;
+
+    const auto [it, inserted] = m_ids.try_emplace(name, static_cast<id_t>(std::size(m_names)));
+    if (inserted)
+        m_names.push_back(it->first);
+
+    return it->second;
+}
+
+std::optional<name_table::id_t>
+name_table::find(const QString& name) const
+{
+    if (name.isEmpty())
+        return empty_id;
+
+    const auto it = m_ids.find(name);
+    if (it == std::cend(m_ids))
+        return std::nullopt;
+
+    return it->second;
+}
+
+QString
+name_table::name(const id_t id) const
+{
+    if (id >= std::size(m_names)) [[unlikely]]
+        return { };
+
+    return m_names[id];
+}
+
+std::size_t
+name_table::size() const
+{
+    return std::size(m_names);
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <QString>
+
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace wire_system
+{
+
+    /**
+     * A table of interned names.
+     *
+     * @details Each distinct name is stored exactly once and identified by an integer ID. Names handed out by the
+     *          table share their storage (QString is implicitly shared). Comparing two interned names boils down to
+     *          comparing their IDs.
+     *
+     * @note Names are never removed from the table. IDs therefore remain valid for the lifetime of the table.
+     */
+    class name_table
+    {
+    public:
+        using id_t = std::uint32_t;
+
+        /**
+         * The ID of the empty name.
+         */
+        static constexpr id_t empty_id = 0;
+
+        name_table() = default;
+        name_table(const name_table&) = delete;
+        name_table(name_table&&) = delete;
+        virtual ~name_table() = default;
+
+        name_table& operator=(const name_table&) = delete;
+        name_table& operator=(name_table&&) = delete;
+
+        /**
+         * Intern a name.
+         *
+         * @param name The name.
+         * @return The ID of the name.
+         */
+        id_t
+        intern(const QString& name);
+
+        /**
+         * Get the ID of a name if it was interned before.
+         */
+        [[nodiscard]]
+        std::optional<id_t>
+        find(const QString& name) const;
+
+        /**
+         * Get the name of an ID.
+         *
+         * @note Returns an empty string for unknown IDs.
+         */
+        [[nodiscard]]
+        QString
+        name(id_t id) const;
+
+        /**
+         * Get the number of interned names (including the empty name).
+         */
+        [[nodiscard]]
+        std::size_t
+        size() const;
+
+    private:
+        std::vector<QString> m_names{ QString{ } };
+        std::unordered_map<QString, id_t> m_ids;
+    };
+
+}
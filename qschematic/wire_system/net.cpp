@@ -1,4 +1,5 @@
 #include "line.hpp"
+#include "manager.hpp"
 #include "net.hpp"
 #include "wire.hpp"
 
@@ -16,6 +17,7 @@ void
 net::set_name(const QString& name)
 {
     m_name = name;
+    intern_name();
 }
 
 QString
@@ -78,6 +80,9 @@ net::addWire(const std::shared_ptr<wire>& wire)
     // Add the wire
     m_wires.push_back(wire);
 
+    if (m_manager)
+        Q_EMIT m_manager->net_wires_changed(this);
+
     return true;
 }
 
@@ -87,6 +92,9 @@ net::removeWire(const std::shared_ptr<wire> wire)
     for (auto it = m_wires.begin(); it != m_wires.end(); it++) {
         if ((*it).lock() == wire) {
             m_wires.erase(it);
+
+            if (m_manager)
+                Q_EMIT m_manager->net_wires_changed(this);
             break;
         }
     }
@@ -130,4 +138,24 @@ void
 net::set_manager(class manager* manager)
 {
     m_manager = manager;
+    intern_name();
+}
+
+void
+net::intern_name()
+{
+    if (!m_manager) {
+        m_name_id = name_table::empty_id;
+        return;
+    }
+
+    // Share the name's storage with the name table
+    auto& names = m_manager->names();
+    const auto old_id = m_name_id;
+    m_name_id = names.intern(m_name);
+    m_name = names.name(m_name_id);
+
+    // Keep the manager's name index up to date
+    if (m_name_id != old_id)
+        m_manager->update_name_index(*this);
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "name_table.hpp"
 #include "point.hpp"
 
 #include <QString>
@@ -34,6 +35,18 @@ namespace wire_system
         QString
         name() const;
 
+        /**
+         * Get the ID of the name in the manager's name table.
+         *
+         * @note This is only meaningful once the net has been assigned to a manager.
+         */
+        [[nodiscard]]
+        name_table::id_t
+        name_id() const noexcept
+        {
+            return m_name_id;
+        }
+
         [[nodiscard]]
         std::vector<std::shared_ptr<wire>>
         wires() const;
@@ -76,6 +89,10 @@ namespace wire_system
         std::vector<std::weak_ptr<wire>> m_wires;
         class manager* m_manager = nullptr;
         QString m_name;
+        name_table::id_t m_name_id = name_table::empty_id;
+
+        void
+        intern_name();
     };
 
 }
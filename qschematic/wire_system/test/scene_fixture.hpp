@@ -0,0 +1,91 @@
+#pragma once
+
+#include "../../scene.hpp"
+#include "../../items/connector.hpp"
+#include "../../items/node.hpp"
+#include "../../items/wire.hpp"
+#include "../../items/wirenet.hpp"
+#include "../manager.hpp"
+
+#include <QPointF>
+#include <QString>
+#include <QVector>
+
+#include <memory>
+
+/**
+ * Helpers to build scenes for the tests.
+ */
+namespace fixture
+{
+
+    /**
+     * Create a node with a number of connectors along its left edge.
+     */
+    inline
+    std::shared_ptr<QSchematic::Items::Node>
+    makeNode(const QPointF& pos, int connectorCount = 2)
+    {
+        auto node = std::make_shared<QSchematic::Items::Node>();
+        node->setSize(80, 20 * (connectorCount + 1));
+        for (int i = 0; i < connectorCount; i++)
+            node->addConnector(std::make_shared<QSchematic::Items::Connector>(QSchematic::Items::Item::ConnectorType, QPoint(0, i + 1), QStringLiteral("P%1").arg(i)));
+        node->setPos(pos);
+
+        return node;
+    }
+
+    /**
+     * Add a node with a number of connectors along its left edge.
+     */
+    inline
+    std::shared_ptr<QSchematic::Items::Node>
+    addNode(QSchematic::Scene& scene, const QPointF& pos, int connectorCount = 2)
+    {
+        auto node = makeNode(pos, connectorCount);
+        scene.addItem(node);
+
+        return node;
+    }
+
+    /**
+     * Add a wire through the specified scene points.
+     */
+    inline
+    std::shared_ptr<QSchematic::Items::Wire>
+    addWire(QSchematic::Scene& scene, const QVector<QPointF>& points, const QString& netName = { })
+    {
+        auto wire = std::make_shared<QSchematic::Items::Wire>();
+        for (const QPointF& point : points)
+            wire->append_point(point);
+        scene.addWire(wire);
+        if (!netName.isEmpty())
+            wire->net()->set_name(netName);
+
+        return wire;
+    }
+
+    /**
+     * Add a wire between two connectors and attach both ends.
+     *
+     * @note The connectors are read back from the scene as their positions get snapped.
+     */
+    inline
+    std::shared_ptr<QSchematic::Items::Wire>
+    connect(QSchematic::Scene& scene, const QSchematic::Items::Connector& from, const QSchematic::Items::Connector& to, const QString& netName = { })
+    {
+        const QPointF a = from.position();
+        const QPointF b = to.position();
+        QVector<QPointF> points = { a };
+        if (a.x() != b.x() && a.y() != b.y())
+            points << QPointF(b.x(), a.y());
+        points << b;
+
+        auto wire = addWire(scene, points, netName);
+        scene.wire_manager()->attach_wire_to_connector(wire.get(), &from);
+        scene.wire_manager()->attach_wire_to_connector(wire.get(), &to);
+
+        return wire;
+    }
+
+}
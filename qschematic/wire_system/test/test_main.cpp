@@ -1,2 +1,17 @@
-#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#define DOCTEST_CONFIG_IMPLEMENT
 #include "3rdparty/doctest.h"
+
+#include <QApplication>
+
+int
+main(int argc, char** argv)
+{
+    // The scene level tests need an application but no display
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    QApplication app(argc, argv);
+
+    doctest::Context context(argc, argv);
+
+    return context.run();
+}
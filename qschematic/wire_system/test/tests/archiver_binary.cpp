@@ -0,0 +1,277 @@
+#include "../3rdparty/doctest.h"
+#include "../../../archiver_binary.hpp"
+
+#include <gpds/archiver_xml.hpp>
+#include <gpds/container.hpp>
+
+#include <chrono>
+#include <sstream>
+#include <string>
+
+namespace
+{
+
+    gpds::container
+    makeTree()
+    {
+        gpds::container label;
+        label.add_attribute("visible", "false");
+        label.add_value("text", std::string("GND"));
+
+        gpds::container wire;
+        wire.add_attribute("type-id", 2);
+        wire.add_value("points", std::string("0,0 10.5,0 10.5,-20"));
+        wire.add_value("label", label);
+
+        gpds::container root;
+        root.add_attribute("version", 3);
+        root.add_value("flag", true);
+        root.add_value("count", -42);
+        root.add_value("scale", 0.1);
+        root.add_value("name", std::string("sheet")).add_attribute("lang", "en");
+        root.add_value("wire", wire);
+        root.add_value("wire", gpds::container{ });
+
+        return root;
+    }
+
+    void
+    checkTree(const gpds::container& root)
+    {
+        CHECK_EQ(root.get_attribute<int>("version").value_or(0), 3);
+        CHECK_EQ(root.get_value<bool>("flag").value_or(false), true);
+        CHECK_EQ(root.get_value<int>("count").value_or(0), -42);
+        CHECK_EQ(root.get_value<double>("scale").value_or(0), 0.1);
+        CHECK_EQ(root.get_value<std::string>("name").value_or(""), "sheet");
+
+        const auto wires = root.get_values<gpds::container*>("wire");
+        REQUIRE_EQ(wires.size(), 2);
+        REQUIRE(wires[0]);
+        CHECK_EQ(wires[0]->get_attribute<int>("type-id").value_or(0), 2);
+        CHECK_EQ(wires[0]->get_value<std::string>("points").value_or(""), "0,0 10.5,0 10.5,-20");
+
+        const gpds::container* label = wires[0]->get_value<gpds::container*>("label").value_or(nullptr);
+        REQUIRE(label);
+        CHECK_EQ(label->get_attribute<std::string>("visible").value_or(""), "false");
+        CHECK_EQ(label->get_value<std::string>("text").value_or(""), "GND");
+
+        REQUIRE(wires[1]);
+        CHECK(wires[1]->values.empty());
+    }
+
+    std::string
+    save(const gpds::container& root)
+    {
+        std::ostringstream stream;
+        const auto [success, message] = QSchematic::ArchiverBinary().save(stream, root, "root");
+        REQUIRE_MESSAGE(success, message);
+
+        return stream.str();
+    }
+
+    std::string
+    roundTripPoints(const std::string& points)
+    {
+        gpds::container root;
+        root.add_value("points", points);
+
+        gpds::container loaded;
+        const auto [success, message] = QSchematic::ArchiverBinary().loadFromMemory(save(root), loaded, "root");
+        REQUIRE_MESSAGE(success, message);
+
+        return loaded.get_value<std::string>("points").value_or("<missing>");
+    }
+
+    /**
+     * A tree shaped like a scene with many wires on the grid.
+     */
+    gpds::container
+    makeScene(int wireCount)
+    {
+        gpds::container root;
+        root.add_attribute("version", 3);
+
+        for (int i = 0; i < wireCount; i++) {
+            const int x = 20 * (i % 100);
+            const int y = 20 * (i / 100);
+
+            gpds::container wire;
+            wire.add_attribute("type-id", 2);
+            wire.add_value("points", std::to_string(x) + "," + std::to_string(y) + " " + std::to_string(x + 200) + "," + std::to_string(y) + " " + std::to_string(x + 200) + "," + std::to_string(y + 140));
+
+            gpds::container net;
+            net.add_value("name", std::string(i % 3 ? "" : "SIG"));
+            net.add_value("wire", wire);
+
+            root.add_value("net", net);
+        }
+
+        return root;
+    }
+
+}
+
+TEST_SUITE("Binary archiver")
+{
+    TEST_CASE("save() & load(): The container tree survives the round trip")
+    {
+        const std::string data = save(makeTree());
+
+        gpds::container loaded;
+        std::istringstream stream(data);
+        const auto [success, message] = QSchematic::ArchiverBinary().load(stream, loaded, "root");
+        REQUIRE_MESSAGE(success, message);
+        checkTree(loaded);
+
+        // Saving the loaded tree again yields the same archive
+        CHECK_EQ(save(loaded), data);
+    }
+
+    TEST_CASE("convert(): Round trip through XML")
+    {
+        const std::string binary = save(makeTree());
+
+        std::istringstream binaryIn(binary);
+        std::ostringstream xmlOut;
+        QSchematic::ArchiverBinary binaryArchiver;
+        gpds::archiver_xml xmlArchiver;
+        {
+            const auto [success, message] = QSchematic::ArchiverBinary::convert(binaryIn, binaryArchiver, xmlOut, xmlArchiver, "root");
+            REQUIRE_MESSAGE(success, message);
+        }
+
+        std::istringstream xmlIn(xmlOut.str());
+        std::ostringstream binaryOut;
+        {
+            const auto [success, message] = QSchematic::ArchiverBinary::convert(xmlIn, xmlArchiver, binaryOut, binaryArchiver, "root");
+            REQUIRE_MESSAGE(success, message);
+        }
+
+        // Values read from XML are strings but convert back to the original values
+        gpds::container loaded;
+        const auto [success, message] = QSchematic::ArchiverBinary().loadFromMemory(binaryOut.str(), loaded, "root");
+        REQUIRE_MESSAGE(success, message);
+        checkTree(loaded);
+    }
+
+    TEST_CASE("loadFromMemory(): Malformed archives are rejected")
+    {
+        const std::string data = save(makeTree());
+        gpds::container loaded;
+
+        SUBCASE("Empty") {
+            CHECK_FALSE(QSchematic::ArchiverBinary().loadFromMemory("", loaded, "root").first);
+        }
+
+        SUBCASE("Bad magic") {
+            std::string corrupt = data;
+            corrupt[0] = 'X';
+            CHECK_FALSE(QSchematic::ArchiverBinary().loadFromMemory(corrupt, loaded, "root").first);
+        }
+
+        SUBCASE("Unsupported version") {
+            std::string corrupt = data;
+            corrupt[4] = static_cast<char>(QSchematic::ArchiverBinary::format_version + 1);
+            CHECK_FALSE(QSchematic::ArchiverBinary().loadFromMemory(corrupt, loaded, "root").first);
+        }
+
+        SUBCASE("Unexpected root name") {
+            CHECK_FALSE(QSchematic::ArchiverBinary().loadFromMemory(data, loaded, "other").first);
+        }
+
+        SUBCASE("Truncated") {
+            for (std::size_t size = 0; size < data.size(); size++)
+                CHECK_FALSE(QSchematic::ArchiverBinary().loadFromMemory(std::string_view(data).substr(0, size), loaded, "root").first);
+        }
+
+        SUBCASE("Trailing data") {
+            CHECK_FALSE(QSchematic::ArchiverBinary().loadFromMemory(data + '\0', loaded, "root").first);
+        }
+    }
+
+    TEST_CASE("save(): Points are stored as arrays of coordinates")
+    {
+        SUBCASE("Integral") {
+            CHECK_EQ(roundTripPoints("0,0 10,0 10,-20 -2147483648,2147483647"), "0,0 10,0 10,-20 -2147483648,2147483647");
+        }
+
+        SUBCASE("Fractional") {
+            CHECK_EQ(roundTripPoints("0,0 10.5,0 1e+300,-0.1"), "0,0 10.5,0 1e+300,-0.1");
+        }
+
+        SUBCASE("Negative zero") {
+            CHECK_EQ(roundTripPoints("-0,0"), "-0,0");
+        }
+
+        SUBCASE("Not packed points are kept as they are") {
+            CHECK_EQ(roundTripPoints(""), "");
+            CHECK_EQ(roundTripPoints("1.0,2"), "1.0,2");
+            CHECK_EQ(roundTripPoints(" 1,2"), " 1,2");
+            CHECK_EQ(roundTripPoints("1,2,3"), "1,2,3");
+            CHECK_EQ(roundTripPoints("hello"), "hello");
+        }
+
+        // The text is not part of the archive
+        gpds::container root;
+        root.add_value("points", std::string("1234,5678 -1234,5678"));
+        CHECK_EQ(save(root).find("1234"), std::string::npos);
+    }
+
+    TEST_CASE("Size & load time compared to XML")
+    {
+        using clock = std::chrono::steady_clock;
+
+        const gpds::container scene = makeScene(20000);
+
+        std::ostringstream xmlOut;
+        {
+            const auto [success, message] = gpds::archiver_xml().save(xmlOut, scene, "root");
+            REQUIRE_MESSAGE(success, message);
+        }
+        const std::string xml = xmlOut.str();
+
+        // Convert from XML (all values are strings)
+        std::istringstream xmlIn(xml);
+        std::ostringstream binaryOut;
+        {
+            gpds::archiver_xml xmlArchiver;
+            const auto [success, message] = QSchematic::ArchiverBinary::convert(xmlIn, xmlArchiver, binaryOut, QSchematic::ArchiverBinary(), "root");
+            REQUIRE_MESSAGE(success, message);
+        }
+        const std::string binary = binaryOut.str();
+
+        gpds::container fromXml;
+        const auto xmlStart = clock::now();
+        {
+            std::istringstream stream(xml);
+            const auto [success, message] = gpds::archiver_xml().load(stream, fromXml, "root");
+            REQUIRE_MESSAGE(success, message);
+        }
+        const auto xmlTime = clock::now() - xmlStart;
+
+        gpds::container fromBinary;
+        const auto binaryStart = clock::now();
+        {
+            const auto [success, message] = QSchematic::ArchiverBinary().loadFromMemory(binary, fromBinary, "root");
+            REQUIRE_MESSAGE(success, message);
+        }
+        const auto binaryTime = clock::now() - binaryStart;
+
+        MESSAGE("XML: " << xml.size() << " bytes, " << std::chrono::duration_cast<std::chrono::microseconds>(xmlTime).count() << " us");
+        MESSAGE("Binary: " << binary.size() << " bytes, " << std::chrono::duration_cast<std::chrono::microseconds>(binaryTime).count() << " us");
+        CHECK_LT(binary.size(), xml.size());
+
+        // Same content
+        const auto xmlNets = fromXml.get_values<gpds::container*>("net");
+        const auto binaryNets = fromBinary.get_values<gpds::container*>("net");
+        REQUIRE_EQ(xmlNets.size(), binaryNets.size());
+        for (std::size_t i = 0; i < xmlNets.size(); i += 997) {
+            CAPTURE(i);
+            const auto* xmlWire = xmlNets[i]->get_value<gpds::container*>("wire").value_or(nullptr);
+            const auto* binaryWire = binaryNets[i]->get_value<gpds::container*>("wire").value_or(nullptr);
+            REQUIRE(xmlWire);
+            REQUIRE(binaryWire);
+            CHECK_EQ(binaryWire->get_value<std::string>("points").value_or(""), xmlWire->get_value<std::string>("points").value_or("<missing>"));
+        }
+    }
+}
@@ -0,0 +1,263 @@
+#include "../3rdparty/doctest.h"
+#include "../scene_fixture.hpp"
+#include "../../../auto_save.hpp"
+#include "../../../commands/item_add.hpp"
+#include "../../../commands/item_move.hpp"
+#include "../../../commands/item_remove.hpp"
+
+#include <gpds/container.hpp>
+
+#include <QEventLoop>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTimer>
+
+#include <algorithm>
+#include <chrono>
+#include <optional>
+#include <utility>
+#include <vector>
+
+using namespace QSchematic;
+using namespace std::chrono_literals;
+
+namespace
+{
+
+    /**
+     * A node which counts how often it got serialized.
+     */
+    class CountingNode :
+        public Items::Node
+    {
+    public:
+        mutable int serialized = 0;
+
+        gpds::container
+        to_container() const override
+        {
+            serialized++;
+
+            return Items::Node::to_container();
+        }
+    };
+
+    std::shared_ptr<CountingNode>
+    makeNode(const QPointF& pos)
+    {
+        auto node = std::make_shared<CountingNode>();
+        node->setSize(80, 60);
+        node->addConnector(std::make_shared<Items::Connector>(Items::Item::ConnectorType, QPoint(0, 1), QStringLiteral("P0")));
+        node->setPos(pos);
+
+        return node;
+    }
+
+    /**
+     * Save & process events until the save finished.
+     */
+    std::optional<bool>
+    save(AutoSave& autoSave, std::chrono::milliseconds timeout = 5s)
+    {
+        std::optional<bool> success;
+        if (!autoSave.save())
+            return success;
+
+        QEventLoop loop;
+        const auto connection = QObject::connect(&autoSave, &AutoSave::saved, &loop, [&success, &loop](bool result, const QString& message) {
+            CAPTURE(message);
+            CHECK(result);
+            success = result;
+            loop.quit();
+        });
+        QTimer::singleShot(timeout, &loop, &QEventLoop::quit);
+        loop.exec();
+        QObject::disconnect(connection);
+
+        return success;
+    }
+
+    std::vector<std::pair<qreal, qreal>>
+    nodePositions(const Scene& scene)
+    {
+        std::vector<std::pair<qreal, qreal>> ret;
+        for (const auto& node : scene.items<Items::Node>())
+            ret.emplace_back(node->pos().x(), node->pos().y());
+        std::ranges::sort(ret);
+
+        return ret;
+    }
+
+    std::vector<QString>
+    netNames(const Scene& scene)
+    {
+        std::vector<QString> ret;
+        for (const auto& net : scene.wire_manager()->nets())
+            ret.push_back(net->name());
+        std::ranges::sort(ret);
+
+        return ret;
+    }
+
+    void
+    load(Scene& scene, const QString& filePath)
+    {
+        const auto [success, message] = AutoSave::load(scene, filePath);
+        REQUIRE_MESSAGE(success, message);
+    }
+
+}
+
+TEST_SUITE("Auto save")
+{
+    TEST_CASE("save(): Only changed items are serialized again")
+    {
+        QTemporaryDir dir;
+        REQUIRE(dir.isValid());
+
+        Scene scene;
+        std::vector<std::shared_ptr<CountingNode>> nodes;
+        for (int i = 0; i < 3; i++) {
+            nodes.push_back(makeNode(QPointF(400 * i, 0)));
+            scene.addItem(nodes.back());
+        }
+
+        AutoSave autoSave(&scene);
+        autoSave.setFilePath(dir.filePath("sheet.autosave"));
+        REQUIRE_EQ(save(autoSave), true);
+        for (const auto& node : nodes)
+            CHECK_EQ(node->serialized, 1);
+
+        // Nothing changed
+        CHECK_FALSE(autoSave.save());
+
+        // Changed through the undo stack
+        scene.undoStack()->push(new Commands::ItemMove({ nodes[1] }, QVector2D(0, 100)));
+        REQUIRE_EQ(save(autoSave), true);
+        CHECK_EQ(nodes[0]->serialized, 1);
+        CHECK_EQ(nodes[1]->serialized, 2);
+        CHECK_EQ(nodes[2]->serialized, 1);
+
+        // Added & removed
+        auto added = makeNode(QPointF(0, 400));
+        scene.undoStack()->push(new Commands::ItemAdd(&scene, added));
+        scene.undoStack()->push(new Commands::ItemRemove(&scene, nodes[2]));
+        REQUIRE_EQ(save(autoSave), true);
+        CHECK_EQ(nodes[0]->serialized, 1);
+        CHECK_EQ(nodes[1]->serialized, 2);
+        CHECK_EQ(nodes[2]->serialized, 1);
+        CHECK_EQ(added->serialized, 1);
+
+        Scene loaded;
+        load(loaded, autoSave.filePath());
+        CHECK_EQ(nodePositions(loaded), nodePositions(scene));
+
+        // A reset serializes everything again
+        scene.undoStack()->clear();
+        REQUIRE_EQ(save(autoSave), true);
+        CHECK_EQ(nodes[0]->serialized, 2);
+        CHECK_EQ(nodes[1]->serialized, 3);
+        CHECK_EQ(added->serialized, 2);
+    }
+
+    TEST_CASE("save(): Items & nets changed without a command are captured")
+    {
+        QTemporaryDir dir;
+        REQUIRE(dir.isValid());
+
+        Scene scene;
+        auto a = fixture::addNode(scene, QPointF(0, 0));
+        auto b = fixture::addNode(scene, QPointF(400, 0));
+
+        AutoSave autoSave(&scene);
+        autoSave.setFilePath(dir.filePath("sheet.autosave"));
+        REQUIRE_EQ(save(autoSave), true);
+
+        // Added directly
+        auto c = fixture::addNode(scene, QPointF(800, 0));
+        fixture::connect(scene, *a->connectors().at(0), *b->connectors().at(0), QStringLiteral("VCC"));
+        auto wire = fixture::addWire(scene, { { 0, 200 }, { 200, 200 } }, QStringLiteral("GND"));
+        auto branch = fixture::addWire(scene, { { 100, 200 }, { 100, 300 } });
+        REQUIRE_EQ(save(autoSave), true);
+        {
+            Scene loaded;
+            load(loaded, autoSave.filePath());
+            CHECK_EQ(nodePositions(loaded), nodePositions(scene));
+            CHECK_EQ(netNames(loaded), std::vector<QString>{ QString(), QStringLiteral("GND"), QStringLiteral("VCC") });
+        }
+
+        // Merged & removed directly
+        scene.wire_manager()->connect_wire(wire.get(), branch.get(), 0);
+        scene.removeItem(c);
+        REQUIRE_EQ(save(autoSave), true);
+        {
+            Scene loaded;
+            load(loaded, autoSave.filePath());
+            CHECK_EQ(nodePositions(loaded), nodePositions(scene));
+            CHECK_EQ(netNames(loaded), std::vector<QString>{ QStringLiteral("GND"), QStringLiteral("VCC") });
+        }
+    }
+
+    TEST_CASE("load(): The connectivity is reconstructed")
+    {
+        QTemporaryDir dir;
+        REQUIRE(dir.isValid());
+
+        Scene scene;
+        auto a = fixture::addNode(scene, QPointF(0, 0));
+        auto b = fixture::addNode(scene, QPointF(400, 0));
+        fixture::connect(scene, *a->connectors().at(0), *b->connectors().at(0), QStringLiteral("VCC"));
+
+        AutoSave autoSave(&scene);
+        autoSave.setFilePath(dir.filePath("sheet.autosave"));
+        REQUIRE_EQ(save(autoSave), true);
+
+        Scene loaded;
+        load(loaded, autoSave.filePath());
+        CHECK_EQ(nodePositions(loaded), nodePositions(scene));
+        CHECK_EQ(netNames(loaded), std::vector<QString>{ QStringLiteral("VCC") });
+
+        std::size_t attached = 0;
+        for (const auto& node : loaded.items<Items::Node>()) {
+            const auto record = loaded.wire_manager()->attached_wire(node->connectors().at(0).get());
+            attached += record && record->wire;
+        }
+        CHECK_EQ(attached, 2);
+    }
+
+    TEST_CASE("load(): Invalid files are rejected")
+    {
+        QTemporaryDir dir;
+        REQUIRE(dir.isValid());
+        const QString filePath = dir.filePath("sheet.autosave");
+
+        Scene scene;
+
+        SUBCASE("Missing") {
+        }
+
+        SUBCASE("Bad magic") {
+            QFile file(filePath);
+            REQUIRE(file.open(QIODevice::WriteOnly));
+            file.write("QSXX");
+            file.write(qCompress(QByteArray("data")));
+        }
+
+        SUBCASE("Not compressed") {
+            QFile file(filePath);
+            REQUIRE(file.open(QIODevice::WriteOnly));
+            file.write("QSAS");
+            file.write("garbage");
+        }
+
+        SUBCASE("Not an archive") {
+            QFile file(filePath);
+            REQUIRE(file.open(QIODevice::WriteOnly));
+            file.write("QSAS");
+            file.write(qCompress(QByteArray("garbage")));
+        }
+
+        CHECK_FALSE(AutoSave::load(scene, filePath).first);
+        CHECK(scene.items().isEmpty());
+    }
+}
@@ -0,0 +1,202 @@
+#include "../3rdparty/doctest.h"
+#include "../scene_fixture.hpp"
+#include "../../../erc.hpp"
+
+#include <QEventLoop>
+#include <QTimer>
+
+#include <algorithm>
+#include <chrono>
+#include <optional>
+
+using namespace QSchematic;
+using namespace std::chrono_literals;
+
+namespace
+{
+
+    struct Run
+    {
+        std::vector<Erc::Violation> violations;
+        std::size_t checkedCount = 0;
+    };
+
+    /**
+     * Process events until the next check finished.
+     */
+    std::optional<Run>
+    waitForFinished(Erc& erc, std::chrono::milliseconds timeout = 5s)
+    {
+        std::optional<Run> run;
+
+        QEventLoop loop;
+        const auto connection = QObject::connect(&erc, &Erc::finished, &loop, [&run, &loop](const std::vector<Erc::Violation>& violations, std::size_t checkedCount) {
+            run = Run{ violations, checkedCount };
+            loop.quit();
+        });
+        QTimer::singleShot(timeout, &loop, &QEventLoop::quit);
+        loop.exec();
+        QObject::disconnect(connection);
+
+        return run;
+    }
+
+    std::optional<Run>
+    check(Erc& erc)
+    {
+        erc.run();
+
+        return waitForFinished(erc);
+    }
+
+    std::size_t
+    count(const std::vector<Erc::Violation>& violations, Erc::Rule rule)
+    {
+        return std::ranges::count_if(violations, [rule](const Erc::Violation& violation) { return violation.rule == rule; });
+    }
+
+}
+
+TEST_SUITE("ERC")
+{
+    TEST_CASE("Connected nodes pass")
+    {
+        Scene scene;
+        const auto a = fixture::addNode(scene, { 0, 0 }, 1);
+        const auto b = fixture::addNode(scene, { 200, 0 }, 1);
+        fixture::connect(scene, *a->connectors().at(0), *b->connectors().at(0));
+
+        Erc erc(&scene);
+        const auto run = check(erc);
+        REQUIRE(run);
+        CHECK(run->violations.empty());
+    }
+
+    TEST_CASE("Single pin nets & dangling wire ends")
+    {
+        Scene scene;
+        const auto node = fixture::addNode(scene, { 0, 0 }, 1);
+        const auto& connector = *node->connectors().at(0);
+        const QPointF start = connector.position();
+        const QPointF end = start - QPointF(100, 0);
+
+        const auto wire = fixture::addWire(scene, { start, end });
+        scene.wire_manager()->attach_wire_to_connector(wire.get(), &connector);
+
+        Erc erc(&scene);
+        const auto run = check(erc);
+        REQUIRE(run);
+        CHECK_EQ(count(run->violations, Erc::Rule::SinglePinNet), 1);
+        REQUIRE_EQ(count(run->violations, Erc::Rule::DanglingWireEnd), 1);
+
+        const auto dangling = std::ranges::find(run->violations, Erc::Rule::DanglingWireEnd, &Erc::Violation::rule);
+        CHECK_EQ(dangling->position, end);
+
+        SUBCASE("Disabled rules are not reported") {
+            erc.setRuleEnabled(Erc::Rule::DanglingWireEnd, false);
+            const auto rerun = check(erc);
+            REQUIRE(rerun);
+            CHECK_EQ(count(rerun->violations, Erc::Rule::SinglePinNet), 1);
+            CHECK_EQ(count(rerun->violations, Erc::Rule::DanglingWireEnd), 0);
+        }
+    }
+
+    TEST_CASE("Shorted named nets")
+    {
+        Scene scene;
+        fixture::addWire(scene, { { 0, 400 }, { 200, 400 } }, QStringLiteral("VCC"));
+        fixture::addWire(scene, { { 100, 400 }, { 100, 600 } }, QStringLiteral("GND"));
+        fixture::addWire(scene, { { 1000, 400 }, { 1000, 600 } }, QStringLiteral("SIG"));
+
+        Erc erc(&scene);
+        const auto run = check(erc);
+        REQUIRE(run);
+        REQUIRE_EQ(count(run->violations, Erc::Rule::ShortedNets), 1);
+
+        const auto shorted = std::ranges::find(run->violations, Erc::Rule::ShortedNets, &Erc::Violation::rule);
+        CHECK_EQ(shorted->net, "GND, VCC");
+        CHECK_EQ(shorted->position, QPointF(100, 400));
+    }
+
+    TEST_CASE("Unconnected connectors are opt-in")
+    {
+        Scene scene;
+        fixture::addNode(scene, { 0, 0 }, 3);
+
+        Erc erc(&scene);
+        CHECK_FALSE(erc.isRuleEnabled(Erc::Rule::UnconnectedConnector));
+        {
+            const auto run = check(erc);
+            REQUIRE(run);
+            CHECK(run->violations.empty());
+        }
+
+        erc.setRuleEnabled(Erc::Rule::UnconnectedConnector, true);
+        {
+            const auto run = check(erc);
+            REQUIRE(run);
+            CHECK_EQ(count(run->violations, Erc::Rule::UnconnectedConnector), 3);
+        }
+    }
+
+    TEST_CASE("Unchanged nets are not checked again")
+    {
+        Scene scene;
+        for (int i = 0; i < 5; i++)
+            fixture::addWire(scene, { { 200.0 * i, 0 }, { 200.0 * i, 100 } }, QStringLiteral("NET%1").arg(i));
+
+        Erc erc(&scene);
+        const auto first = check(erc);
+        REQUIRE(first);
+        CHECK_EQ(first->checkedCount, 5);
+
+        const auto second = check(erc);
+        REQUIRE(second);
+        CHECK_EQ(second->checkedCount, 0);
+        CHECK_EQ(second->violations.size(), first->violations.size());
+
+        // Only the new net is checked
+        fixture::addWire(scene, { { 5000, 0 }, { 5000, 100 } }, QStringLiteral("NEW"));
+        const auto third = check(erc);
+        REQUIRE(third);
+        CHECK_EQ(third->checkedCount, 1);
+        CHECK_EQ(count(third->violations, Erc::Rule::DanglingWireEnd), 12);
+
+        // Changing the rules discards the cached results
+        erc.setRuleEnabled(Erc::Rule::SinglePinNet, false);
+        const auto fourth = check(erc);
+        REQUIRE(fourth);
+        CHECK_EQ(fourth->checkedCount, 6);
+    }
+
+    TEST_CASE("Subsequent changes are coalesced into a single run")
+    {
+        Scene scene;
+        Erc erc(&scene);
+        erc.setDelay(50ms);
+
+        std::size_t runs = 0;
+        QObject::connect(&erc, &Erc::finished, [&runs] { runs++; });
+
+        for (int i = 0; i < 3; i++)
+            fixture::addWire(scene, { { 200.0 * i, 0 }, { 200.0 * i, 100 } });
+
+        QEventLoop loop;
+        QTimer::singleShot(500ms, &loop, &QEventLoop::quit);
+        loop.exec();
+
+        CHECK_EQ(runs, 1);
+        CHECK_EQ(count(erc.violations(), Erc::Rule::DanglingWireEnd), 6);
+
+        SUBCASE("Disabled checks are not scheduled") {
+            erc.setEnabled(false);
+            fixture::addWire(scene, { { 1000, 0 }, { 1000, 100 } });
+
+            QEventLoop idle;
+            QTimer::singleShot(200ms, &idle, &QEventLoop::quit);
+            idle.exec();
+
+            CHECK_EQ(runs, 1);
+        }
+    }
+}
@@ -0,0 +1,237 @@
+#include "../3rdparty/doctest.h"
+#include "../../../items/itemfactory.hpp"
+#include "../../../items/label.hpp"
+#include "../../../items/node.hpp"
+
+#include <gpds/container.hpp>
+
+#include <atomic>
+#include <memory_resource>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace QSchematic;
+using namespace QSchematic::Items;
+
+namespace
+{
+
+    constexpr int CustomType = Item::QSchematicItemUserType + 1;
+
+    /**
+     * A node which remembers who constructed it.
+     */
+    class Marker :
+        public Node
+    {
+    public:
+        const std::string source;
+
+        Marker(int type, std::string source) :
+            Node(type),
+            source(std::move(source))
+        {
+        }
+    };
+
+    /**
+     * Restores the factory once the test is done.
+     */
+    struct FactoryState
+    {
+        ~FactoryState()
+        {
+            Factory& factory = Factory::instance();
+            factory.setCustomItemsFactory({ });
+            factory.unregisterType(Item::NodeType);
+            factory.unregisterType(CustomType);
+        }
+    };
+
+    /**
+     * Memory resource which keeps track of the outstanding allocations.
+     */
+    class CountingResource :
+        public std::pmr::memory_resource
+    {
+    public:
+        std::atomic<std::size_t> outstanding = 0;
+
+    private:
+        void*
+        do_allocate(std::size_t bytes, std::size_t alignment) override
+        {
+            outstanding += bytes;
+
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void
+        do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+        {
+            outstanding -= bytes;
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+
+        bool
+        do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+
+    /**
+     * Installs a counting resource as the default (upstream) resource of the pools.
+     */
+    struct CountingScope
+    {
+        CountingResource resource;
+        std::pmr::memory_resource* previous = std::pmr::set_default_resource(&resource);
+
+        ~CountingScope()
+        {
+            std::pmr::set_default_resource(previous);
+        }
+    };
+
+    std::shared_ptr<Item>
+    construct(int typeId)
+    {
+        gpds::container container;
+        container.add_attribute("type-id", typeId);
+
+        return Factory::instance().from_container(container);
+    }
+
+    /**
+     * Who constructed the item of the specified type.
+     */
+    std::string
+    source(int typeId)
+    {
+        const auto item = construct(typeId);
+        if (!item)
+            return "none";
+        if (const auto marker = std::dynamic_pointer_cast<Marker>(item); marker)
+            return marker->source;
+
+        return "built-in";
+    }
+
+}
+
+TEST_SUITE("Item factory")
+{
+    TEST_CASE("from_container(): Registered types take precedence over custom & built-in types")
+    {
+        const FactoryState state;
+        Factory& factory = Factory::instance();
+
+        // Built-in only
+        CHECK_EQ(source(Item::NodeType), "built-in");
+        CHECK_EQ(source(CustomType), "none");
+        CHECK(factory.isRegistered(Item::NodeType));
+        CHECK_FALSE(factory.isRegistered(CustomType));
+
+        // Custom factory
+        factory.setCustomItemsFactory([](const gpds::container& container) -> std::shared_ptr<Item> {
+            const int type = Factory::extractType(container);
+            if (type == Item::LabelType)
+                return { };
+
+            return std::make_shared<Marker>(type, "custom");
+        });
+        CHECK_EQ(source(Item::NodeType), "custom");
+        CHECK_EQ(source(CustomType), "custom");
+        CHECK(std::dynamic_pointer_cast<Label>(construct(Item::LabelType)));
+
+        // Registered types
+        factory.registerType(Item::NodeType, [] { return std::make_shared<Marker>(Item::NodeType, "registered"); });
+        factory.registerType(CustomType, [] { return std::make_shared<Marker>(CustomType, "registered"); });
+        CHECK_EQ(source(Item::NodeType), "registered");
+        CHECK_EQ(source(CustomType), "registered");
+        CHECK(factory.isRegistered(CustomType));
+
+        // Registering again replaces the previous registration
+        factory.registerType(CustomType, [] { return std::make_shared<Marker>(CustomType, "replaced"); });
+        CHECK_EQ(source(CustomType), "replaced");
+
+        // Unregistering falls back to the custom factory
+        factory.unregisterType(Item::NodeType);
+        factory.registerType(CustomType, { });
+        CHECK_EQ(source(Item::NodeType), "custom");
+        CHECK_EQ(source(CustomType), "custom");
+        CHECK_FALSE(factory.isRegistered(CustomType));
+
+        // ... and to the built-in types
+        factory.setCustomItemsFactory({ });
+        CHECK_EQ(source(Item::NodeType), "built-in");
+        CHECK_EQ(source(CustomType), "none");
+        CHECK(factory.isRegistered(Item::NodeType));
+    }
+
+    TEST_CASE("PooledConstruction: A surviving item retains a single pool")
+    {
+        const CountingScope counting;
+
+        // Enough items to fill many pools
+        const std::size_t count = 16 * Factory::pool_capacity / sizeof(Node);
+        std::vector<std::shared_ptr<Item>> items;
+        items.reserve(count);
+        {
+            const Factory::PooledConstruction outer;
+            const Factory::PooledConstruction inner;
+            for (std::size_t i = 0; i < count; i++)
+                items.push_back(construct(Item::NodeType));
+        }
+        REQUIRE_EQ(items.size(), count);
+        for (const auto& item : items) {
+            REQUIRE(std::dynamic_pointer_cast<Node>(item));
+            item->setPos(20, 40);
+        }
+        CHECK_GE(counting.resource.outstanding.load(), 8 * Factory::pool_capacity);
+
+        // Keep the first item only
+        items.resize(1);
+        CHECK_LT(counting.resource.outstanding.load(), 4 * Factory::pool_capacity);
+        CHECK_EQ(items.front()->pos(), QPointF(20, 40));
+
+        items.clear();
+        CHECK_EQ(counting.resource.outstanding.load(), 0);
+
+        // Not pooled outside of a guard
+        const auto item = construct(Item::NodeType);
+        REQUIRE(item);
+        CHECK_EQ(counting.resource.outstanding.load(), 0);
+    }
+
+    TEST_CASE("PooledConstruction: Guards can be used from multiple threads")
+    {
+        const CountingScope counting;
+
+        constexpr int threadCount = 4;
+        constexpr int itemCount = 2000;
+        std::atomic<int> constructed = 0;
+        {
+            std::vector<std::jthread> threads;
+            for (int i = 0; i < threadCount; i++) {
+                threads.emplace_back([&constructed] {
+                    std::vector<std::shared_ptr<Item>> items;
+                    for (int round = 0; round < 4; round++) {
+                        const Factory::PooledConstruction pooledConstruction;
+                        for (int j = 0; j < itemCount / 4; j++) {
+                            if (auto item = construct(Item::NodeType); std::dynamic_pointer_cast<Node>(item))
+                                items.push_back(std::move(item));
+                        }
+                    }
+                    constructed += static_cast<int>(items.size());
+                });
+            }
+        }
+
+        CHECK_EQ(constructed.load(), threadCount * itemCount);
+        CHECK_EQ(counting.resource.outstanding.load(), 0);
+    }
+}
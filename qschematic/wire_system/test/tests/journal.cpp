@@ -0,0 +1,251 @@
+#include "../3rdparty/doctest.h"
+#include "../scene_fixture.hpp"
+#include "../../../journal.hpp"
+#include "../../../commands/item_add.hpp"
+#include "../../../commands/item_remove.hpp"
+#include "../../../commands/wirenet_rename.hpp"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+using namespace QSchematic;
+
+namespace
+{
+
+    std::vector<std::pair<qreal, qreal>>
+    nodePositions(const Scene& scene)
+    {
+        std::vector<std::pair<qreal, qreal>> ret;
+        for (const auto& node : scene.items<Items::Node>())
+            ret.emplace_back(node->pos().x(), node->pos().y());
+        std::ranges::sort(ret);
+
+        return ret;
+    }
+
+    std::vector<QString>
+    netNames(const Scene& scene)
+    {
+        std::vector<QString> ret;
+        for (const auto& net : scene.wire_manager()->nets())
+            ret.push_back(net->name());
+        std::ranges::sort(ret);
+
+        return ret;
+    }
+
+    /**
+     * Three nodes of which the first two are connected.
+     */
+    std::vector<std::shared_ptr<Items::Node>>
+    makeScene(Scene& scene)
+    {
+        std::vector<std::shared_ptr<Items::Node>> nodes;
+        for (int i = 0; i < 3; i++)
+            nodes.push_back(fixture::addNode(scene, QPointF(400 * i, 0)));
+        fixture::connect(scene, *nodes[0]->connectors().at(0), *nodes[1]->connectors().at(0), QStringLiteral("VCC"));
+
+        return nodes;
+    }
+
+    void
+    recover(Scene& scene, const QString& basePath)
+    {
+        const auto [success, message] = Journal::recover(scene, basePath);
+        REQUIRE_MESSAGE(success, message);
+    }
+
+    void
+    addNode(Scene& scene, const QPointF& pos)
+    {
+        scene.undoStack()->push(new Commands::ItemAdd(&scene, fixture::makeNode(pos)));
+    }
+
+    void
+    truncate(const QString& filePath, qint64 size)
+    {
+        QFile file(filePath);
+        REQUIRE(file.resize(size));
+    }
+
+}
+
+TEST_SUITE("Journal")
+{
+    TEST_CASE("recover(): Replays the flushed changes")
+    {
+        QTemporaryDir dir;
+        REQUIRE(dir.isValid());
+        const QString base = dir.filePath("sheet");
+
+        Scene scene;
+        const auto nodes = makeScene(scene);
+
+        Journal journal(&scene);
+        journal.setCompactionRatio(1000);
+        REQUIRE(journal.open(base));
+
+        addNode(scene, QPointF(0, 400));
+        scene.undoStack()->push(new Commands::ItemRemove(&scene, nodes[2]));
+        const auto vcc = std::dynamic_pointer_cast<Items::WireNet>(scene.wire_manager()->nets().front());
+        REQUIRE(vcc);
+        scene.undoStack()->push(new Commands::WirenetRename(vcc, QStringLiteral("GND")));
+        CHECK_GT(journal.pendingCount(), 0);
+        REQUIRE(journal.flush());
+        CHECK_EQ(journal.pendingCount(), 0);
+
+        Scene recovered;
+        recover(recovered, base);
+        CHECK_EQ(nodePositions(recovered), nodePositions(scene));
+        CHECK_EQ(netNames(recovered), std::vector<QString>{ QStringLiteral("GND") });
+    }
+
+    TEST_CASE("flush(): Nets changed by the wire system are journaled")
+    {
+        QTemporaryDir dir;
+        REQUIRE(dir.isValid());
+        const QString base = dir.filePath("sheet");
+
+        Scene scene;
+        auto wire = fixture::addWire(scene, { { 0, 0 }, { 200, 0 } }, QStringLiteral("A"));
+        auto branch = fixture::addWire(scene, { { 100, 0 }, { 100, 200 } });
+
+        Journal journal(&scene);
+        journal.setCompactionRatio(1000);
+        REQUIRE(journal.open(base));
+        CHECK_EQ(journal.pendingCount(), 0);
+
+        // Merge the nets outside of the undo stack
+        scene.wire_manager()->connect_wire(wire.get(), branch.get(), 0);
+        REQUIRE_EQ(scene.wire_manager()->nets().size(), 1);
+        CHECK_GT(journal.pendingCount(), 0);
+        REQUIRE(journal.flush());
+
+        Scene recovered;
+        recover(recovered, base);
+        REQUIRE_EQ(recovered.wire_manager()->nets().size(), 1);
+        CHECK_EQ(recovered.wire_manager()->nets().front()->wires().size(), 2);
+        CHECK_EQ(netNames(recovered), std::vector<QString>{ QStringLiteral("A") });
+    }
+
+    TEST_CASE("recover(): Truncated & corrupt records end the replay")
+    {
+        QTemporaryDir dir;
+        REQUIRE(dir.isValid());
+        const QString base = dir.filePath("sheet");
+        const QString journalPath = base + QStringLiteral(".journal");
+
+        Scene scene;
+        makeScene(scene);
+        const auto initial = nodePositions(scene);
+
+        Journal journal(&scene);
+        journal.setCompactionRatio(1000);
+        REQUIRE(journal.open(base));
+        const qint64 headerSize = QFileInfo(journalPath).size();
+
+        addNode(scene, QPointF(0, 400));
+        REQUIRE(journal.flush());
+        const auto first = nodePositions(scene);
+        const qint64 firstSize = QFileInfo(journalPath).size();
+
+        addNode(scene, QPointF(400, 400));
+        REQUIRE(journal.flush());
+        const qint64 secondSize = QFileInfo(journalPath).size();
+        REQUIRE_LT(headerSize, firstSize);
+        REQUIRE_LT(firstSize, secondSize);
+        journal.close();
+
+        Scene recovered;
+
+        SUBCASE("Complete") {
+            recover(recovered, base);
+            CHECK_EQ(nodePositions(recovered), nodePositions(scene));
+        }
+
+        SUBCASE("Truncated record") {
+            for (const qint64 size : { secondSize - 1, (firstSize + secondSize) / 2, firstSize + 1 }) {
+                CAPTURE(size);
+                truncate(journalPath, size);
+                recover(recovered, base);
+                CHECK_EQ(nodePositions(recovered), first);
+            }
+        }
+
+        SUBCASE("Truncated header") {
+            truncate(journalPath, headerSize - 1);
+            recover(recovered, base);
+            CHECK_EQ(nodePositions(recovered), initial);
+        }
+
+        SUBCASE("Corrupt record") {
+            QFile file(journalPath);
+            REQUIRE(file.open(QIODevice::ReadWrite));
+            REQUIRE(file.seek(firstSize + 8));
+            char byte = 0;
+            REQUIRE(file.getChar(&byte));
+            REQUIRE(file.seek(firstSize + 8));
+            REQUIRE(file.putChar(char(~byte)));
+            file.close();
+
+            recover(recovered, base);
+            CHECK_EQ(nodePositions(recovered), first);
+        }
+
+        SUBCASE("Missing journal") {
+            REQUIRE(QFile::remove(journalPath));
+            recover(recovered, base);
+            CHECK_EQ(nodePositions(recovered), initial);
+        }
+    }
+
+    TEST_CASE("recover(): Journals of another generation are ignored")
+    {
+        QTemporaryDir dir;
+        REQUIRE(dir.isValid());
+        const QString base = dir.filePath("sheet");
+        const QString journalPath = base + QStringLiteral(".journal");
+
+        Scene scene;
+        const auto nodes = makeScene(scene);
+
+        Journal journal(&scene);
+        journal.setCompactionRatio(1000);
+        REQUIRE(journal.open(base));
+
+        // Remove the first item of the snapshot
+        scene.undoStack()->push(new Commands::ItemRemove(&scene, nodes[0]));
+        REQUIRE(journal.flush());
+        QFile file(journalPath);
+        REQUIRE(file.open(QIODevice::ReadOnly));
+        const QByteArray previous = file.readAll();
+        file.close();
+
+        // Replaying the previous journal on the new snapshot would remove another item
+        REQUIRE(journal.snapshot());
+        journal.close();
+        REQUIRE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        REQUIRE_EQ(file.write(previous), previous.size());
+        file.close();
+
+        Scene recovered;
+        recover(recovered, base);
+        CHECK_EQ(nodePositions(recovered), nodePositions(scene));
+        CHECK_EQ(recovered.items<Items::Node>().size(), 2);
+    }
+
+    TEST_CASE("recover(): Missing snapshots are rejected")
+    {
+        QTemporaryDir dir;
+        REQUIRE(dir.isValid());
+
+        Scene scene;
+        CHECK_FALSE(Journal::recover(scene, dir.filePath("missing")).first);
+    }
+}
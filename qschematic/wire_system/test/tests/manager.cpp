@@ -155,6 +155,44 @@ TEST_SUITE("Manager")
         }
     }
 
+    TEST_CASE ("connector_attachment_changed(): Attaching and detaching is reported")
+    {
+        wire_system::manager manager;
+
+        auto wire = std::make_shared<wire_system::wire>();
+        wire->append_point({0, 10});
+        wire->append_point({10, 10});
+        manager.add_wire(wire);
+
+        connector conn;
+        conn.pos = QPointF(10, 10);
+
+        std::vector<const wire_system::connectable*> reported;
+        QObject::connect(&manager, &wire_system::manager::connector_attachment_changed, [&reported](const wire_system::connectable* c) {
+            reported.push_back(c);
+        });
+
+        // Attaching
+        manager.attach_wire_to_connector(wire.get(), &conn);
+        REQUIRE_EQ(reported.size(), 1);
+        REQUIRE_EQ(reported.back(), &conn);
+
+        // Attaching again does nothing
+        manager.attach_wire_to_connector(wire.get(), &conn);
+        REQUIRE_EQ(reported.size(), 1);
+
+        // Detaching
+        manager.detach_wire(&conn);
+        REQUIRE_EQ(reported.size(), 2);
+        REQUIRE_EQ(reported.back(), &conn);
+
+        // Removing the wire detaches it
+        manager.attach_wire_to_connector(wire.get(), &conn);
+        manager.remove_wire(wire);
+        REQUIRE_EQ(reported.size(), 4);
+        REQUIRE_EQ(reported.back(), &conn);
+    }
+
     TEST_CASE ("connector_moved(): Moving a connector with a wire attached")
     {
         wire_system::manager manager;
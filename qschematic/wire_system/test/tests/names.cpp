@@ -0,0 +1,113 @@
+#include "../3rdparty/doctest.h"
+#include "../../manager.hpp"
+#include "../../name_table.hpp"
+#include "../../net.hpp"
+
+TEST_SUITE("Name table")
+{
+    TEST_CASE("intern(): Equal names share the same ID")
+    {
+        wire_system::name_table names;
+
+        const auto id1 = names.intern("VCC");
+        const auto id2 = names.intern(QString("VC") + "C");
+        const auto id3 = names.intern("GND");
+
+        CHECK_EQ(id1, id2);
+        CHECK_NE(id1, id3);
+        CHECK_EQ(names.name(id1), "VCC");
+        CHECK_EQ(names.name(id3), "GND");
+        CHECK_EQ(names.size(), 3);
+    }
+
+    TEST_CASE("intern(): The empty name has the empty ID")
+    {
+        wire_system::name_table names;
+
+        CHECK_EQ(names.intern(""), wire_system::name_table::empty_id);
+        CHECK_EQ(names.name(wire_system::name_table::empty_id), "");
+        CHECK_EQ(names.size(), 1);
+    }
+
+    TEST_CASE("find(): Only returns previously interned names")
+    {
+        wire_system::name_table names;
+
+        const auto id = names.intern("VCC");
+
+        CHECK_EQ(names.find("VCC"), id);
+        CHECK_FALSE(names.find("GND").has_value());
+    }
+
+    TEST_CASE("Nets get their name interned by the manager")
+    {
+        wire_system::manager manager;
+
+        auto net1 = std::make_shared<wire_system::net>();
+        net1->set_name(QString("VCC"));
+        manager.add_net(net1);
+
+        auto net2 = std::make_shared<wire_system::net>();
+        manager.add_net(net2);
+        net2->set_name(QString("VCC"));
+
+        CHECK_NE(net1->name_id(), wire_system::name_table::empty_id);
+        CHECK_EQ(net1->name_id(), net2->name_id());
+        CHECK_EQ(manager.names().find("VCC"), net1->name_id());
+    }
+
+    TEST_CASE("global_nets(): Nets are grouped by name")
+    {
+        wire_system::manager manager;
+
+        for (const auto& name : { "VCC", "", "GND", "VCC", "" }) {
+            auto net = std::make_shared<wire_system::net>();
+            net->set_name(QString(name));
+            manager.add_net(net);
+        }
+
+        const auto global_nets = manager.global_nets();
+        REQUIRE_EQ(std::size(global_nets), 4);
+
+        CHECK_EQ(global_nets[0].name, "VCC");
+        CHECK_EQ(std::size(global_nets[0].nets), 2);
+        CHECK_EQ(global_nets[1].name, "N001");
+        CHECK_EQ(global_nets[1].name_id, wire_system::name_table::empty_id);
+        CHECK_EQ(global_nets[2].name, "GND");
+        CHECK_EQ(global_nets[3].name, "N002");
+    }
+
+    TEST_CASE("nets_named(): The index follows renames and removals")
+    {
+        wire_system::manager manager;
+
+        auto net1 = std::make_shared<wire_system::net>();
+        net1->set_name(QString("VCC"));
+        manager.add_net(net1);
+
+        auto net2 = std::make_shared<wire_system::net>();
+        manager.add_net(net2);
+
+        const auto vcc = manager.names().intern("VCC");
+        CHECK_EQ(std::size(manager.nets_named(vcc)), 1);
+        CHECK(manager.nets_named(wire_system::name_table::empty_id).empty());
+
+        // Rename
+        net2->set_name(QString("VCC"));
+        CHECK_EQ(std::size(manager.nets_named(vcc)), 2);
+
+        net1->set_name(QString("GND"));
+        const auto gnd = manager.names().intern("GND");
+        REQUIRE_EQ(std::size(manager.nets_named(vcc)), 1);
+        CHECK_EQ(manager.nets_named(vcc).front(), net2);
+        CHECK_EQ(std::size(manager.nets_named(gnd)), 1);
+
+        // Remove
+        manager.remove_net(net2);
+        CHECK(manager.nets_named(vcc).empty());
+
+        // Clear
+        manager.clear();
+        CHECK(manager.nets_named(gnd).empty());
+    }
+}
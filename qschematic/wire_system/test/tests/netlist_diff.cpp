@@ -0,0 +1,174 @@
+#include "../3rdparty/doctest.h"
+#include "../../../netlist_diff.hpp"
+
+#include <algorithm>
+#include <initializer_list>
+
+using namespace QSchematic;
+
+namespace
+{
+
+    // Connectors are plain integers. The node of a connector is the connector divided by ten.
+    using TestNet = Net<int, int, int>;
+    using TestNetlist = Netlist<int, int, int, TestNet>;
+
+    TestNet
+    makeNet(const QString& name, std::initializer_list<int> connectors, bool anonymous = false)
+    {
+        TestNet net;
+        net.name = name;
+        net.anonymous = anonymous;
+        for (const int connector : connectors) {
+            net.nodes.push_back(connector / 10);
+            net.connectors.push_back(connector);
+            net.connectorNodePairs.emplace(connector, connector / 10);
+        }
+
+        return net;
+    }
+
+    TestNetlist
+    makeNetlist(std::initializer_list<TestNet> nets)
+    {
+        TestNetlist netlist;
+        netlist.nets = nets;
+
+        return netlist;
+    }
+
+    template<typename TPinMoves>
+    bool
+    hasPinMove(const TPinMoves& moves, int connector, const QString& from, const QString& to)
+    {
+        return std::ranges::any_of(moves, [&](const auto& move) {
+            return move.connector == connector && move.node == connector / 10 && move.from == from && move.to == to;
+        });
+    }
+
+}
+
+TEST_SUITE("Netlist diff")
+{
+    TEST_CASE("Identical netlists")
+    {
+        const auto netlist = makeNetlist({ makeNet("VCC", { 10, 20 }), makeNet("N001", { 11, 21, 31 }, true) });
+
+        CHECK(diff(netlist, netlist).isEmpty());
+    }
+
+    TEST_CASE("Renamed net")
+    {
+        const auto from = makeNetlist({ makeNet("A", { 10, 20 }), makeNet("B", { 11, 21 }) });
+        const auto to = makeNetlist({ makeNet("A", { 10, 20 }), makeNet("C", { 11, 21 }) });
+
+        const auto d = diff(from, to);
+        REQUIRE_EQ(d.renamed.size(), 1);
+        CHECK_EQ(d.renamed[0].from, "B");
+        CHECK_EQ(d.renamed[0].to, "C");
+        CHECK(d.added.empty());
+        CHECK(d.removed.empty());
+        CHECK(d.movedPins.empty());
+    }
+
+    TEST_CASE("Split net")
+    {
+        const auto from = makeNetlist({ makeNet("A", { 10, 20, 30, 40 }) });
+        const auto to = makeNetlist({ makeNet("A", { 10, 20 }), makeNet("N001", { 30, 40 }, true) });
+
+        const auto d = diff(from, to);
+        REQUIRE_EQ(d.added.size(), 1);
+        CHECK_EQ(d.added[0].name, "N001");
+        CHECK(d.removed.empty());
+        CHECK(d.renamed.empty());
+        REQUIRE_EQ(d.movedPins.size(), 2);
+        CHECK(hasPinMove(d.movedPins, 30, "A", "N001"));
+        CHECK(hasPinMove(d.movedPins, 40, "A", "N001"));
+    }
+
+    TEST_CASE("Merged nets")
+    {
+        const auto from = makeNetlist({ makeNet("A", { 10, 20 }), makeNet("B", { 30, 40 }) });
+        const auto to = makeNetlist({ makeNet("A", { 10, 20, 30, 40 }) });
+
+        const auto d = diff(from, to);
+        CHECK(d.added.empty());
+        REQUIRE_EQ(d.removed.size(), 1);
+        CHECK_EQ(d.removed[0].name, "B");
+        CHECK(d.renamed.empty());
+        REQUIRE_EQ(d.movedPins.size(), 2);
+        CHECK(hasPinMove(d.movedPins, 30, "B", "A"));
+        CHECK(hasPinMove(d.movedPins, 40, "B", "A"));
+    }
+
+    TEST_CASE("Moved, connected & disconnected pins")
+    {
+        const auto from = makeNetlist({ makeNet("A", { 10, 20, 30 }), makeNet("B", { 40, 50 }) });
+        const auto to = makeNetlist({ makeNet("A", { 10, 60 }), makeNet("B", { 30, 40, 50 }) });
+
+        const auto d = diff(from, to);
+        CHECK(d.added.empty());
+        CHECK(d.removed.empty());
+        CHECK(d.renamed.empty());
+        REQUIRE_EQ(d.movedPins.size(), 3);
+        CHECK(hasPinMove(d.movedPins, 30, "A", "B"));
+        CHECK(hasPinMove(d.movedPins, 60, "", "A"));
+        CHECK(hasPinMove(d.movedPins, 20, "A", ""));
+    }
+
+    TEST_CASE("Renumbered anonymous nets are not renamed")
+    {
+        SUBCASE("Same pins") {
+            const auto from = makeNetlist({ makeNet("N001", { 10, 20 }, true), makeNet("N002", { 30, 40 }, true) });
+            const auto to = makeNetlist({ makeNet("N001", { 30, 40 }, true), makeNet("N002", { 10, 20 }, true) });
+
+            CHECK(diff(from, to).isEmpty());
+        }
+
+        SUBCASE("Changed pins") {
+            const auto from = makeNetlist({ makeNet("N001", { 10, 20 }, true), makeNet("N002", { 30, 40 }, true) });
+            const auto to = makeNetlist({ makeNet("N001", { 30, 40 }, true), makeNet("N002", { 10, 20, 50 }, true) });
+
+            const auto d = diff(from, to);
+            CHECK(d.added.empty());
+            CHECK(d.removed.empty());
+            CHECK(d.renamed.empty());
+            REQUIRE_EQ(d.movedPins.size(), 1);
+            CHECK(hasPinMove(d.movedPins, 50, "", "N002"));
+        }
+    }
+
+    TEST_CASE("User assigned names which look generated are matched by name")
+    {
+        SUBCASE("Changed pins") {
+            const auto from = makeNetlist({ makeNet("N5", { 10, 20 }) });
+            const auto to = makeNetlist({ makeNet("N5", { 10, 30 }) });
+
+            const auto d = diff(from, to);
+            CHECK(d.added.empty());
+            CHECK(d.removed.empty());
+            CHECK(d.renamed.empty());
+            CHECK_EQ(d.movedPins.size(), 2);
+        }
+
+        SUBCASE("Renamed") {
+            const auto from = makeNetlist({ makeNet("N5", { 10, 20 }) });
+            const auto to = makeNetlist({ makeNet("N12", { 10, 20 }) });
+
+            const auto d = diff(from, to);
+            REQUIRE_EQ(d.renamed.size(), 1);
+            CHECK_EQ(d.renamed[0].from, "N5");
+            CHECK_EQ(d.renamed[0].to, "N12");
+        }
+
+        SUBCASE("Named to anonymous") {
+            const auto from = makeNetlist({ makeNet("N5", { 10, 20 }) });
+            const auto to = makeNetlist({ makeNet("N001", { 10, 20 }, true) });
+
+            const auto d = diff(from, to);
+            REQUIRE_EQ(d.renamed.size(), 1);
+            CHECK_EQ(d.renamed[0].from, "N5");
+            CHECK_EQ(d.renamed[0].to, "N001");
+        }
+    }
+}
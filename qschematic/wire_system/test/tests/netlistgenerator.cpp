@@ -0,0 +1,89 @@
+#include "../3rdparty/doctest.h"
+#include "../scene_fixture.hpp"
+#include "../../../netlistgenerator.hpp"
+
+#include <vector>
+
+using namespace QSchematic;
+
+namespace
+{
+
+    template<typename TNet>
+    void
+    checkEqual(const std::vector<TNet>& actual, const std::vector<TNet>& expected)
+    {
+        REQUIRE_EQ(actual.size(), expected.size());
+        for (std::size_t i = 0; i < expected.size(); i++) {
+            CAPTURE(i);
+            CHECK_EQ(actual[i].name, expected[i].name);
+            CHECK_EQ(actual[i].wires, expected[i].wires);
+            CHECK_EQ(actual[i].nodes, expected[i].nodes);
+            CHECK_EQ(actual[i].connectors, expected[i].connectors);
+            CHECK_EQ(actual[i].connectorNodePairs, expected[i].connectorNodePairs);
+        }
+    }
+
+}
+
+TEST_SUITE("Netlist generator")
+{
+    TEST_CASE("nets(): The result does not depend on the number of threads")
+    {
+        using TestNet = Net<int, int, int>;
+
+        // Global nets with a varying number of connectors. Every fifth one makes no connection.
+        NetlistGenerator::Snapshot<int, int, int> snapshot;
+        for (int i = 0; i < 97; i++) {
+            decltype(snapshot.nets)::value_type net;
+            net.name = QStringLiteral("N%1").arg(i);
+            net.wires = { 2 * i, 2 * i + 1 };
+
+            const int connectorCount = i % 5 == 0 ? 1 : 2 + i % 4;
+            for (int j = 0; j < connectorCount; j++) {
+                net.connectors.push_back(snapshot.connectors.size());
+                snapshot.connectors.push_back({ i + j, 100 * i + j, nullptr, true });
+            }
+
+            snapshot.nets.push_back(std::move(net));
+        }
+
+        const auto expected = NetlistGenerator::nets<TestNet>(snapshot, 1);
+        CHECK_EQ(expected.size(), std::size_t(97 - 20));
+
+        for (const std::size_t threads : { 2, 3, 4, 7, 16, 200 }) {
+            CAPTURE(threads);
+            checkEqual(NetlistGenerator::nets<TestNet>(snapshot, threads), expected);
+        }
+    }
+
+    TEST_CASE("generateParallel(): Same result as generate()")
+    {
+        Scene scene;
+
+        // A global net made of several separate nets spread across the scene
+        std::vector<std::shared_ptr<Items::Node>> nodes;
+        for (int i = 0; i < 24; i++)
+            nodes.push_back(fixture::addNode(scene, QPointF(200 * (i % 6), 200 * (i / 6)), 2));
+        for (int i = 0; i + 1 < std::ssize(nodes); i += 2) {
+            fixture::connect(scene, *nodes[i]->connectors().at(0), *nodes[i + 1]->connectors().at(0), QStringLiteral("GND"));
+            fixture::connect(scene, *nodes[i]->connectors().at(1), *nodes[i + 1]->connectors().at(1), i % 4 ? QString() : QStringLiteral("SIG%1").arg(i));
+        }
+
+        Netlist<> expected;
+        REQUIRE(NetlistGenerator::generate(expected, scene));
+
+        // The GND nets are merged into a single global net
+        const auto gnd = std::ranges::count_if(expected.nets, [](const auto& net) { return net.name == "GND"; });
+        CHECK_EQ(gnd, 1);
+
+        for (const std::size_t threads : { 2, 3, 8 }) {
+            CAPTURE(threads);
+
+            Netlist<> actual;
+            REQUIRE(NetlistGenerator::generateParallel(actual, scene, threads));
+            CHECK_EQ(actual.nodes, expected.nodes);
+            checkEqual(actual.nets, expected.nets);
+        }
+    }
+}
@@ -0,0 +1,205 @@
+#include "../3rdparty/doctest.h"
+#include "../scene_fixture.hpp"
+#include "../../../serdes.hpp"
+
+#include <gpds/container.hpp>
+
+#include <tuple>
+#include <vector>
+
+using namespace QSchematic;
+
+namespace
+{
+
+    /**
+     * Get the wire with a specific number of points.
+     */
+    std::shared_ptr<wire_system::wire>
+    wireWithPoints(const Scene& scene, int count)
+    {
+        for (const auto& wire : scene.wire_manager()->wires()) {
+            if (wire->points_count() == count)
+                return wire;
+        }
+
+        return { };
+    }
+
+    /**
+     * The connector attachments as (node position, connector index, wire point count, point index) tuples.
+     */
+    std::vector<std::tuple<qreal, qreal, int, int, int>>
+    attachments(const Scene& scene)
+    {
+        std::vector<std::tuple<qreal, qreal, int, int, int>> ret;
+        for (const auto& node : scene.items<Items::Node>()) {
+            const auto& connectors = node->connectors();
+            for (int i = 0; i < connectors.size(); i++) {
+                const auto record = scene.wire_manager()->attached_wire(connectors[i].get());
+                if (record && record->wire)
+                    ret.emplace_back(node->pos().x(), node->pos().y(), i, record->wire->points_count(), record->point_index);
+            }
+        }
+        std::ranges::sort(ret);
+
+        return ret;
+    }
+
+}
+
+TEST_SUITE("Scene")
+{
+    TEST_CASE("contentBounds(): Grows with the items")
+    {
+        Scene scene;
+        CHECK(scene.contentBounds().isNull());
+
+        const auto node = fixture::addNode(scene, { 0, 0 });
+        CHECK(scene.contentBounds().contains(node->sceneBoundingRect()));
+        CHECK(scene.sceneRect().contains(scene.contentBounds()));
+
+        const auto wire = fixture::addWire(scene, { { 0, 200 }, { 100, 200 } });
+        CHECK(scene.contentBounds().contains(wire->sceneBoundingRect()));
+
+        // Wire geometry changes without moving the item
+        SUBCASE("Appended point") {
+            wire->append_point({ 100, 1000 });
+        }
+
+        SUBCASE("Prepended point") {
+            wire->prepend_point({ -1000, 200 });
+        }
+
+        SUBCASE("Moved point") {
+            wire->move_point_to(1, { 2000, 200 });
+        }
+
+        SUBCASE("Moved node") {
+            node->setPos(-3000, -3000);
+        }
+
+        CHECK(scene.contentBounds().contains(wire->sceneBoundingRect()));
+        CHECK(scene.contentBounds().contains(node->sceneBoundingRect()));
+        CHECK(scene.sceneRect().contains(scene.contentBounds()));
+    }
+
+    TEST_CASE("contentBounds(): Shrinks once items on the edge are gone")
+    {
+        Scene scene;
+        const auto node = fixture::addNode(scene, { 0, 0 });
+        const auto wire = fixture::addWire(scene, { { 0, 200 }, { 100, 200 }, { 100, 5000 } });
+        REQUIRE_GE(scene.contentBounds().bottom(), 5000);
+        const QRectF sceneRect = scene.sceneRect();
+
+        SUBCASE("Removed point") {
+            wire->remove_point(2);
+            CHECK_LT(scene.contentBounds().bottom(), 5000);
+            CHECK(scene.contentBounds().contains(wire->sceneBoundingRect()));
+        }
+
+        SUBCASE("Removed item") {
+            scene.removeItem(wire);
+            CHECK_LT(scene.contentBounds().bottom(), 5000);
+            CHECK_EQ(scene.contentBounds(), node->sceneBoundingRect() | node->mapRectToScene(node->childrenBoundingRect()));
+        }
+
+        // The scene rect only grows
+        CHECK_EQ(scene.sceneRect(), sceneRect);
+    }
+
+    TEST_CASE("setSceneRect(): Explicit scene rects are not grown")
+    {
+        Scene scene;
+        const QRectF rect(0, 0, 500, 500);
+        scene.setSceneRect(rect);
+
+        fixture::addNode(scene, { 1000, 1000 });
+        CHECK_EQ(scene.sceneRect(), rect);
+
+        // Re-enable the automatic scene rect
+        scene.setSceneRect(QRectF());
+        CHECK(scene.sceneRect().contains(scene.contentBounds()));
+
+        SUBCASE("Through the base class") {
+            static_cast<QGraphicsScene&>(scene).setSceneRect(rect);
+            fixture::addNode(scene, { 2000, 2000 });
+            CHECK_EQ(scene.sceneRect(), rect);
+        }
+    }
+
+    TEST_CASE("contentChanged(): Covers the old & the new bounds")
+    {
+        Scene scene;
+        QRectF changed;
+        QObject::connect(&scene, &Scene::contentChanged, [&changed](const QRectF& rect) { changed |= rect; });
+
+        const auto wire = fixture::addWire(scene, { { 0, 0 }, { 100, 0 } });
+        const QRectF added = wire->sceneBoundingRect();
+        CHECK(changed.contains(added));
+
+        changed = { };
+        wire->move_point_to(1, { 1000, 0 });
+        CHECK(changed.contains(added));
+        CHECK(changed.contains(wire->sceneBoundingRect()));
+
+        changed = { };
+        const QRectF removed = wire->sceneBoundingRect();
+        scene.removeItem(wire);
+        CHECK(changed.contains(removed));
+    }
+
+    TEST_CASE("to_container() & from_container(): Connectivity survives the round trip")
+    {
+        Scene source;
+        auto a = fixture::addNode(source, QPointF(0, 0));
+        auto b = fixture::addNode(source, QPointF(400, 0));
+        auto trunk = fixture::connect(source, *a->connectors().at(0), *b->connectors().at(0), QStringLiteral("VCC"));
+
+        // Both ends of the branch are on the trunk
+        auto branch = fixture::addWire(source, { { 100, 20 }, { 100, 100 }, { 300, 100 }, { 300, 20 } });
+        std::size_t junctionRecords = 0;
+
+        SUBCASE("Last point") {
+            source.wire_manager()->connect_wire(trunk.get(), branch.get(), 3);
+            CHECK_EQ(branch->junctions(), QVector<int>{ 3 });
+            junctionRecords = 1;
+        }
+
+        SUBCASE("Both ends") {
+            source.wire_manager()->connect_wire(trunk.get(), branch.get(), 0);
+            source.wire_manager()->connect_wire(trunk.get(), branch.get(), 3);
+            CHECK_EQ(branch->junctions(), QVector<int>{ 0, 3 });
+            junctionRecords = 2;
+        }
+
+        const gpds::container container = source.to_container();
+
+        // One record per connected end
+        const gpds::container* connectivity = container.get_value<gpds::container*>("connectivity").value_or(nullptr);
+        REQUIRE(connectivity);
+        const auto junctions = Serdes::unpackIndices(connectivity->get_value<std::string>("junctions").value_or(""), 5);
+        REQUIRE(junctions.has_value());
+        CHECK_EQ(junctions->size(), 5 * junctionRecords);
+
+        Scene loaded;
+        loaded.from_container(container);
+
+        const auto loadedTrunk = wireWithPoints(loaded, 2);
+        const auto loadedBranch = wireWithPoints(loaded, 4);
+        REQUIRE(loadedTrunk);
+        REQUIRE(loadedBranch);
+        CHECK_EQ(loadedBranch->junctions(), branch->junctions());
+        CHECK(loadedTrunk->connected_wires().contains(loadedBranch.get()));
+        CHECK_EQ(loadedTrunk->net(), loadedBranch->net());
+        CHECK_EQ(loaded.wire_manager()->nets().size(), source.wire_manager()->nets().size());
+        CHECK_EQ(attachments(loaded), attachments(source));
+
+        // Saving the loaded scene yields the same connectivity
+        const gpds::container saved = loaded.to_container();
+        const gpds::container* reloaded = saved.get_value<gpds::container*>("connectivity").value_or(nullptr);
+        REQUIRE(reloaded);
+        CHECK_EQ(reloaded->get_value<std::string>("junctions").value_or(""), connectivity->get_value<std::string>("junctions").value_or("<missing>"));
+        CHECK_EQ(reloaded->get_value<std::string>("connections").value_or(""), connectivity->get_value<std::string>("connections").value_or("<missing>"));
+    }
+}
@@ -0,0 +1,197 @@
+#include "../3rdparty/doctest.h"
+#include "../../../scene.hpp"
+#include "../../../serdes.hpp"
+
+#include <gpds/container.hpp>
+
+#include <limits>
+#include <string>
+
+using QSchematic::Serdes;
+
+namespace
+{
+
+    gpds::container
+    makePoint(int index, double x, double y)
+    {
+        gpds::container point;
+        point.add_attribute("index", index);
+        point.add_value("x", x);
+        point.add_value("y", y);
+
+        return point;
+    }
+
+    gpds::container
+    makeLabel(const std::string& text, bool visible)
+    {
+        gpds::container item;
+        item.add_value("visible", visible);
+
+        gpds::container label;
+        label.add_value("item", item);
+        label.add_value("text", text);
+
+        return label;
+    }
+
+}
+
+TEST_SUITE("Serdes")
+{
+    TEST_CASE("packPoints() & unpackPoints(): Points survive the round trip")
+    {
+        const QVector<QPointF> points = {
+            { 0, 0 },
+            { 10, -20 },
+            { -0.1, 1.0 / 3.0 },
+            { 1e-300, -1e300 },
+            { std::numeric_limits<double>::lowest(), std::numeric_limits<double>::max() },
+        };
+
+        const std::string packed = Serdes::packPoints(points);
+        const auto unpacked = Serdes::unpackPoints(packed);
+
+        REQUIRE(unpacked.has_value());
+        REQUIRE_EQ(unpacked->size(), points.size());
+        for (qsizetype i = 0; i < points.size(); i++) {
+            CHECK_EQ(unpacked->at(i).x(), points.at(i).x());
+            CHECK_EQ(unpacked->at(i).y(), points.at(i).y());
+        }
+    }
+
+    TEST_CASE("packPoints(): Uses the shortest representation")
+    {
+        CHECK_EQ(Serdes::packPoints({ }), "");
+        CHECK_EQ(Serdes::packPoints({ { 0, 0 }, { 10, 0 }, { 10, 20 } }), "0,0 10,0 10,20");
+        CHECK_EQ(Serdes::packPoints({ { -2.5, 0.1 } }), "-2.5,0.1");
+    }
+
+    TEST_CASE("unpackPoints(): Whitespace around points is ignored")
+    {
+        const auto points = Serdes::unpackPoints("  1,2\t3,4\n");
+
+        REQUIRE(points.has_value());
+        CHECK_EQ(*points, QVector<QPointF>{ { 1, 2 }, { 3, 4 } });
+        CHECK(Serdes::unpackPoints("")->isEmpty());
+    }
+
+    TEST_CASE("unpackPoints(): Malformed input is rejected")
+    {
+        CHECK_FALSE(Serdes::unpackPoints("1").has_value());
+        CHECK_FALSE(Serdes::unpackPoints("1,").has_value());
+        CHECK_FALSE(Serdes::unpackPoints(",1").has_value());
+        CHECK_FALSE(Serdes::unpackPoints("1 2").has_value());
+        CHECK_FALSE(Serdes::unpackPoints("1,2,3").has_value());
+        CHECK_FALSE(Serdes::unpackPoints("1,2;3,4").has_value());
+        CHECK_FALSE(Serdes::unpackPoints("1,x").has_value());
+        CHECK_FALSE(Serdes::unpackPoints("+1,2").has_value());
+    }
+
+    TEST_CASE("packIndices() & unpackIndices(): Indices survive the round trip")
+    {
+        const std::vector<int> values = { 0, 1, -2, 3, std::numeric_limits<int>::min(), std::numeric_limits<int>::max() };
+
+        const std::string packed = Serdes::packIndices(values, 3);
+        CHECK_EQ(packed, "0,1,-2 3,-2147483648,2147483647");
+
+        const auto unpacked = Serdes::unpackIndices(packed, 3);
+        REQUIRE(unpacked.has_value());
+        CHECK_EQ(*unpacked, values);
+
+        CHECK_EQ(Serdes::packIndices({ }, 2), "");
+        CHECK(Serdes::unpackIndices("", 2)->empty());
+    }
+
+    TEST_CASE("unpackIndices(): Malformed input is rejected")
+    {
+        CHECK_FALSE(Serdes::unpackIndices("1,2", 0).has_value());
+        CHECK_FALSE(Serdes::unpackIndices("1,2,3", 2).has_value());
+        CHECK_FALSE(Serdes::unpackIndices("1,2 3", 2).has_value());
+        CHECK_FALSE(Serdes::unpackIndices("1 2", 2).has_value());
+        CHECK_FALSE(Serdes::unpackIndices("1,2 ", 2).has_value());
+        CHECK_FALSE(Serdes::unpackIndices(" 1,2", 2).has_value());
+        CHECK_FALSE(Serdes::unpackIndices("1,1.5", 2).has_value());
+        CHECK_FALSE(Serdes::unpackIndices("1,99999999999", 2).has_value());
+    }
+
+    TEST_CASE("upgrade(): Version 2 wires & labels are converted")
+    {
+        // Wire with points out of order
+        gpds::container wire;
+        wire.add_attribute("type-id", 2);
+        wire.add_value("point", makePoint(1, 10.5, -20));
+        wire.add_value("point", makePoint(0, 0, 0));
+        wire.add_value("point", makePoint(2, -0.25, 3));
+
+        gpds::container hiddenNet;
+        hiddenNet.add_value("name", std::string(""));
+        hiddenNet.add_value("wire", wire);
+        hiddenNet.add_value("label", makeLabel("", false));
+
+        gpds::container visibleNet;
+        visibleNet.add_value("name", std::string("VCC"));
+        visibleNet.add_value("label", makeLabel("VCC", true));
+
+        gpds::container root;
+        root.add_attribute("version", 2);
+        root.add_value("net", hiddenNet);
+        root.add_value("net", visibleNet);
+
+        REQUIRE(Serdes::upgrade(root));
+        CHECK_EQ(root.get_attribute<std::size_t>("version").value_or(0), QSchematic::Scene::serdes_version);
+
+        const auto nets = root.get_values<gpds::container*>("net");
+        REQUIRE_EQ(nets.size(), 2);
+        REQUIRE(nets[0]);
+        REQUIRE(nets[1]);
+
+        // The points got packed in order
+        const gpds::container* upgradedWire = nets[0]->get_value<gpds::container*>("wire").value_or(nullptr);
+        REQUIRE(upgradedWire);
+        CHECK(upgradedWire->get_values<gpds::container*>("point").empty());
+        CHECK_EQ(upgradedWire->get_value<std::string>("points").value_or(""), "0,0 10.5,-20 -0.25,3");
+        CHECK_EQ(upgradedWire->get_attribute<int>("type-id").value_or(0), 2);
+
+        // The hidden empty label got dropped, the other one is kept
+        CHECK_FALSE(nets[0]->get_value<gpds::container*>("label").has_value());
+        const gpds::container* label = nets[1]->get_value<gpds::container*>("label").value_or(nullptr);
+        REQUIRE(label);
+        CHECK_EQ(label->get_value<std::string>("text").value_or(""), "VCC");
+    }
+
+    TEST_CASE("upgrade(): Current versions are left alone")
+    {
+        gpds::container net;
+        net.add_value("label", makeLabel("", false));
+
+        gpds::container root;
+        root.add_attribute("version", QSchematic::Scene::serdes_version);
+        root.add_value("net", net);
+
+        REQUIRE(Serdes::upgrade(root));
+
+        const gpds::container* upgradedNet = root.get_value<gpds::container*>("net").value_or(nullptr);
+        REQUIRE(upgradedNet);
+        CHECK(upgradedNet->get_value<gpds::container*>("label").has_value());
+    }
+
+    TEST_CASE("upgrade(): Unsupported versions are rejected")
+    {
+        gpds::container root;
+
+        SUBCASE("Missing") {
+        }
+
+        SUBCASE("Too old") {
+            root.add_attribute("version", QSchematic::Scene::serdes_version_min - 1);
+        }
+
+        SUBCASE("Too new") {
+            root.add_attribute("version", QSchematic::Scene::serdes_version + 1);
+        }
+
+        CHECK_FALSE(Serdes::upgrade(root));
+    }
+}
@@ -0,0 +1,443 @@
+#include "../3rdparty/doctest.h"
+#include "../scene_fixture.hpp"
+#include "../../../netlistgenerator.hpp"
+#include "../../../sheet_file.hpp"
+
+#include <QFile>
+#include <QTemporaryDir>
+#include <QtEndian>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <set>
+#include <tuple>
+#include <vector>
+
+using namespace QSchematic;
+
+namespace
+{
+
+    // Byte offsets of the header fields (the file is little endian)
+    constexpr qsizetype VERSION = 4;
+    constexpr qsizetype RECORD_COUNT = 8;
+    constexpr qsizetype STRING_COUNT = 12;
+    constexpr qsizetype GRID_ORIGIN = 48;
+    constexpr qsizetype TILE_SIZE = 64;
+    constexpr qsizetype COLUMNS = 72;
+    constexpr qsizetype ROWS = 76;
+    constexpr qsizetype TILES_OFFSET = 80;
+    constexpr qsizetype TILE_RECORDS_OFFSET = 88;
+    constexpr qsizetype TILE_RECORD_COUNT = 96;
+    constexpr qsizetype DIRECTORY_OFFSET = 104;
+    constexpr qsizetype STRINGS_OFFSET = 112;
+    constexpr qsizetype CONNECTIVITY_OFFSET = 120;
+    constexpr qsizetype CONNECTIVITY_SIZE = 128;
+    constexpr qsizetype RECORD_SIZE = 48;
+
+    constexpr qreal TILE_SIZE_VALUE = 500;
+
+    template<typename T>
+    T
+    field(const QByteArray& data, qsizetype offset)
+    {
+        return qFromLittleEndian<T>(data.constData() + offset);
+    }
+
+    template<typename T>
+    void
+    patch(QByteArray& data, qsizetype offset, T value)
+    {
+        qToLittleEndian(value, data.data() + offset);
+    }
+
+    /**
+     * Two nodes connected by a named net next to the origin & two nodes connected by an anonymous net far away.
+     */
+    void
+    makeScene(Scene& scene)
+    {
+        auto a = fixture::addNode(scene, QPointF(0, 0));
+        auto b = fixture::addNode(scene, QPointF(400, 0));
+        fixture::connect(scene, *a->connectors().at(0), *b->connectors().at(0), QStringLiteral("VCC"));
+
+        auto c = fixture::addNode(scene, QPointF(5000, 3000));
+        auto d = fixture::addNode(scene, QPointF(5400, 3000));
+        fixture::connect(scene, *c->connectors().at(0), *d->connectors().at(0));
+    }
+
+    /**
+     * Nets as (name, anonymous, connector count) tuples.
+     */
+    template<typename TNetlist>
+    std::vector<std::tuple<QString, bool, std::size_t>>
+    summary(const TNetlist& netlist)
+    {
+        std::vector<std::tuple<QString, bool, std::size_t>> ret;
+        for (const auto& net : netlist.nets)
+            ret.emplace_back(net.name, net.anonymous, net.connectors.size());
+        std::ranges::sort(ret);
+
+        return ret;
+    }
+
+    const QRectF everything(-1e6, -1e6, 2e6, 2e6);
+
+    class Files
+    {
+    public:
+        Files()
+        {
+            REQUIRE(m_dir.isValid());
+
+            Scene scene;
+            makeScene(scene);
+            REQUIRE(SheetFile::write(scene, m_dir.filePath("sheet.qssf"), TILE_SIZE_VALUE));
+            NetlistGenerator::generate(m_netlist, scene);
+
+            QFile file(m_dir.filePath("sheet.qssf"));
+            REQUIRE(file.open(QIODevice::ReadOnly));
+            m_data = file.readAll();
+        }
+
+        [[nodiscard]]
+        QString
+        path() const
+        {
+            return m_dir.filePath("sheet.qssf");
+        }
+
+        [[nodiscard]]
+        const QByteArray&
+        data() const
+        {
+            return m_data;
+        }
+
+        [[nodiscard]]
+        const Netlist<>&
+        netlist() const
+        {
+            return m_netlist;
+        }
+
+        bool
+        open(SheetFile& file, const QByteArray& data)
+        {
+            const QString path = m_dir.filePath("corrupt.qssf");
+            QFile out(path);
+            REQUIRE(out.open(QIODevice::WriteOnly | QIODevice::Truncate));
+            REQUIRE_EQ(out.write(data), data.size());
+            out.close();
+
+            return file.open(path);
+        }
+
+    private:
+        QTemporaryDir m_dir;
+        QByteArray m_data;
+        Netlist<> m_netlist;
+    };
+
+    /**
+     * Use every accessor of an opened (possibly corrupted) file. Nothing may crash & all results must be in range.
+     */
+    void
+    exercise(SheetFile& file)
+    {
+        const auto records = file.records(everything);
+        CHECK(std::ranges::all_of(records, [&file](std::uint32_t record) { return record < file.count(); }));
+        CHECK(std::ranges::adjacent_find(records) == std::cend(records));
+
+        for (std::uint32_t i = 0; i < file.count(); i++)
+            std::ignore = file.item(i);
+
+        SheetFile::Netlist netlist;
+        std::ignore = file.netlist(netlist);
+
+        Scene scene;
+        file.setScene(&scene);
+        CHECK_LE(file.materialize(everything), std::size_t(file.count()));
+        file.setScene(nullptr);
+    }
+
+}
+
+TEST_SUITE("Sheet file")
+{
+    TEST_CASE("write() & open(): The directory survives the round trip")
+    {
+        Files files;
+
+        SheetFile file;
+        REQUIRE(file.open(files.path()));
+        CHECK(file.isOpen());
+
+        // Four nodes & two nets
+        REQUIRE_EQ(file.count(), 6);
+        std::size_t nodes = 0;
+        std::size_t nets = 0;
+        for (std::uint32_t i = 0; i < file.count(); i++) {
+            nodes += file.kind(i) == SheetFile::Kind::Node;
+            nets += file.kind(i) == SheetFile::Kind::Net;
+        }
+        CHECK_EQ(nodes, 4);
+        CHECK_EQ(nets, 2);
+
+        // Nodes deserialize at their original position
+        std::set<std::pair<qreal, qreal>> positions;
+        for (std::uint32_t i = 0; i < file.count(); i++) {
+            if (file.kind(i) != SheetFile::Kind::Node)
+                continue;
+            const auto item = file.item(i);
+            REQUIRE(item);
+            CHECK_EQ(item->sceneBoundingRect(), file.bounds(i));
+            positions.emplace(item->pos().x(), item->pos().y());
+        }
+        CHECK_EQ(positions, std::set<std::pair<qreal, qreal>>{ { 0, 0 }, { 400, 0 }, { 5000, 3000 }, { 5400, 3000 } });
+
+        file.close();
+        CHECK_FALSE(file.isOpen());
+        CHECK_EQ(file.count(), 0);
+    }
+
+    TEST_CASE("records(): Only the records intersecting the region")
+    {
+        Files files;
+
+        SheetFile file;
+        REQUIRE(file.open(files.path()));
+
+        SUBCASE("Everything") {
+            const auto records = file.records(everything);
+            CHECK_EQ(records.size(), file.count());
+        }
+
+        SUBCASE("Far away nodes") {
+            const QRectF region(4900, 2900, 700, 300);
+            const auto records = file.records(region);
+            REQUIRE_EQ(records.size(), 3);
+            for (const std::uint32_t record : records) {
+                CAPTURE(record);
+                CHECK(file.bounds(record).intersects(region));
+            }
+
+            // Records not returned don't intersect the region
+            for (std::uint32_t i = 0; i < file.count(); i++) {
+                if (std::ranges::find(records, i) == std::cend(records))
+                    CHECK_FALSE(file.bounds(i).intersects(region));
+            }
+        }
+
+        SUBCASE("Empty region") {
+            CHECK(file.records(QRectF(2000, 1500, 10, 10)).empty());
+        }
+    }
+
+    TEST_CASE("netlist(): Same nets as the netlist generator")
+    {
+        Files files;
+
+        SheetFile file;
+        REQUIRE(file.open(files.path()));
+
+        SheetFile::Netlist netlist;
+        REQUIRE(file.netlist(netlist));
+        CHECK_EQ(netlist.nodes.size(), 4);
+        CHECK_EQ(summary(netlist), summary(files.netlist()));
+
+        // Pins refer to node records & carry the connector text
+        for (const auto& net : netlist.nets) {
+            for (const SheetFile::Pin& pin : net.connectors) {
+                REQUIRE_LT(pin.node, file.count());
+                CHECK_EQ(file.kind(pin.node), SheetFile::Kind::Node);
+                CHECK_EQ(pin.index, 0);
+                CHECK_EQ(file.string(pin.name), "P0");
+            }
+        }
+    }
+
+    TEST_CASE("materialize(): Items & connectivity are restored")
+    {
+        Files files;
+
+        SheetFile file;
+        REQUIRE(file.open(files.path()));
+
+        Scene scene;
+        file.setScene(&scene);
+
+        // Only the region near the origin
+        CHECK_EQ(file.materialize(QRectF(-100, -100, 700, 300)), 3);
+        CHECK_EQ(scene.items<Items::Node>().size(), 2);
+        std::size_t materialized = 0;
+        for (std::uint32_t i = 0; i < file.count(); i++)
+            materialized += file.isMaterialized(i);
+        CHECK_EQ(materialized, 3);
+
+        // The rest
+        CHECK_EQ(file.materialize(everything), 3);
+        CHECK_EQ(file.materialize(everything), 0);
+        CHECK_EQ(scene.items<Items::Node>().size(), 4);
+
+        Netlist<> netlist;
+        REQUIRE(NetlistGenerator::generate(netlist, scene));
+        CHECK_EQ(summary(netlist), summary(files.netlist()));
+    }
+
+    TEST_CASE("open(): Corrupted headers are rejected")
+    {
+        Files files;
+        QByteArray data = files.data();
+        SheetFile file;
+
+        SUBCASE("Bad magic") {
+            data[0] = 'X';
+        }
+
+        SUBCASE("Unsupported version") {
+            patch<std::uint16_t>(data, VERSION, static_cast<std::uint16_t>(SheetFile::format_version + 1));
+        }
+
+        SUBCASE("Invalid grid") {
+            SUBCASE("Zero tile size") { patch<double>(data, TILE_SIZE, 0); }
+            SUBCASE("NaN tile size") { patch<double>(data, TILE_SIZE, std::numeric_limits<double>::quiet_NaN()); }
+            SUBCASE("Infinite origin") { patch<double>(data, GRID_ORIGIN, std::numeric_limits<double>::infinity()); }
+            SUBCASE("No columns") { patch<std::uint32_t>(data, COLUMNS, 0); }
+            SUBCASE("Too many columns") { patch<std::uint32_t>(data, COLUMNS, std::numeric_limits<std::uint32_t>::max()); }
+            SUBCASE("Too many rows") { patch<std::uint32_t>(data, ROWS, std::numeric_limits<std::uint32_t>::max()); }
+        }
+
+        SUBCASE("Offsets past the end") {
+            for (const qsizetype offset : { TILES_OFFSET, TILE_RECORDS_OFFSET, DIRECTORY_OFFSET, STRINGS_OFFSET, CONNECTIVITY_OFFSET }) {
+                CAPTURE(offset);
+                for (const std::uint64_t value : { std::uint64_t(data.size()) - 1, std::numeric_limits<std::uint64_t>::max() }) {
+                    QByteArray corrupt = data;
+                    patch<std::uint64_t>(corrupt, offset, value);
+                    CHECK_FALSE(files.open(file, corrupt));
+                }
+            }
+        }
+
+        SUBCASE("Sizes past the end") {
+            SUBCASE("Records") { patch<std::uint32_t>(data, RECORD_COUNT, std::numeric_limits<std::uint32_t>::max()); }
+            SUBCASE("Strings") { patch<std::uint32_t>(data, STRING_COUNT, std::numeric_limits<std::uint32_t>::max()); }
+            SUBCASE("Tile records") { patch<std::uint64_t>(data, TILE_RECORD_COUNT, std::numeric_limits<std::uint64_t>::max()); }
+            SUBCASE("Connectivity") { patch<std::uint64_t>(data, CONNECTIVITY_SIZE, std::numeric_limits<std::uint64_t>::max()); }
+        }
+
+        CHECK_FALSE(files.open(file, data));
+        CHECK_FALSE(file.isOpen());
+    }
+
+    TEST_CASE("open(): Truncated files")
+    {
+        Files files;
+        const QByteArray& data = files.data();
+
+        // Everything but the item blobs is validated when opening
+        const auto sectionsEnd = field<std::uint64_t>(data, CONNECTIVITY_OFFSET) + field<std::uint64_t>(data, CONNECTIVITY_SIZE);
+        REQUIRE_LT(sectionsEnd, std::uint64_t(data.size()));
+
+        for (qsizetype size = 0; size < data.size(); size++) {
+            CAPTURE(size);
+
+            SheetFile file;
+            const bool opened = files.open(file, data.first(size));
+            CHECK_EQ(opened, std::uint64_t(size) >= sectionsEnd);
+
+            // The blobs are checked when they are accessed
+            if (opened && size % 16 == 0)
+                exercise(file);
+        }
+    }
+
+    TEST_CASE("Corrupted sections are not read out of bounds")
+    {
+        Files files;
+        QByteArray data = files.data();
+        SheetFile file;
+
+        const auto tilesOffset = field<std::uint64_t>(data, TILES_OFFSET);
+        const auto tileRecordsOffset = field<std::uint64_t>(data, TILE_RECORDS_OFFSET);
+        const auto tileRecordCount = field<std::uint64_t>(data, TILE_RECORD_COUNT);
+        const auto tileCount = std::uint64_t(field<std::uint32_t>(data, COLUMNS)) * field<std::uint32_t>(data, ROWS);
+        const auto directoryOffset = field<std::uint64_t>(data, DIRECTORY_OFFSET);
+        const auto recordCount = field<std::uint32_t>(data, RECORD_COUNT);
+        const auto stringsOffset = field<std::uint64_t>(data, STRINGS_OFFSET);
+        const auto stringCount = field<std::uint32_t>(data, STRING_COUNT);
+        const auto connectivityOffset = field<std::uint64_t>(data, CONNECTIVITY_OFFSET);
+
+        SUBCASE("Tiles") {
+            for (std::uint64_t i = 0; i <= tileCount; i++)
+                patch<std::uint32_t>(data, tilesOffset + i * 4, i % 2 ? 0 : std::numeric_limits<std::uint32_t>::max());
+            for (std::uint64_t i = 0; i < tileRecordCount; i++)
+                patch<std::uint32_t>(data, tileRecordsOffset + i * 4, i % 2 ? recordCount : std::numeric_limits<std::uint32_t>::max());
+
+            REQUIRE(files.open(file, data));
+            CHECK(file.records(everything).empty());
+        }
+
+        SUBCASE("Directory") {
+            for (std::uint32_t i = 0; i < recordCount; i++) {
+                const qsizetype record = directoryOffset + i * RECORD_SIZE;
+                patch<std::uint64_t>(data, record + 32, i % 2 ? std::numeric_limits<std::uint64_t>::max() : data.size() - 1);
+                patch<std::uint32_t>(data, record + 40, std::numeric_limits<std::uint32_t>::max());
+            }
+
+            REQUIRE(files.open(file, data));
+            for (std::uint32_t i = 0; i < file.count(); i++)
+                CHECK_FALSE(file.item(i));
+
+            Scene scene;
+            file.setScene(&scene);
+            CHECK_EQ(file.materialize(everything), 0);
+            CHECK(scene.items().isEmpty());
+            file.setScene(nullptr);
+        }
+
+        SUBCASE("String table") {
+            REQUIRE_GT(stringCount, 0);
+
+            SUBCASE("Past the end") {
+                for (std::uint32_t i = 0; i <= stringCount; i++)
+                    patch<std::uint32_t>(data, stringsOffset + i * 4, std::numeric_limits<std::uint32_t>::max() - stringCount + i);
+            }
+
+            SUBCASE("Reversed") {
+                for (std::uint32_t i = 0; i <= stringCount; i++)
+                    patch<std::uint32_t>(data, stringsOffset + i * 4, stringCount - i);
+            }
+
+            REQUIRE(files.open(file, data));
+            for (std::uint32_t i = 0; i < stringCount; i++)
+                CHECK(file.string(i).isEmpty());
+            CHECK(file.string(stringCount).isEmpty());
+
+            SheetFile::Netlist netlist;
+            REQUIRE(file.netlist(netlist));
+            CHECK_EQ(netlist.nets.size(), files.netlist().nets.size());
+        }
+
+        SUBCASE("Connectivity") {
+            SUBCASE("Net count") {
+                patch<std::uint32_t>(data, connectivityOffset, std::numeric_limits<std::uint32_t>::max());
+            }
+
+            SUBCASE("Wire count") {
+                patch<std::uint32_t>(data, connectivityOffset + 12, std::numeric_limits<std::uint32_t>::max());
+            }
+
+            SUBCASE("Truncated") {
+                patch<std::uint64_t>(data, CONNECTIVITY_SIZE, field<std::uint64_t>(data, CONNECTIVITY_SIZE) - 4);
+            }
+
+            REQUIRE(files.open(file, data));
+            SheetFile::Netlist netlist;
+            CHECK_FALSE(file.netlist(netlist));
+        }
+
+        exercise(file);
+    }
+}
@@ -0,0 +1,160 @@
+#include "../3rdparty/doctest.h"
+#include "../scene_fixture.hpp"
+#include "../../../netlistgenerator.hpp"
+#include "../../../xml_loader.hpp"
+
+#include <gpds/archiver_xml.hpp>
+#include <gpds/container.hpp>
+#include <QBuffer>
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace QSchematic;
+
+namespace
+{
+
+    /**
+     * Named & anonymous nets between nodes and a wire branching off the middle of another one.
+     */
+    void
+    makeScene(Scene& scene)
+    {
+        std::vector<std::shared_ptr<Items::Node>> nodes;
+        for (int i = 0; i < 6; i++)
+            nodes.push_back(fixture::addNode(scene, QPointF(400 * (i % 2), 300 * (i / 2)), 2));
+
+        auto vcc = fixture::connect(scene, *nodes[0]->connectors().at(0), *nodes[1]->connectors().at(0), QStringLiteral("VCC"));
+        fixture::connect(scene, *nodes[2]->connectors().at(1), *nodes[3]->connectors().at(1));
+        fixture::connect(scene, *nodes[4]->connectors().at(0), *nodes[5]->connectors().at(1), QStringLiteral("GND"));
+
+        // Junction
+        const QPointF start = vcc->points().first().toPointF();
+        auto branch = fixture::addWire(scene, { QPointF(200, start.y()), QPointF(200, start.y() + 160) });
+        scene.wire_manager()->connect_wire(vcc.get(), branch.get(), 0);
+    }
+
+    std::string
+    toXml(const Scene& scene)
+    {
+        std::ostringstream stream;
+        const auto [success, message] = gpds::archiver_xml().save(stream, scene.to_container(), Scene::gpds_name);
+        REQUIRE_MESSAGE(success, message);
+
+        return stream.str();
+    }
+
+    void
+    fromContainer(Scene& scene, const std::string& xml)
+    {
+        std::istringstream stream(xml);
+        gpds::container container;
+        const auto [success, message] = gpds::archiver_xml().load(stream, container, Scene::gpds_name);
+        REQUIRE_MESSAGE(success, message);
+
+        scene.from_container(container);
+    }
+
+    void
+    fromStream(Scene& scene, const std::string& xml)
+    {
+        QBuffer buffer;
+        buffer.setData(QByteArray::fromStdString(xml));
+        REQUIRE(buffer.open(QIODevice::ReadOnly));
+
+        const auto [success, message] = XmlLoader::load(scene, buffer);
+        REQUIRE_MESSAGE(success, message);
+    }
+
+    /**
+     * Nets as (name, wire count, connector count) tuples.
+     */
+    std::vector<std::tuple<QString, std::size_t, std::size_t>>
+    nets(const Scene& scene)
+    {
+        Netlist<> netlist;
+        REQUIRE(NetlistGenerator::generate(netlist, scene));
+
+        std::vector<std::tuple<QString, std::size_t, std::size_t>> ret;
+        for (const auto& net : netlist.nets)
+            ret.emplace_back(net.name, net.wires.size(), net.connectors.size());
+        std::ranges::sort(ret);
+
+        return ret;
+    }
+
+    std::size_t
+    junctionCount(const Scene& scene)
+    {
+        std::size_t count = 0;
+        for (const auto& wire : scene.wire_manager()->wires())
+            count += wire->connected_wires().size();
+
+        return count;
+    }
+
+}
+
+TEST_SUITE("XML loader")
+{
+    TEST_CASE("load(): Same scene as from_container()")
+    {
+        Scene source;
+        makeScene(source);
+        std::string xml = toXml(source);
+
+        SUBCASE("Plain") {
+        }
+
+        SUBCASE("Unknown elements are skipped") {
+            const auto scene = xml.find("<scene");
+            REQUIRE_NE(scene, std::string::npos);
+            xml.insert(scene, "<unknown><item>1</item><net/></unknown>");
+        }
+
+        Scene expected;
+        fromContainer(expected, xml);
+
+        Scene actual;
+        fromStream(actual, xml);
+
+        CHECK_EQ(actual.items().size(), expected.items().size());
+        CHECK_EQ(actual.items<Items::Node>().size(), 6);
+        CHECK_EQ(actual.wire_manager()->nets().size(), expected.wire_manager()->nets().size());
+        CHECK_EQ(nets(actual), nets(expected));
+        CHECK_EQ(nets(actual), nets(source));
+        CHECK_EQ(junctionCount(actual), junctionCount(source));
+        CHECK_EQ(junctionCount(expected), junctionCount(source));
+
+        // Both serialize to the same document
+        CHECK_EQ(toXml(actual), toXml(expected));
+    }
+
+    TEST_CASE("load(): Malformed documents are rejected")
+    {
+        Scene scene;
+        QBuffer buffer;
+
+        SUBCASE("Empty") {
+        }
+
+        SUBCASE("Unexpected root") {
+            buffer.setData("<other version=\"3\"/>");
+        }
+
+        SUBCASE("Unsupported version") {
+            buffer.setData(QByteArray("<qschematic version=\"") + QByteArray::number(qulonglong(Scene::serdes_version + 1)) + "\"/>");
+        }
+
+        SUBCASE("Not well formed") {
+            buffer.setData(QByteArray("<qschematic version=\"") + QByteArray::number(qulonglong(Scene::serdes_version)) + "\"><item>");
+        }
+
+        REQUIRE(buffer.open(QIODevice::ReadOnly));
+        CHECK_FALSE(XmlLoader::load(scene, buffer).first);
+    }
+}
@@ -0,0 +1,159 @@
+#include "xml_loader.hpp"
+#include "scene.hpp"
+#include "items/itemfactory.hpp"
+
+#include <gpds/container.hpp>
+#include <QIODevice>
+#include <QXmlStreamReader>
+
+#include <optional>
+
+using namespace QSchematic;
+
+namespace
+{
+
+    enum class Element
+    {
+        Scene,
+        Item,
+        Net,
+        Connectivity,
+    };
+
+    /**
+     * Get the top-level element of a name (if it's one we care about).
+     */
+    std::optional<Element>
+    element(QStringView name)
+    {
+        if (name == u"scene")
+            return Element::Scene;
+        if (name == u"item")
+            return Element::Item;
+        if (name == u"net")
+            return Element::Net;
+        if (name == u"connectivity")
+            return Element::Connectivity;
+
+        return std::nullopt;
+    }
+
+    template<typename TAttributes>
+    void
+    readAttributes(const QXmlStreamAttributes& xmlAttributes, TAttributes& attributes)
+    {
+        for (const QXmlStreamAttribute& attribute : xmlAttributes)
+            attributes.map.insert_or_assign(attribute.name().toString().toStdString(), attribute.value().toString().toStdString());
+    }
+
+}
+
+std::pair<bool, std::string>
+XmlLoader::load(Scene& scene, QIODevice& device)
+{
+    QXmlStreamReader xml(&device);
+
+    // Root
+    if (!xml.readNextStartElement())
+        return { false, "could not find root element: " + xml.errorString().toStdString() };
+    if (xml.name() != QLatin1String(Scene::gpds_name))
+        return { false, "unexpected root element \"" + xml.name().toString().toStdString() + "\"" };
+
+    // Check the version
+    bool ok = false;
+    const std::size_t version = xml.attributes().value("version").toULongLong(&ok);
+    if (!ok || version < Scene::serdes_version_min || version > Scene::serdes_version)
+        return { false, "unsupported version" };
+
+    // Allocate the items in bulk
+    const Items::Factory::PooledConstruction pooledConstruction;
+    const Scene::LoadingScope loadingScope(scene);
+
+    // Top-level elements
+    // Note: Scene::to_container() writes all items before the nets and the connectivity last. Therefore, processing
+    //       the elements in document order yields the same result as Scene::from_container().
+    while (xml.readNextStartElement()) {
+        // Note: The name is a view into the reader's buffer which gets invalidated when reading on
+        const auto type = element(xml.name());
+        if (!type) {
+            xml.skipCurrentElement();
+            continue;
+        }
+
+        // Build the container tree of this element only
+        gpds::container container;
+        readAttributes(xml.attributes(), container.attributes);
+        readChildren(xml, container);
+        if (xml.hasError())
+            break;
+
+        switch (*type) {
+            case Element::Scene:
+                scene.loadSceneProperties(container);
+                break;
+
+            case Element::Item:
+                scene.loadItem(container);
+                break;
+
+            case Element::Net:
+                scene.loadNet(container);
+                break;
+
+            case Element::Connectivity:
+                scene.loadConnectivity(container);
+                break;
+        }
+    }
+
+    if (xml.hasError())
+        return { false, "could not parse XML (line " + std::to_string(xml.lineNumber()) + "): " + xml.errorString().toStdString() };
+
+    scene.finishLoading();
+
+    return { true, "" };
+}
+
+void
+XmlLoader::readChildren(QXmlStreamReader& xml, gpds::container& container)
+{
+    while (xml.readNextStartElement())
+        readElement(xml, container);
+}
+
+void
+XmlLoader::readElement(QXmlStreamReader& xml, gpds::container& parent)
+{
+    const std::string key = xml.name().toString().toStdString();
+    const QXmlStreamAttributes attributes = xml.attributes();
+
+    // An element is a container if it has child elements. Otherwise, it's a value.
+    QString text;
+    while (!xml.atEnd()) {
+        switch (xml.readNext()) {
+            case QXmlStreamReader::Characters:
+                text += xml.text();
+                break;
+
+            case QXmlStreamReader::StartElement: {
+                gpds::container container;
+                readAttributes(attributes, container.attributes);
+
+                readElement(xml, container);
+                readChildren(xml, container);
+                parent.add_value(key, container);
+                return;
+            }
+
+            case QXmlStreamReader::EndElement: {
+                auto& value = parent.add_value(key, text.toStdString());
+                readAttributes(attributes, value.attributes);
+                return;
+            }
+
+            default:
+                break;
+        }
+    }
+}
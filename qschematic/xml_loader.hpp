@@ -0,0 +1,59 @@
+#pragma once
+
+#include <string>
+#include <utility>
+
+class QIODevice;
+class QXmlStreamReader;
+
+namespace gpds
+{
+    class container;
+}
+
+namespace QSchematic
+{
+
+    class Scene;
+
+    /**
+     * Streaming loader for scenes stored with gpds::archiver_xml.
+     *
+     * @details Unlike gpds::from_stream(), this does not build the container tree of the entire document. Instead, the
+     *          document is read element by element. Only the container tree of a single top-level element (ie. one
+     *          item or one net) is built at any time. It gets passed to the scene right away and is discarded
+     *          afterward. Therefore, the memory overhead does not grow with the size of the document.
+     *          The result is the same as loading the document via Scene::from_container().
+     *
+     * @note All serdes versions supported by Scene::from_container() are supported.
+     */
+    class XmlLoader
+    {
+    public:
+        XmlLoader() = delete;
+
+        /**
+         * Load a scene.
+         *
+         * @note Just like Scene::from_container(), this does not clear the scene first.
+         *
+         * @param scene The scene.
+         * @param device The device to read from. It must be open for reading.
+         * @return Success indicator & message.
+         */
+        [[nodiscard]]
+        static
+        std::pair<bool, std::string>
+        load(Scene& scene, QIODevice& device);
+
+    private:
+        static
+        void
+        readChildren(QXmlStreamReader& xml, gpds::container& container);
+
+        static
+        void
+        readElement(QXmlStreamReader& xml, gpds::container& parent);
+    };
+
+}